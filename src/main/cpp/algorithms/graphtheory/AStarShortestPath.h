@@ -0,0 +1,358 @@
+/*
+ * @file   AStarShortestPath.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   A* search for point-to-point shortest paths with a pluggable heuristic.
+ *
+ * A* is Dijkstra's algorithm with the priority of a node v changed from g(v), the cost of the
+ * best known path from the start, to f(v) = g(v) + h(v), where h(v) estimates the remaining cost
+ * from v to the end node. The search is pulled towards the end node and settles far fewer nodes
+ * than Dijkstra when the heuristic is good. The returned path is a shortest path as long as the
+ * heuristic never overestimates (is admissible). Nodes whose cost improves after they have been
+ * expanded are put back into the queue, which only happens with inconsistent heuristics.
+ *
+ * The heuristic is any callable h(node, target) -> double. This header provides three:
+ *   EuclideanHeuristic  - straight line distance between planar coordinates
+ *   HaversineHeuristic  - great circle distance between latitude/longitude coordinates
+ *   LandmarkHeuristic   - ALT lower bounds from precomputed landmark distances. By the triangle
+ *                         inequality d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L)
+ *                         for every landmark L.
+ * Coordinate based heuristics must be scaled so that they never exceed the edge costs, e.g. by
+ * the inverse of the maximum speed if the costs are travel times.
+ *
+ * The queue is the MinIndexedDHeap of the D-heap Dijkstra, and like that solver the heap and
+ * arrays are kept between queries with every entry stamped by the query which wrote it.
+ */
+
+#ifndef D_GRAPH_ASTARSHORTESTPATH_H
+#define D_GRAPH_ASTARSHORTESTPATH_H
+
+#include <Graph.h>
+#include <CsrGraph.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+
+#include <vector>
+#include <list>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include <memory>
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+
+namespace dsa {
+
+// Straight line distance between (x, y) coordinates times 'scale'.
+class EuclideanHeuristic {
+  std::vector<std::pair<double, double>> coords_;
+  double scale_;
+
+public:
+  EuclideanHeuristic(const std::vector<std::pair<double, double>>& coords, double scale = 1.0) :
+    coords_(coords), scale_(scale) {
+    if (scale < 0) throw std::invalid_argument("scale < 0");
+  }
+
+  double operator()(int node, int target) const {
+    double dx = coords_[node].first - coords_[target].first;
+    double dy = coords_[node].second - coords_[target].second;
+    return scale_ * std::sqrt(dx * dx + dy * dy);
+  }
+};
+
+
+// Great circle distance in meters between (latitude, longitude) coordinates
+// in degrees times 'scale'.
+class HaversineHeuristic {
+  static constexpr double EARTH_RADIUS = 6371000.0;
+  std::vector<std::pair<double, double>> coords_; // (lat, lon) in radians
+  std::vector<double> cosLat_;
+  double scale_;
+
+public:
+  HaversineHeuristic(const std::vector<std::pair<double, double>>& latLon, double scale = 1.0) : scale_(scale) {
+    if (scale < 0) throw std::invalid_argument("scale < 0");
+    const double toRad = std::acos(-1.0) / 180.0;
+    for (auto& p : latLon) {
+      coords_.push_back({p.first * toRad, p.second * toRad});
+      cosLat_.push_back(std::cos(p.first * toRad));
+    }
+  }
+
+  double operator()(int node, int target) const {
+    double sinLat = std::sin((coords_[target].first - coords_[node].first) / 2);
+    double sinLon = std::sin((coords_[target].second - coords_[node].second) / 2);
+    double a = sinLat * sinLat + cosLat_[node] * cosLat_[target] * sinLon * sinLon;
+    return scale_ * 2 * EARTH_RADIUS * std::asin(std::min(1.0, std::sqrt(a)));
+  }
+};
+
+
+// ALT (A*, Landmarks, Triangle inequality) lower bounds. The distances from
+// and to every landmark are computed once with Dijkstra, which takes
+// O(L * E log V) time and O(L * V) memory.
+class LandmarkHeuristic {
+  const double inf = std::numeric_limits<double>::infinity();
+
+  int L_;
+  std::vector<int> landmarks_;
+  // from_[v * L + l] = d(landmark l, v), to_[v * L + l] = d(v, landmark l)
+  std::vector<double> from_, to_;
+
+
+public:
+  template <typename GRAPH>
+  LandmarkHeuristic(const GRAPH *graph, const std::vector<int>& landmarks) : landmarks_(landmarks) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    int n = graph->size();
+    L_ = landmarks.size();
+    for (int l : landmarks)
+      if (l < 0 || l >= n) throw std::invalid_argument("Invalid landmark");
+
+    CsrGraph reverse = CsrGraph::reverseOf(*graph);
+    BasicDijkstrasShortestPathAdjacencyListWithDHeap<GRAPH> forward(graph);
+    BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph> backward(&reverse);
+
+    from_.resize((std::size_t)n * L_);
+    to_.resize((std::size_t)n * L_);
+    for (int l = 0; l < L_; l++) {
+      forward.solve(landmarks[l]);
+      backward.solve(landmarks[l]);
+      for (int v = 0; v < n; v++) {
+        from_[(std::size_t)v * L_ + l] = forward.getDistance(v);
+        to_[(std::size_t)v * L_ + l] = backward.getDistance(v);
+      }
+    }
+  }
+
+
+  // Picks 'count' landmarks by farthest point selection: starting from
+  // 'first', every next landmark is the node whose distance to the closest
+  // landmark picked so far is largest (among the nodes reachable from it).
+  template <typename GRAPH>
+  static std::vector<int> farthestLandmarks(const GRAPH *graph, int count, int first = 0) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    int n = graph->size();
+    if (first < 0 || first >= n) throw std::invalid_argument("Invalid node index");
+    count = std::min(count, n);
+
+    BasicDijkstrasShortestPathAdjacencyListWithDHeap<GRAPH> dijkstra(graph);
+    std::vector<double> closest(n, std::numeric_limits<double>::infinity());
+    std::vector<int> landmarks;
+    for (int next = first; (int)landmarks.size() < count && next != -1; ) {
+      landmarks.push_back(next);
+      dijkstra.solve(next);
+      next = -1;
+      for (int v = 0; v < n; v++) {
+        closest[v] = std::min(closest[v], dijkstra.getDistance(v));
+        if (closest[v] != 0 && closest[v] != std::numeric_limits<double>::infinity() &&
+            (next == -1 || closest[v] > closest[next])) next = v;
+      }
+    }
+    return landmarks;
+  }
+
+
+  const std::vector<int>& landmarks() const {
+    return landmarks_;
+  }
+
+
+  double operator()(int node, int target) const {
+    const double *fromV = from_.data() + (std::size_t)node * L_;
+    const double *fromT = from_.data() + (std::size_t)target * L_;
+    const double *toV = to_.data() + (std::size_t)node * L_;
+    const double *toT = to_.data() + (std::size_t)target * L_;
+    double bound = 0;
+    for (int l = 0; l < L_; l++) {
+      // Terms with unreachable landmarks bound nothing.
+      if (fromT[l] != inf && fromV[l] != inf) bound = std::max(bound, fromT[l] - fromV[l]);
+      if (toV[l] != inf && toT[l] != inf) bound = std::max(bound, toV[l] - toT[l]);
+    }
+    return bound;
+  }
+};
+
+
+
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+// HEURISTIC is a callable h(node, target) returning a lower bound of the
+// cost from node to target.
+template <typename GRAPH, typename HEURISTIC = std::function<double(int, int)>>
+class BasicAStarShortestPath {
+private:
+  const double inf = std::numeric_limits<double>::infinity();
+
+  int N_;
+  const GRAPH *graph_;
+  HEURISTIC heuristic_;
+
+  // Indexed Priority Queue (ipq) ordered by f = g + h.
+  std::unique_ptr<MinIndexedDHeap<double>> ipq_;
+
+  // g_[i], h_[i] and prev_[i] are only valid if stamp_[i] == epoch_.
+  std::vector<double> g_, h_;
+  std::vector<int> prev_;
+  std::vector<unsigned> stamp_;
+  unsigned epoch_;
+  int expandedCount_;
+
+
+  void newEpoch() {
+    ipq_->clear();
+    expandedCount_ = 0;
+    if (++epoch_ == 0) {
+      std::fill(stamp_.begin(), stamp_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+
+  void checkNode(int node) const {
+    if (node < 0 || node >= N_) throw std::invalid_argument("Invalid node index");
+  }
+
+
+  double astar(int start, int end) {
+    newEpoch();
+
+    stamp_[start] = epoch_;
+    g_[start] = 0;
+    h_[start] = heuristic_(start, end);
+    prev_[start] = -1;
+    ipq_->insert(start, h_[start]);
+
+    while (!ipq_->isEmpty()) {
+      int nodeId = ipq_->pollMinKeyIndex();
+      // The end node is expanded with the smallest f = g, no other path
+      // can be shorter if h never overestimates.
+      if (nodeId == end) return g_[end];
+      expandedCount_++;
+
+      for (auto edge: graph_->edges(nodeId)) {
+        int to = edge.first;
+        double newG = g_[nodeId] + edge.second;
+
+        if (stamp_[to] != epoch_) {
+          stamp_[to] = epoch_;
+          h_[to] = heuristic_(to, end);
+        } else if (newG >= g_[to]) {
+          continue;
+        }
+
+        g_[to] = newG;
+        prev_[to] = nodeId;
+        // (Re)open the node with its new priority.
+        if (ipq_->contains(to)) ipq_->decrease(to, newG + h_[to]);
+        else ipq_->insert(to, newG + h_[to]);
+      }
+    }
+    // End node is unreachable.
+    return inf;
+  }
+
+
+public:
+  // Initialize the solver with the graph to query and the heuristic. 'degree'
+  // is the arity of the heap, 0 picks the average out degree of the graph.
+  BasicAStarShortestPath(const GRAPH *graph, HEURISTIC heuristic, int degree = 0) : heuristic_(heuristic) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    if (degree < 0) throw std::invalid_argument("degree < 0");
+    N_ = graph->size();
+    graph_ = graph;
+
+    if (degree == 0) degree = N_ == 0 ? 2 : graph->edgeCount() / N_;
+    ipq_ = std::make_unique<MinIndexedDHeap<double>>(degree, std::max(1, N_));
+
+    g_.resize(N_, inf);
+    h_.resize(N_, 0);
+    prev_.resize(N_, -1);
+    stamp_.resize(N_, 0);
+    epoch_ = 0;
+    expandedCount_ = 0;
+  }
+
+
+  BasicAStarShortestPath(const BasicAStarShortestPath&) = delete;
+  BasicAStarShortestPath& operator=(BasicAStarShortestPath const&) = delete;
+
+  // The graph the solver runs on.
+  const GRAPH& operator()() {
+    return *graph_;
+  }
+
+
+  // Returns the cost of the shortest path from 'start' to 'end', or infinity
+  // if 'end' is unreachable.
+  double shortestPath(int start, int end) {
+    checkNode(start);
+    checkNode(end);
+    return astar(start, end);
+  }
+
+
+  // Number of nodes expanded (polled and relaxed) by the last query.
+  int expandedNodes() const {
+    return expandedCount_;
+  }
+
+
+  // Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive.
+  //
+  // @return An array of node indexes of the shortest path from 'start' to 'end'. If 'start' and
+  //     'end' are not connected then an empty array is returned.
+  //
+  std::list<int> reconstructPath(int start, int end) {
+    double dist = shortestPath(start, end);
+    std::list<int> path;
+    if (dist == inf) return path;
+    for (int at = end; at != -1; at = prev_[at])
+      path.push_front(at);
+    return path;
+  }
+
+};
+
+using AStarShortestPath = BasicAStarShortestPath<Graph>;
+
+
+
+// Example usage of AStarShortestPath
+int AStarShortestPath_test()
+{
+  // A 3 x 3 grid with unit spacing, edge costs are the distances.
+  std::vector<std::pair<double, double>> coords;
+  for (int r = 0; r < 3; r++)
+    for (int c = 0; c < 3; c++)
+      coords.push_back({c, r});
+
+  Graph graph(9);
+  for (int u = 0; u < 9; u++) {
+    if (u % 3 < 2) graph.addUndirectedEdge(u, u + 1, 1.0);
+    if (u + 3 < 9) graph.addUndirectedEdge(u, u + 3, 1.0);
+  }
+
+  AStarShortestPath solver(&graph, EuclideanHeuristic(coords));
+  std::list<int> path = solver.reconstructPath(0, 8);
+
+  std::cout << "A* from 0 to 8: [";
+  for (auto node: path) std::cout << node << ",";
+  std::cout << "] cost " << solver.shortestPath(0, 8) << std::endl;
+  // Prints:
+  // A* from 0 to 8: [0,1,2,5,8,] cost 4
+
+  LandmarkHeuristic alt(&graph, LandmarkHeuristic::farthestLandmarks(&graph, 2));
+  BasicAStarShortestPath<Graph, LandmarkHeuristic> altSolver(&graph, alt);
+  std::cout << "ALT from 0 to 8: cost " << altSolver.shortestPath(0, 8)
+            << " expanded " << altSolver.expandedNodes() << " nodes" << std::endl;
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_ASTARSHORTESTPATH_H */
@@ -7,6 +7,20 @@
  * @brief
  * An implementation of the Bellman-Ford algorithm. The algorithm finds the shortest path between a
  * starting node and all other nodes in the graph. The algorithm also detects negative cycles.
+ *
+ * With more than one thread the rounds are run Jacobi style: every round computes the new
+ * distance of each destination node j from the distances of the previous round,
+ *
+ *   next[j] = min(dist[j], min over i of dist[i] + matrix[i][j])
+ *
+ * so each thread only writes the destinations it owns and there are no write races. The matrix
+ * is transposed once per solve so the incoming edges of j are one contiguous row. A Jacobi round
+ * still extends every shortest path by one edge, so n - 1 rounds suffice and the rounds stop
+ * early once nothing changes.
+ *
+ * The batch version of getShortestPaths() solves a block of sources in the same rounds: each
+ * matrix entry is loaded once per round and relaxes the distances of all sources of the block,
+ * which are stored next to each other.
  */
 #ifndef D_GRAPH_BELLMANFORDADJMATRIX_H
 #define D_GRAPH_BELLMANFORDADJMATRIX_H
@@ -30,6 +44,10 @@
 #include <iostream>
 #include <limits>
 #include <cassert>
+#include <atomic>
+#include <stdexcept>
+
+#include <ThreadPool.h>
 
 namespace dsa {
 
@@ -45,6 +63,97 @@ private:
   std::vector<int> prev_;
   std::vector<std::vector<double>> *matrix_;
 
+  // Number of sources solved together by the batch version of getShortestPaths().
+  static const int BATCH_LANES = 8;
+
+  int numThreads_;
+  std::unique_ptr<ThreadPool> pool_;
+  // transposed_[j * n + i] is the cost of the edge i -> j.
+  std::vector<double> transposed_;
+
+
+  void transpose() {
+    transposed_.resize((size_t)n_ * n_);
+    for (int i = 0; i < n_; i++)
+      for (int j = 0; j < n_; j++)
+        transposed_[(size_t)j * n_ + i] = (*matrix_)[i][j];
+    if (!pool_) pool_ = std::make_unique<ThreadPool>(numThreads_);
+  }
+
+
+  // Solves 'lanes' sources at once with Jacobi rounds. The distance and the
+  // predecessor of node j for source s are at index j * lanes + s of 'dist'
+  // and 'prev'. Needs transpose() first.
+  void jacobi(const int *sources, int lanes, std::vector<double>& dist, std::vector<int>& prev) {
+    size_t L = lanes;
+    dist.assign(n_ * L, POSITIVE_INFINITY);
+    prev.assign(n_ * L, -1);
+    for (size_t s = 0; s < L; s++) dist[sources[s] * L + s] = 0;
+
+    std::vector<double> next(n_ * L);
+    std::vector<int> nextPrev(n_ * L);
+    std::atomic<bool> changed(true);
+    int round = 0;
+    for (; round < n_ - 1 && changed.load(std::memory_order_relaxed); round++) {
+      changed.store(false, std::memory_order_relaxed);
+      pool_->parallelFor(0, n_, [&](int j, int) {
+        double *best = &next[j * L];
+        int *bestPrev = &nextPrev[j * L];
+        std::copy(&dist[j * L], &dist[j * L] + L, best);
+        std::copy(&prev[j * L], &prev[j * L] + L, bestPrev);
+
+        const double *row = &transposed_[(size_t)j * n_];
+        bool improved = false;
+        for (int i = 0; i < n_; i++) {
+          double w = row[i];
+          if (w == POSITIVE_INFINITY) continue;
+          const double *from = &dist[i * L];
+          for (size_t s = 0; s < L; s++)
+            if (from[s] + w < best[s]) {
+              best[s] = from[s] + w;
+              bestPrev[s] = i;
+              improved = true;
+            }
+        }
+        if (improved) changed.store(true, std::memory_order_relaxed);
+      }, 16);
+      dist.swap(next);
+      prev.swap(nextPrev);
+    }
+    if (!changed.load(std::memory_order_relaxed)) return;
+
+    // A node which can still be improved after n - 1 rounds is reachable
+    // from a negative cycle, and so is every node reachable from it.
+    std::vector<char> seed(n_ * L, 0);
+    pool_->parallelFor(0, n_, [&](int j, int) {
+      const double *row = &transposed_[(size_t)j * n_];
+      for (int i = 0; i < n_; i++) {
+        if (row[i] == POSITIVE_INFINITY) continue;
+        for (size_t s = 0; s < L; s++)
+          if (dist[i * L + s] + row[i] < dist[j * L + s]) seed[j * L + s] = 1;
+      }
+    }, 16);
+    pool_->parallelFor(0, lanes, [&](int s, int) {
+      std::vector<int> stack;
+      for (int u = 0; u < n_; u++) {
+        if (!seed[u * L + s] || dist[u * L + s] == NEGATIVE_INFINITY) continue;
+        dist[u * L + s] = NEGATIVE_INFINITY;
+        prev[u * L + s] = -1;
+        stack.push_back(u);
+        while (!stack.empty()) {
+          int at = stack.back();
+          stack.pop_back();
+          for (int v = 0; v < n_; v++) {
+            if ((*matrix_)[at][v] == POSITIVE_INFINITY || dist[v * L + s] == NEGATIVE_INFINITY) continue;
+            dist[v * L + s] = NEGATIVE_INFINITY;
+            prev[v * L + s] = -1;
+            stack.push_back(v);
+          }
+        }
+      }
+    });
+  }
+
 public:
   BellmanFordAdjacencyMatrix(const BellmanFordAdjacencyMatrix&) = delete;
   BellmanFordAdjacencyMatrix& operator=(BellmanFordAdjacencyMatrix const&) = delete;
@@ -56,12 +165,15 @@ public:
   //
   // @param graph - An adjacency matrix containing directed edges forming the graph
   // @param start - The id of the starting node
+  // @param numThreads - With more than one thread the rounds run in parallel
   //
-  BellmanFordAdjacencyMatrix(int start, std::vector<std::vector<double>> *matrix) {
+  BellmanFordAdjacencyMatrix(int start, std::vector<std::vector<double>> *matrix, int numThreads = 1) {
+    if (numThreads < 1) throw std::invalid_argument("numThreads < 1");
     n_ = matrix->size();
     start_ = start;
     matrix_ = matrix;
     solved_ = false;
+    numThreads_ = numThreads;
   }
 
   std::vector<double>& getShortestPaths() {
@@ -69,6 +181,36 @@ public:
     return dist_;
   }
 
+  // Solves every node of 'sources' on the current matrix, BATCH_LANES sources
+  // per pass over the matrix, and returns their distance arrays in the same
+  // order. If 'prev' is given it receives the predecessor arrays, -1 marks
+  // the sources, unreachable nodes and nodes reachable from a negative cycle.
+  std::vector<std::vector<double>> getShortestPaths(const std::vector<int>& sources, std::vector<std::vector<int>> *prev = nullptr) {
+    for (int source : sources)
+      if (source < 0 || source >= n_) throw std::invalid_argument("Invalid source node index");
+    transpose();
+
+    std::vector<std::vector<double>> result(sources.size());
+    if (prev != nullptr) prev->assign(sources.size(), {});
+    std::vector<double> dist;
+    std::vector<int> blockPrev;
+    for (size_t first = 0; first < sources.size(); first += BATCH_LANES) {
+      int lanes = std::min<size_t>(BATCH_LANES, sources.size() - first);
+      jacobi(&sources[first], lanes, dist, blockPrev);
+      for (int s = 0; s < lanes; s++) {
+        std::vector<double>& d = result[first + s];
+        d.resize(n_);
+        for (int j = 0; j < n_; j++) d[j] = dist[(size_t)j * lanes + s];
+        if (prev != nullptr) {
+          std::vector<int>& p = (*prev)[first + s];
+          p.resize(n_);
+          for (int j = 0; j < n_; j++) p[j] = blockPrev[(size_t)j * lanes + s];
+        }
+      }
+    }
+    return result;
+  }
+
   void reconstructShortestPath(int end, std::list<int> &path) {
     if (!solved_) solve();
     path.clear();
@@ -85,6 +227,13 @@ public:
   void solve() {
     if (solved_) return;
 
+    if (numThreads_ > 1) {
+      transpose();
+      jacobi(&start_, 1, dist_, prev_);
+      solved_ = true;
+      return;
+    }
+
     // Initialize the distance to all nodes to be infinity
     // except for the start node which is zero.
     dist_ = std::vector<double> (n_, POSITIVE_INFINITY);
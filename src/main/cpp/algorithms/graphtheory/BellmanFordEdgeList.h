@@ -0,0 +1,315 @@
+/*
+ * @file   BellmanFordEdgeList.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Bellman-Ford over an edge list, with early termination and a queue based (SPFA) variant.
+ *
+ * BellmanFordAdjacencyMatrix scans all n^2 matrix entries in each of its 2(n - 1) rounds. Here
+ * the edges of the graph are copied once into a contiguous edge list, grouped by source node,
+ * and a round only costs O(E). Two methods share the same results:
+ *
+ * Rounds: the classic algorithm, stopped as soon as a round relaxes no edge. The edges out of
+ *   nodes which are still unreached are skipped as a block.
+ *
+ *   for round = 1 to n - 1:
+ *     for (u, v, w) in edges: if dist[u] + w < dist[v]: dist[v] = dist[u] + w
+ *     if nothing changed: return
+ *   every v with a relaxable edge (u, v) is reachable from a negative cycle
+ *
+ * Queue: the Shortest Path Faster Algorithm only relaxes the edges of nodes whose distance
+ *   changed, kept in a FIFO queue. count[v] is the number of edges on the path which gave v its
+ *   distance, it grows by one with each relaxation along the path. A path of n edges repeats a
+ *   node, and as it was accepted only because it got strictly shorter, the repeated cycle is
+ *   negative. Such nodes are not relaxed further.
+ *
+ * In both methods the nodes found behind a negative cycle are the seeds of a final search
+ * which sets every node reachable from them to -infinity, in O(V + E) instead of another n - 1
+ * rounds. On graphs without negative cycles the queue method usually touches far fewer edges
+ * than n - 1 full rounds, but its worst case is O(VE) as well.
+ */
+
+#ifndef D_GRAPH_BELLMANFORDEDGELIST_H
+#define D_GRAPH_BELLMANFORDEDGELIST_H
+
+#include <Graph.h>
+
+#include <vector>
+#include <deque>
+#include <list>
+#include <algorithm>
+
+#include <sstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace dsa {
+
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicBellmanFordEdgeList {
+public:
+  enum class Method {
+    Rounds,
+    Queue
+  };
+
+private:
+  const double POSITIVE_INFINITY = std::numeric_limits<double>::infinity();
+  const double NEGATIVE_INFINITY = -std::numeric_limits<double>::infinity();
+
+  int n_, start_;
+  Method method_;
+  bool solved_;
+  const GRAPH *graph_;
+
+  // The edges out of node u are [offsets_[u], offsets_[u + 1]) of to_ and cost_.
+  std::vector<int> offsets_, to_;
+  std::vector<double> cost_;
+
+  std::vector<double> dist_;
+  std::vector<int> prev_;
+  int rounds_;
+  long long relaxations_;
+
+
+  void checkNode(int node) const {
+    if (node < 0 || node >= n_) throw std::invalid_argument("Invalid node index");
+  }
+
+
+  // Classic rounds over the edge list. Returns the nodes with an edge which
+  // can still be relaxed after n - 1 rounds.
+  std::vector<int> solveRounds() {
+    for (rounds_ = 0; rounds_ < n_ - 1; ) {
+      rounds_++;
+      bool changed = false;
+      for (int u = 0; u < n_; u++) {
+        double du = dist_[u];
+        if (du == POSITIVE_INFINITY) continue;
+        for (int e = offsets_[u]; e < offsets_[u + 1]; e++) {
+          int v = to_[e];
+          if (du + cost_[e] < dist_[v]) {
+            dist_[v] = du + cost_[e];
+            prev_[v] = u;
+            relaxations_++;
+            changed = true;
+          }
+        }
+      }
+      if (!changed) return {};
+    }
+
+    std::vector<int> seeds;
+    for (int u = 0; u < n_; u++) {
+      if (dist_[u] == POSITIVE_INFINITY) continue;
+      for (int e = offsets_[u]; e < offsets_[u + 1]; e++)
+        if (dist_[u] + cost_[e] < dist_[to_[e]]) seeds.push_back(to_[e]);
+    }
+    return seeds;
+  }
+
+
+  // Shortest Path Faster Algorithm. Returns the nodes reached by a path of
+  // n edges, which are behind a negative cycle.
+  std::vector<int> solveQueue() {
+    std::vector<int> count(n_, 0), seeds;
+    std::vector<char> queued(n_, 0), cycle(n_, 0);
+    std::deque<int> queue{start_};
+    queued[start_] = 1;
+    rounds_ = 0;
+
+    while (!queue.empty()) {
+      int u = queue.front();
+      queue.pop_front();
+      queued[u] = 0;
+      if (cycle[u]) continue;
+
+      double du = dist_[u];
+      for (int e = offsets_[u]; e < offsets_[u + 1]; e++) {
+        int v = to_[e];
+        if (cycle[v] || du + cost_[e] >= dist_[v]) continue;
+        dist_[v] = du + cost_[e];
+        prev_[v] = u;
+        relaxations_++;
+        count[v] = count[u] + 1;
+        if (count[v] >= n_) {
+          cycle[v] = 1;
+          seeds.push_back(v);
+        } else if (!queued[v]) {
+          queued[v] = 1;
+          queue.push_back(v);
+        }
+      }
+    }
+    return seeds;
+  }
+
+
+  // Sets every node reachable from 'seeds' to -infinity.
+  void propagateNegativeCycles(std::vector<int>& seeds) {
+    std::vector<int> stack;
+    for (int seed : seeds) {
+      if (dist_[seed] == NEGATIVE_INFINITY) continue;
+      dist_[seed] = NEGATIVE_INFINITY;
+      prev_[seed] = -1;
+      stack.push_back(seed);
+      while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+        for (int e = offsets_[u]; e < offsets_[u + 1]; e++) {
+          int v = to_[e];
+          if (dist_[v] == NEGATIVE_INFINITY) continue;
+          dist_[v] = NEGATIVE_INFINITY;
+          prev_[v] = -1;
+          stack.push_back(v);
+        }
+      }
+    }
+  }
+
+public:
+  BasicBellmanFordEdgeList(const BasicBellmanFordEdgeList&) = delete;
+  BasicBellmanFordEdgeList& operator=(BasicBellmanFordEdgeList const&) = delete;
+
+  // Finds the shortest paths from 'start' to all other nodes of 'graph' and
+  // detects negative cycles. If a node is reachable from a negative cycle its
+  // minimum cost is set to negative infinity.
+  //
+  // @param start - The id of the starting node
+  // @param graph - The directed graph, only read by the constructor
+  // @param method - Method::Rounds or Method::Queue
+  //
+  BasicBellmanFordEdgeList(int start, const GRAPH *graph, Method method = Method::Queue) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    n_ = graph->size();
+    graph_ = graph;
+    checkNode(start);
+    start_ = start;
+    method_ = method;
+    solved_ = false;
+    rounds_ = 0;
+    relaxations_ = 0;
+
+    offsets_.assign(n_ + 1, 0);
+    to_.reserve(graph->edgeCount());
+    cost_.reserve(graph->edgeCount());
+    for (int u = 0; u < n_; u++) {
+      for (auto edge: graph->edges(u)) {
+        to_.push_back(edge.first);
+        cost_.push_back(edge.second);
+      }
+      offsets_[u + 1] = to_.size();
+    }
+  }
+
+
+  // The graph the solver runs on.
+  const GRAPH& operator()() {
+    return *graph_;
+  }
+
+
+  std::vector<double>& getShortestPaths() {
+    if (!solved_) solve();
+    return dist_;
+  }
+
+
+  // Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive.
+  // The path is empty if 'end' is unreachable or reachable from a negative
+  // cycle, since then there are an infinite number of shortest paths.
+  void reconstructShortestPath(int end, std::list<int> &path) {
+    checkNode(end);
+    if (!solved_) solve();
+    path.clear();
+    if (dist_[end] == POSITIVE_INFINITY || dist_[end] == NEGATIVE_INFINITY) return;
+    for (int at = end; at != -1; at = prev_[at])
+      path.push_front(at);
+  }
+
+
+  void solve() {
+    if (solved_) return;
+
+    dist_.assign(n_, POSITIVE_INFINITY);
+    prev_.assign(n_, -1);
+    dist_[start_] = 0;
+    relaxations_ = 0;
+
+    std::vector<int> seeds = method_ == Method::Rounds ? solveRounds() : solveQueue();
+    propagateNegativeCycles(seeds);
+    solved_ = true;
+  }
+
+
+  // True if a negative cycle is reachable from the start node.
+  bool hasNegativeCycle() {
+    if (!solved_) solve();
+    return std::find(dist_.begin(), dist_.end(), NEGATIVE_INFINITY) != dist_.end();
+  }
+
+
+  // Number of rounds over the edge list run by Method::Rounds.
+  int rounds() const {
+    return rounds_;
+  }
+
+
+  // Number of successful edge relaxations of the last solve().
+  long long relaxations() const {
+    return relaxations_;
+  }
+
+};
+
+using BellmanFordEdgeList = BasicBellmanFordEdgeList<Graph>;
+
+
+
+// Example usage of BellmanFordEdgeList
+int BellmanFordEdgeList_test()
+{
+  int n = 9;
+  Graph graph(n);
+
+  graph.addDirectedEdge(0, 1, 1);
+  graph.addDirectedEdge(1, 2, 1);
+  graph.addDirectedEdge(2, 4, 1);
+  graph.addDirectedEdge(4, 3, -3);
+  graph.addDirectedEdge(3, 2, 1);
+  graph.addDirectedEdge(1, 5, 4);
+  graph.addDirectedEdge(1, 6, 4);
+  graph.addDirectedEdge(5, 6, 5);
+  graph.addDirectedEdge(6, 7, 4);
+  graph.addDirectedEdge(5, 7, 3);
+
+  int start = 0;
+  BellmanFordEdgeList solver(start, &graph, BellmanFordEdgeList::Method::Queue);
+  std::vector<double> d = solver.getShortestPaths();
+
+  for (int i = 0; i < n; i++) {
+    std::stringstream strPath;
+    std::list<int> path;
+    solver.reconstructShortestPath(i, path);
+    for (auto node: path) strPath << " -> " << node;
+    std::cout << "The cost to get from node " << start << " to " << i << " is " << d[i]
+              << ", path:" << strPath.str() << std::endl;
+  }
+  // Output:
+  // The cost to get from node 0 to 0 is 0, path: -> 0
+  // The cost to get from node 0 to 1 is 1, path: -> 0 -> 1
+  // The cost to get from node 0 to 2 is -inf, path:
+  // The cost to get from node 0 to 3 is -inf, path:
+  // The cost to get from node 0 to 4 is -inf, path:
+  // The cost to get from node 0 to 5 is 5, path: -> 0 -> 1 -> 5
+  // The cost to get from node 0 to 6 is 5, path: -> 0 -> 1 -> 6
+  // The cost to get from node 0 to 7 is 8, path: -> 0 -> 1 -> 5 -> 7
+  // The cost to get from node 0 to 8 is inf, path:
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_BELLMANFORDEDGELIST_H */
@@ -53,12 +53,62 @@ function reconstructPath(s, e, prev):
   if path[0] == s: return path
   return []
 
+
+Direction optimizing BFS (Beamer, Asanovic and Patterson):
+
+The graph is explored one level at a time. A top-down step scans the out edges of every frontier
+node, which is cheap while the frontier is small. On low diameter graphs the middle levels
+contain a large part of the graph and most of their edges lead to nodes which are already
+visited. A bottom-up step instead lets every unvisited node look for any parent in the frontier
+through its in edges and stops at the first one found. The search switches
+
+  top-down -> bottom-up  when edgesOfFrontier > edgesOfUnvisited / alpha
+  bottom-up -> top-down  when the frontier shrinks and frontierSize < n / beta
+
+with alpha = 14 and beta = 24 by default. The frontier is a list of nodes in top-down steps and
+a bitmap in bottom-up steps, the visited set is always a bitmap.
+
+The in edges are built by the first search and kept, invalidate() drops them once the graph has
+changed. The caller can hand in a prebuilt reverse graph with setReverse(), or declare a
+symmetric graph with setSymmetric() so the out edges are used and no reverse is needed.
+
+
+Parallel BFS:
+
+Each level is a top-down step whose frontier is split among the threads. A node is claimed by
+a compare-and-swap of its parent entry from -1 to the frontier node, the winner appends it to
+a buffer of its own thread and the buffers become the next frontier. Which parent wins a race
+depends on the timing, so the deterministic mode splits each level in two passes instead:
+
+  pass 1: for every unvisited v next to frontier[i]: claim[v] = min(claim[v], i)
+  pass 2: for every v next to frontier[i] with claim[v] == i: prev[v] = frontier[i]
+
+and keeps the buffers in frontier order. That is exactly the order of the queue of bfs(), so
+the deterministic mode returns the same prev array as bfs().
+
+
+Multi-source BFS (Then et al.):
+
+Up to 64 * WORDS searches from different sources run together. Every node keeps one bit per
+search in each of the sets seen, visit (frontier) and visitNext, so a single scan of an edge
+(v, w) advances every search which has v on its frontier:
+
+  for v with visit[v] != 0:
+    for w in g.get(v):
+      d = visit[v] & ~seen[w]
+      visitNext[w] |= d          # parent of w is v for the bits which are new in visitNext[w]
+  for w with visitNext[w] != 0:
+    seen[w] |= visitNext[w]      # distance of w is the level for every bit of visitNext[w]
+  visit, visitNext = visitNext, 0
+
  */
 
 #ifndef D_GRAPH_BREATHFIRSTSEARCH_H
 #define D_GRAPH_BREATHFIRSTSEARCH_H
 
 #include <Graph.h>
+#include <CsrGraph.h>
+#include <ThreadPool.h>
 
 #include <vector>
 #include <deque>
@@ -76,32 +126,240 @@ function reconstructPath(s, e, prev):
 #include <sstream>
 #include <memory>
 #include <iostream>
+#include <cstdint>
+#include <atomic>
+#include <climits>
 
 namespace dsa {
 
 typedef std::vector<int> IntegerVector;
 
 
-class BreadthFirstSearchAdjacencyListIterative
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicBreadthFirstSearchAdjacencyListIterative
 {
+public:
+  // Statistics of one level of the direction optimizing search.
+  struct Level {
+    int frontierSize;        // Nodes on this level.
+    long long edgesExamined; // Edges scanned to discover the next level.
+    bool bottomUp;           // Direction of the step which expanded this level.
+  };
 
 private:
-  Graph *graph_;
+  const GRAPH *graph_;
 
   unsigned n_;
   std::vector<int> prev_;
 
+  int alpha_, beta_;
+  std::vector<Level> levels_;
+
+  // In edges for the bottom-up steps: the graph itself if it is declared
+  // symmetric, else 'reverse_', which is given by the caller or built by the
+  // first direction optimizing search into 'built_' and kept until invalidate().
+  bool symmetric_;
+  const CsrGraph *reverse_;
+  std::unique_ptr<CsrGraph> built_;
+
+  // Pool of the parallel search, kept between searches on the same number of threads.
+  std::unique_ptr<ThreadPool> pool_;
+
+  // Next frontier nodes found by one thread (or one chunk of the frontier in
+  // the deterministic mode).
+  using Buffer = NodeBuffer;
+
+
+  static bool test(const std::vector<uint64_t>& bits, int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+  }
+
+  static void set(std::vector<uint64_t>& bits, int i) {
+    bits[i >> 6] |= uint64_t(1) << (i & 63);
+  }
+
+  // Index of the lowest set bit, 'word' must not be zero.
+  static int lowestBit(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int i = 0;
+    while (!(word & 1)) {
+      word >>= 1;
+      i++;
+    }
+    return i;
+#endif
+  }
+
+
+  // Expands the frontier list along out edges. Returns the edges examined.
+  long long topDownStep(const std::vector<int>& frontier, std::vector<int>& next,
+                        std::vector<uint64_t>& visited, std::vector<int>& prev,
+                        long long& nextEdges) {
+    long long examined = 0;
+    for (int node : frontier) {
+      for (auto edge: graph_->edges(node)) {
+        examined++;
+        int to = edge.first;
+        if (!test(visited, to)) {
+          set(visited, to);
+          prev[to] = node;
+          next.push_back(to);
+          nextEdges += graph_->edges(to).size();
+        }
+      }
+    }
+    return examined;
+  }
+
+
+  // Lets every unvisited node look for a parent in the frontier bitmap along
+  // its in edges 'reverse'. Returns the edges examined.
+  template <typename IN>
+  long long bottomUpStep(const IN& reverse,
+                         const std::vector<uint64_t>& frontier, std::vector<uint64_t>& next,
+                         std::vector<uint64_t>& visited, std::vector<int>& prev,
+                         int& nextSize, long long& nextEdges) {
+    long long examined = 0;
+    for (int node = 0; node < (int)n_; node++) {
+      if (test(visited, node)) continue;
+      for (auto edge: reverse.edges(node)) {
+        examined++;
+        if (test(frontier, edge.first)) {
+          set(visited, node);
+          set(next, node);
+          prev[node] = edge.first;
+          nextSize++;
+          nextEdges += graph_->edges(node).size();
+          break;
+        }
+      }
+    }
+    return examined;
+  }
+
+
+  // Appends the buffers to 'next' in order.
+  static void gather(std::vector<Buffer>& buffers, std::vector<int>& next) {
+    next.clear();
+    for (auto& buffer : buffers) {
+      next.insert(next.end(), buffer.nodes.begin(), buffer.nodes.end());
+      buffer.nodes.clear();
+    }
+  }
+
+
+  // One level of the parallel search, parents are claimed by compare-and-swap.
+  void parallelStep(const std::vector<int>& frontier, std::vector<std::atomic<int>>& parent,
+                    std::vector<Buffer>& buffers) {
+    pool_->parallelFor(0, frontier.size(), [&](int i, int threadId) {
+      int node = frontier[i];
+      for (auto edge: graph_->edges(node)) {
+        int to = edge.first, unvisited = -1;
+        if (parent[to].load(std::memory_order_relaxed) == -1 &&
+            parent[to].compare_exchange_strong(unvisited, node, std::memory_order_relaxed))
+          buffers[threadId].nodes.push_back(to);
+      }
+    }, 64);
+  }
+
+
+  // One level of the deterministic parallel search. Every node goes to the
+  // first frontier node (in frontier order) next to it, like in bfs().
+  void deterministicStep(const std::vector<int>& frontier, std::vector<std::atomic<int>>& parent,
+                         std::vector<std::atomic<int>>& claim, std::vector<Buffer>& buffers) {
+    int size = frontier.size(), chunk = 64;
+    int chunks = (size + chunk - 1) / chunk;
+    if ((int)buffers.size() < chunks) buffers.resize(chunks);
+
+    pool_->parallelFor(0, size, [&](int i, int) {
+      for (auto edge: graph_->edges(frontier[i])) {
+        int to = edge.first;
+        if (parent[to].load(std::memory_order_relaxed) != -1) continue;
+        int current = claim[to].load(std::memory_order_relaxed);
+        while (i < current && !claim[to].compare_exchange_weak(current, i, std::memory_order_relaxed));
+      }
+    }, chunk);
+
+    pool_->parallelFor(0, chunks, [&](int c, int) {
+      for (int i = c * chunk; i < std::min(size, (c + 1) * chunk); i++) {
+        for (auto edge: graph_->edges(frontier[i])) {
+          int to = edge.first;
+          // Only the claiming chunk touches 'to', the parent check drops parallel edges.
+          if (claim[to].load(std::memory_order_relaxed) != i) continue;
+          if (parent[to].load(std::memory_order_relaxed) != -1) continue;
+          parent[to].store(frontier[i], std::memory_order_relaxed);
+          buffers[c].nodes.push_back(to);
+        }
+      }
+    });
+  }
+
+
+  // The direction optimizing search from 'start' with the in edges 'reverse',
+  // 'prev' is all 0 on entry.
+  template <typename IN>
+  void directionOptimizing(int start, const IN& reverse, std::vector<int>& prev) {
+    int words = (n_ + 63) / 64;
+    std::vector<uint64_t> visited(words, 0), frontierBits, nextBits;
+    std::vector<int> frontier{start}, next;
+    set(visited, start);
+
+    int frontierSize = 1;
+    long long frontierEdges = graph_->edges(start).size();
+    long long unexploredEdges = (long long)graph_->edgeCount() - frontierEdges;
+    bool bottomUp = false;
+
+    while (frontierSize > 0) {
+      if (!bottomUp && frontierEdges > unexploredEdges / alpha_) {
+        bottomUp = true;
+        frontierBits.assign(words, 0);
+        for (int node : frontier) set(frontierBits, node);
+      } else if (bottomUp && frontierSize < (int)(n_ / beta_) &&
+                 frontierSize < levels_.back().frontierSize) {
+        bottomUp = false;
+        frontier.clear();
+        for (int node = 0; node < (int)n_; node++)
+          if (test(frontierBits, node)) frontier.push_back(node);
+      }
+
+      long long nextEdges = 0, examined;
+      int nextSize = 0;
+      if (bottomUp) {
+        nextBits.assign(words, 0);
+        examined = bottomUpStep(reverse, frontierBits, nextBits, visited, prev, nextSize, nextEdges);
+        frontierBits.swap(nextBits);
+      } else {
+        next.clear();
+        examined = topDownStep(frontier, next, visited, prev, nextEdges);
+        nextSize = next.size();
+        frontier.swap(next);
+      }
+      levels_.push_back({frontierSize, examined, bottomUp});
+
+      frontierSize = nextSize;
+      frontierEdges = nextEdges;
+      unexploredEdges -= nextEdges;
+    }
+  }
+
 public:
-  BreadthFirstSearchAdjacencyListIterative(Graph *graph) {
+  BasicBreadthFirstSearchAdjacencyListIterative(const GRAPH *graph) {
     if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
 	n_ = graph->size();
     graph_ = graph;
+    alpha_ = 14;
+    beta_ = 24;
+    symmetric_ = false;
+    reverse_ = nullptr;
   }
 
-  BreadthFirstSearchAdjacencyListIterative(const BreadthFirstSearchAdjacencyListIterative&) = delete;
-  BreadthFirstSearchAdjacencyListIterative& operator=(BreadthFirstSearchAdjacencyListIterative const&) = delete;
+  BasicBreadthFirstSearchAdjacencyListIterative(const BasicBreadthFirstSearchAdjacencyListIterative&) = delete;
+  BasicBreadthFirstSearchAdjacencyListIterative& operator=(BasicBreadthFirstSearchAdjacencyListIterative const&) = delete;
 
-  const Graph& operator()() {
+  const GRAPH& operator()() {
     return *graph_;
   }
 
@@ -116,11 +374,6 @@ public:
 
     if (start < 0 || (unsigned)start >= n_) throw std::invalid_argument("Invalid start node index");
 
-    {
-      auto graphItr = (*graph_)()->find(start);
-      if (graphItr == (*graph_)()->end()) return prev;
-    }
-
     // Start by visiting the 'start' node and add it to the queue.
     queue_.push_back(start);
     visited[start] = true;
@@ -130,39 +383,197 @@ public:
       int node = queue_.front();
       queue_.pop_front();
 
-//      std::cout << "BFS visiting node: " <<  node << std::endl;
-      auto graphItr = (*graph_)()->find(node);
-      if (graphItr != (*graph_)()->end()) {
-//        std::cout << "Node " << node << " is in graph map" <<  std::endl;
-        if (!graphItr->second.empty()) {
-//          std::cout << "Node " << node << ", List is not empty" <<  std::endl;
-          // Loop through all edges attached to this node. Mark nodes as visited once they're
-          // in the queue. This will prevent having duplicate nodes in the queue and speedup the BFS.
-          for (auto edge: graphItr->second) {
-//        	  std::cout << edge << std::endl;
-            if (!visited[edge.first]) {
-              visited[edge.first] = true;
-              prev[edge.first] = node;
-              queue_.push_back(edge.first);
-
-//              std::cout << "    visiting edge: " <<  edge.from_ << " --- (" << edge.cost_ << ") --->" << edge.to_ << std::endl;
-            }
-            else {
-  //           std::cout << "    already visited edge: " <<  edge.from_ << " --- (" << edge.cost_ << ") --->" << edge.to_ << std::endl;
-            }
-          }
+      // Loop through all edges attached to this node. Mark nodes as visited once they're
+      // in the queue. This will prevent having duplicate nodes in the queue and speedup the BFS.
+      for (auto edge: graph_->edges(node)) {
+        if (!visited[edge.first]) {
+          visited[edge.first] = true;
+          prev[edge.first] = node;
+          queue_.push_back(edge.first);
         }
+      }
+    }
+
+    return prev;
+  }
+
+
+  // Sets the thresholds of the direction optimizing search: it turns bottom-up
+  // once the frontier has more than 1/alpha of the unexplored edges and back
+  // top-down once the frontier has less than 1/beta of the nodes.
+  void setDirectionParameters(int alpha, int beta) {
+    if (alpha <= 0 || beta <= 0) throw std::invalid_argument("alpha and beta must be positive");
+    alpha_ = alpha;
+    beta_ = beta;
+  }
+
+
+  // Level synchronous BFS from 'start' which switches between top-down and
+  // bottom-up steps. The result has the same layout as bfs(): prev[v] is the
+  // parent of v in a BFS tree, 0 for 'start' and for unreachable nodes. Where
+  // v has several parents on the previous level a bottom-up step may pick a
+  // different one than bfs(), the distances are always the same.
+  std::vector<int> bfsDirectionOptimizing(int start) {
+    std::vector<int> prev(n_, 0);
+    levels_.clear();
+    if (n_ == 0) return prev;
 
+    if (start < 0 || (unsigned)start >= n_) throw std::invalid_argument("Invalid start node index");
+    if (symmetric_) {
+      directionOptimizing(start, *graph_, prev);
+    } else {
+      if (reverse_ == nullptr) {
+        built_ = std::make_unique<CsrGraph>(CsrGraph::reverseOf(*graph_));
+        reverse_ = built_.get();
       }
-      else {
-    	throw std::runtime_error("Key is not in graph map");
+      directionOptimizing(start, *reverse_, prev);
+    }
+    return prev;
+  }
+
+
+  // Drops the in edges built by the direction optimizing search. Must be
+  // called once the graph has changed, the next search builds them again.
+  // In edges given by setReverse() are kept.
+  void invalidate() {
+    n_ = graph_->size();
+    if (built_) {
+      built_ = nullptr;
+      reverse_ = nullptr;
+    }
+  }
+
+
+  // Uses 'reverse', the reverse of the graph, as the in edges of the bottom-up
+  // steps instead of building them. It must stay valid and match the graph
+  // while it is in use, nullptr goes back to building the in edges.
+  void setReverse(const CsrGraph *reverse) {
+    if (reverse != nullptr && reverse->size() != n_) throw std::invalid_argument("reverse->size() != graph size");
+    built_ = nullptr;
+    reverse_ = reverse;
+  }
+
+
+  // Declares that every edge u -> v of the graph has a matching edge v -> u,
+  // so the out edges serve as the in edges and no reverse graph is needed.
+  void setSymmetric(bool symmetric) {
+    symmetric_ = symmetric;
+  }
+
+
+  // Level synchronous BFS from 'start' on 'numThreads' threads. The result has
+  // the same layout as bfs(). With 'deterministic' set it is identical to the
+  // result of bfs(), otherwise the parent of a node with several parents on the
+  // previous level depends on the thread timing.
+  std::vector<int> bfsParallel(int start, int numThreads = ThreadPool::hardwareThreads(), bool deterministic = false) {
+    std::vector<int> prev(n_, 0);
+    if (n_ == 0) return prev;
+
+    if (start < 0 || (unsigned)start >= n_) throw std::invalid_argument("Invalid start node index");
+    if (numThreads <= 0) throw std::invalid_argument("numThreads <= 0");
+    if (!pool_ || pool_->size() != numThreads) pool_ = std::make_unique<ThreadPool>(numThreads);
+
+    std::vector<std::atomic<int>> parent(n_), claim(deterministic ? n_ : 0);
+    for (auto& p : parent) p.store(-1, std::memory_order_relaxed);
+    for (auto& c : claim) c.store(INT_MAX, std::memory_order_relaxed);
+    std::vector<Buffer> buffers(numThreads);
+
+    std::vector<int> frontier{start};
+    parent[start].store(start, std::memory_order_relaxed);
+    while (!frontier.empty()) {
+      if (deterministic) deterministicStep(frontier, parent, claim, buffers);
+      else parallelStep(frontier, parent, buffers);
+      gather(buffers, frontier);
+    }
+
+    pool_->parallelFor(0, n_, [&](int node, int) {
+      int p = parent[node].load(std::memory_order_relaxed);
+      if (p != -1 && node != start) prev[node] = p;
+    }, 4096);
+    return prev;
+  }
+
+
+  // Runs a BFS from every node of 'sources', sharing the edge scans of up to
+  // 64 * WORDS sources at a time. Returns one prev array per source in the
+  // layout of bfs(); if several parents are on the previous level the lowest
+  // numbered one is picked, which may differ from bfs(). If 'distances' is not
+  // null it receives the hop distances per source, -1 for unreachable nodes.
+  template <int WORDS = 1>
+  std::vector<std::vector<int>> bfsBatch(const std::vector<int>& sources,
+                                         std::vector<std::vector<int>> *distances = nullptr) {
+    static_assert(WORDS > 0, "WORDS must be positive");
+    for (int source : sources)
+      if (source < 0 || (unsigned)source >= n_) throw std::invalid_argument("Invalid start node index");
+
+    std::vector<std::vector<int>> prev(sources.size(), std::vector<int>(n_, 0));
+    std::vector<std::vector<int>> dist;
+    if (distances != nullptr) dist.assign(sources.size(), std::vector<int>(n_, -1));
+
+    const int width = 64 * WORDS;
+    std::vector<uint64_t> seen, visit, visitNext;
+    for (unsigned first = 0; first < sources.size(); first += width) {
+      int count = std::min<int>(width, sources.size() - first);
+      seen.assign(n_ * WORDS, 0);
+      visit.assign(n_ * WORDS, 0);
+      visitNext.assign(n_ * WORDS, 0);
+
+      for (int i = 0; i < count; i++) {
+        int source = sources[first + i];
+        uint64_t bit = uint64_t(1) << (i & 63);
+        seen[source * WORDS + (i >> 6)] |= bit;
+        visit[source * WORDS + (i >> 6)] |= bit;
+        if (distances != nullptr) dist[first + i][source] = 0;
+      }
+
+      for (int level = 1; ; level++) {
+        bool any = false;
+        for (int v = 0; v < (int)n_; v++) {
+          const uint64_t *frontier = &visit[v * WORDS];
+          bool active = false;
+          for (int k = 0; k < WORDS; k++) active |= frontier[k] != 0;
+          if (!active) continue;
+
+          for (auto edge: graph_->edges(v)) {
+            int w = edge.first;
+            for (int k = 0; k < WORDS; k++) {
+              uint64_t found = frontier[k] & ~seen[w * WORDS + k] & ~visitNext[w * WORDS + k];
+              if (found == 0) continue;
+              visitNext[w * WORDS + k] |= found;
+              any = true;
+              for (; found != 0; found &= found - 1)
+                prev[first + k * 64 + lowestBit(found)][w] = v;
+            }
+          }
+        }
+        if (!any) break;
+
+        for (int w = 0; w < (int)n_; w++) {
+          for (int k = 0; k < WORDS; k++) {
+            uint64_t found = visitNext[w * WORDS + k];
+            seen[w * WORDS + k] |= found;
+            if (distances != nullptr)
+              for (; found != 0; found &= found - 1)
+                dist[first + k * 64 + lowestBit(found)][w] = level;
+          }
+        }
+        visit.swap(visitNext);
+        std::fill(visitNext.begin(), visitNext.end(), 0);
       }
     }
 
+    if (distances != nullptr) distances->swap(dist);
     return prev;
   }
 
 
+  // Per level statistics of the last direction optimizing search, level 0
+  // holds the start node.
+  const std::vector<Level>& levelStats() const {
+    return levels_;
+  }
+
+
 
   // Reconstructs the path (of nodes) from 'start' to 'end' inclusive. If the edges are unweighted
   // then this method returns the shortest path from 'start' to 'end'
@@ -176,20 +587,11 @@ public:
     if (end < 0 || (unsigned)end >= n_) throw std::invalid_argument("Invalid end node index");
     if (start < 0 || (unsigned)start >= n_) throw std::invalid_argument("Invalid start node index");
 
-    {
-      auto graphItr = (*graph_)()->find(start);
-      if (graphItr == (*graph_)()->end()) return;
-    }
-
     std::vector<int> prev = bfs(start);
-//    std::cout << "prev:" << std::endl;
-//    for (int p : prev) std::cout << p << std::endl;
-//    std::cout << "start:" << start << " end:" << end << std::endl;
 
     int idx = end;
     int cntr = prev.size();
     while (idx != start && cntr--) {
-//    	std::cout << idx << std::endl;
       path.push_front(idx);
       idx = prev.at(idx);
     }
@@ -201,6 +603,8 @@ public:
 
 };
 
+using BreadthFirstSearchAdjacencyListIterative = BasicBreadthFirstSearchAdjacencyListIterative<Graph>;
+
 
 
 // BFS example. 
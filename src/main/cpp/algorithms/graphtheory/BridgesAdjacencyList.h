@@ -4,7 +4,7 @@
  *         (conversion to C++) Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
  * @date   11 July 2020
  * @version 0.1
- * @brief   Finds all the bridges on an undirected graph.
+ * @brief   Finds all the bridges, articulation points and biconnected components on an undirected graph.
  *
  * <p>Test against HackerEarth online judge at:
  * https://www.hackerearth.com/practice/algorithms/graphs/articulation-points-and-bridges/tutorial
@@ -48,6 +48,17 @@
  *         bridges.add(to)
  *     else:
  *       low[at] = min(low[at], ids[to])
+ *
+ * The solver below runs the same search without recursion, on an explicit stack of
+ * (node, parent edge, next edge) frames, so the depth is only limited by memory. The graph is
+ * first copied to a contiguous array of undirected edges with a CSR adjacency of
+ * (neighbour, edge id) entries. Skipping the parent edge by its id instead of the parent node
+ * keeps a second edge between the same two nodes as a back edge, so parallel edges are never
+ * reported as bridges.
+ *
+ * In the same pass, when the search returns from 'to' to 'at' and low[to] >= ids[at], the
+ * edges pushed on an edge stack since the tree edge (at, to) form a biconnected component and
+ * 'at' is an articulation point (the root only if it has two or more tree children).
  */
 
 #ifndef D_GRAPH_BRIDGES_H
@@ -77,50 +88,145 @@
 
 namespace dsa {
 
-class BridgesAdjacencyList {
+// GRAPH is a graph type with the interface described in CsrGraph.h. It has
+// to store every undirected edge in both directions, as addUndirectedEdge() does.
+template <typename GRAPH>
+class BasicBridgesAdjacencyList {
 private:
   const double POSITIVE_INFINITY = std::numeric_limits<double>::infinity();
   const double NEGATIVE_INFINITY = -std::numeric_limits<double>::infinity();
 
+  // A node of the explicit depth first search stack.
+  struct Frame {
+    int node, parentEdge, next;
+  };
+
   int N_, id_;
   std::vector<int> low_, ids_;
   bool solved_;
-  std::vector<bool> visited_;
-  Graph *graph_;
+  const GRAPH *graph_;
   std::vector<int> bridges_;
 
+  // Undirected edge i joins from_[i] and to_[i]. The neighbours of node u are
+  // adjNode_/adjEdge_ in [offsets_[u], offsets_[u + 1]).
+  std::vector<int> from_, to_;
+  std::vector<int> offsets_, adjNode_, adjEdge_;
+
+  std::vector<int> articulationPoints_;
+  std::vector<int> edgeComponent_;
+  int componentCount_;
+
+
+  // Copies the graph to the undirected edge array. An edge u -> v with u < v
+  // stands for one undirected edge, its copy v -> u is dropped, and so are
+  // self loops.
+  void buildEdges() {
+    for (int u = 0; u < N_; u++) {
+      for (auto edge: graph_->edges(u)) {
+        if (u < edge.first) {
+          if (edge.first >= N_) throw std::invalid_argument("Invalid node index");
+          from_.push_back(u);
+          to_.push_back(edge.first);
+        }
+      }
+    }
+
+    int M = from_.size();
+    offsets_.assign(N_ + 1, 0);
+    for (int i = 0; i < M; i++) {
+      offsets_[from_[i] + 1]++;
+      offsets_[to_[i] + 1]++;
+    }
+    for (int u = 0; u < N_; u++) offsets_[u + 1] += offsets_[u];
+    adjNode_.resize(2 * M);
+    adjEdge_.resize(2 * M);
+    std::vector<int> pos(offsets_.begin(), offsets_.end() - 1);
+    for (int i = 0; i < M; i++) {
+      adjNode_[pos[from_[i]]] = to_[i];
+      adjEdge_[pos[from_[i]]++] = i;
+      adjNode_[pos[to_[i]]] = from_[i];
+      adjEdge_[pos[to_[i]]++] = i;
+    }
+  }
+
+
+  void dfs(int root, std::vector<Frame>& stack, std::vector<int>& edgeStack, std::vector<bool>& articulation) {
+    int rootChildren = 0;
+    low_[root] = ids_[root] = ++id_;
+    stack.push_back({root, -1, offsets_[root]});
+
+    while (!stack.empty()) {
+      Frame& frame = stack.back();
+      int at = frame.node;
+
+      if (frame.next < offsets_[at + 1]) {
+        int to = adjNode_[frame.next], edge = adjEdge_[frame.next];
+        frame.next++;
+        if (edge == frame.parentEdge) continue;
 
-  void dfs(int at, int parent) {
-
-    visited_[at] = true;
-    low_[at] = ids_[at] = ++id_;
-
-    auto graphItr = (*graph_)()->find(at);
-    if (graphItr != (*graph_)()->end()) {
-      if (!graphItr->second.empty()){
-        for (auto edge: graphItr->second){
-          if (edge.first == parent) continue;
-          if (!visited_[edge.first]) {
-            dfs(edge.first, at);
-            low_[at] = std::min(low_[at], low_[edge.first]);
-            if (ids_[at] < low_[edge.first]) {
-              bridges_.push_back(at);
-              bridges_.push_back(edge.first);
-            }
-          } else {
-            low_[at] = std::min(low_[at], ids_[edge.first]);
-          }
+        if (ids_[to] == 0) {
+          edgeStack.push_back(edge);
+          low_[to] = ids_[to] = ++id_;
+          if (at == root) rootChildren++;
+          stack.push_back({to, edge, offsets_[to]});
+        } else if (ids_[to] < ids_[at]) {
+          // A back edge to an ancestor. Seen from the ancestor the same edge
+          // leads to a visited descendant and is skipped.
+          low_[at] = std::min(low_[at], ids_[to]);
+          edgeStack.push_back(edge);
         }
+        continue;
+      }
+
+      // Every edge of 'at' is done, return to its parent.
+      int parentEdge = frame.parentEdge;
+      stack.pop_back();
+      if (stack.empty()) break;
+      int parent = stack.back().node;
+      low_[parent] = std::min(low_[parent], low_[at]);
+
+      if (low_[at] >= ids_[parent]) {
+        if (parent != root) articulation[parent] = true;
+        for (;;) {
+          int edge = edgeStack.back();
+          edgeStack.pop_back();
+          edgeComponent_[edge] = componentCount_;
+          if (edge == parentEdge) break;
+        }
+        componentCount_++;
+      }
+      if (low_[at] > ids_[parent]) {
+        bridges_.push_back(parent);
+        bridges_.push_back(at);
       }
     }
 
+    if (rootChildren >= 2) articulation[root] = true;
+  }
+
+
+  void solve() {
+    if (solved_) return;
+    buildEdges();
+    edgeComponent_.assign(from_.size(), -1);
+    componentCount_ = 0;
+
+    std::vector<Frame> stack;
+    std::vector<int> edgeStack;
+    std::vector<bool> articulation(N_, false);
+
+    // Finds all bridges in the graph across various connected components.
+    for (int i = 0; i < N_; i++) if (ids_[i] == 0) dfs(i, stack, edgeStack, articulation);
+
+    for (int i = 0; i < N_; i++) if (articulation[i]) articulationPoints_.push_back(i);
+    solved_ = true;
   }
 
 public:
-  BridgesAdjacencyList(const BridgesAdjacencyList&) = delete;
-  BridgesAdjacencyList& operator=(BridgesAdjacencyList const&) = delete;
+  BasicBridgesAdjacencyList(const BasicBridgesAdjacencyList&) = delete;
+  BasicBridgesAdjacencyList& operator=(BasicBridgesAdjacencyList const&) = delete;
   
-  BridgesAdjacencyList(Graph *graph) {
+  BasicBridgesAdjacencyList(const GRAPH *graph) {
 	if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
     N_ = graph->size();
     if (N_ == 0) throw std::invalid_argument("GRAPH Empty");
@@ -128,29 +234,80 @@ public:
 
     id_ = 0;
     low_.resize(N_, -1); // Low link values
-    ids_.resize(N_, 0); // Nodes ids
-    visited_.resize(N_, false);
+    ids_.resize(N_, 0); // Nodes ids, 0 while unvisited
     solved_ = false;
+    componentCount_ = 0;
   }
 
 
+  const GRAPH& operator()() {
+    return *graph_;
+  }
+
 
   // Returns a list of pairs of nodes indicating which nodes form bridges.
   // The returned list is always of even length and indexes (2*i, 2*i+1) form a
   // pair. For example, nodes at indexes (0, 1) are a pair, (2, 3) are another
   // pair, etc...
   const std::vector<int>& findBridges() {
-    if (solved_) return bridges_;
+    if (!solved_) solve();
+    return bridges_;
+  }
 
-    // Finds all bridges in the graph across various connected components.
-    for (int i = 0; i < N_; i++) if (!visited_[i]) dfs(i, -1);
 
-    solved_ = true;
-    return bridges_;
+  // Returns the articulation points (cut vertices) in ascending order.
+  const std::vector<int>& findArticulationPoints() {
+    if (!solved_) solve();
+    return articulationPoints_;
+  }
+
+
+  // Returns the number of biconnected components. A bridge is a component
+  // of its own, isolated nodes and self loops belong to none.
+  int biconnectedComponentCount() {
+    if (!solved_) solve();
+    return componentCount_;
+  }
+
+
+  // Returns the undirected edges as (from, to) pairs with from < to, in the
+  // order getEdgeComponentIds() refers to them.
+  std::vector<std::pair<int, int>> getEdges() {
+    if (!solved_) solve();
+    std::vector<std::pair<int, int>> edges(from_.size());
+    for (unsigned i = 0; i < from_.size(); i++) edges[i] = {from_[i], to_[i]};
+    return edges;
+  }
+
+
+  // Returns the biconnected component of every undirected edge of getEdges(),
+  // component ids are in [0, biconnectedComponentCount()).
+  const std::vector<int>& getEdgeComponentIds() {
+    if (!solved_) solve();
+    return edgeComponent_;
+  }
+
+
+  // Returns the nodes of every biconnected component in ascending order. An
+  // articulation point appears in every component it joins.
+  std::vector<std::vector<int>> getBiconnectedComponents() {
+    if (!solved_) solve();
+    std::vector<std::vector<int>> components(componentCount_);
+    for (unsigned i = 0; i < from_.size(); i++) {
+      components[edgeComponent_[i]].push_back(from_[i]);
+      components[edgeComponent_[i]].push_back(to_[i]);
+    }
+    for (auto& nodes : components) {
+      std::sort(nodes.begin(), nodes.end());
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    }
+    return components;
   }
 
 };
 
+using BridgesAdjacencyList = BasicBridgesAdjacencyList<Graph>;
+
 
 
 // Example usage of Bridge
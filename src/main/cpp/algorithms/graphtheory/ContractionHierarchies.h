@@ -0,0 +1,731 @@
+/*
+ * @file   ContractionHierarchies.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Contraction Hierarchies (CH) for fast point-to-point shortest path queries.
+ *
+ * Preprocessing contracts the nodes one after another in order of importance. Contracting a node v
+ * removes it from the graph and, for every pair of neighbours u -> v -> w, adds a shortcut edge
+ * u -> w of cost c(u, v) + c(v, w) unless a witness search finds a path from u to w avoiding v
+ * which is not longer. The shortcuts keep all distances between the remaining nodes intact. The
+ * position of a node in the contraction order is its rank.
+ *
+ * Every edge of the final graph (original edges plus shortcuts) leads either up or down in rank, and
+ * every shortest path has an equally short counterpart which goes only up and then only down. A
+ * query therefore runs a forward Dijkstra from the start and a backward Dijkstra from the end which
+ * both only follow edges to higher ranked nodes. Each side stops once its smallest key reaches the
+ * best path found, and on road networks each settles only a few hundred nodes. Shortcuts remember the
+ * node they bypass, so the path found is unpacked recursively into original edges.
+ *
+ * The contraction order follows the usual heuristic: priority(v) = 2 * edge difference
+ * (shortcuts added - edges removed) + number of contracted neighbours. To contract in parallel, every
+ * round selects the uncontracted nodes whose priority is smaller than the priority of each of their
+ * neighbours. These nodes form an independent set: their witness searches (which ignore every node of
+ * the round) run in parallel on the ThreadPool, and the shortcuts are inserted afterwards. The rounds
+ * do not depend on the number of threads, so the hierarchy is the same for any thread count.
+ *
+ * Edge weights must be non negative. Parallel edges are merged and self loops dropped.
+ */
+
+#ifndef D_GRAPH_CONTRACTIONHIERARCHIES_H
+#define D_GRAPH_CONTRACTIONHIERARCHIES_H
+
+#include <Graph.h>
+#include <CsrGraph.h>
+#include <ThreadPool.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+
+#include <vector>
+#include <list>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cstdint>
+
+#include <sstream>
+#include <memory>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace dsa {
+
+// A contracted graph: the rank of every node and the edges leading up in rank.
+class ContractionHierarchy {
+
+  // Computes the contraction order and the shortcuts on a mutable copy of
+  // the graph.
+  class Builder {
+    // Witness searches give up after settling this many nodes. A search
+    // which gives up only costs a superfluous shortcut, never correctness.
+    // Estimating priorities uses a smaller limit than the contraction.
+    static const int WITNESS_SETTLE_LIMIT = 500;
+    static const int PRIORITY_SETTLE_LIMIT = 50;
+
+    struct Arc {
+      int node_;
+      double cost_;
+      int middle_;  // The bypassed node of a shortcut, -1 for original edges.
+    };
+
+    struct Shortcut {
+      int from_, to_;
+      double cost_;
+    };
+
+    // Per thread state of the witness searches.
+    struct Witness {
+      std::unique_ptr<MinIndexedDHeap<double>> ipq_;
+      std::vector<double> dist_;
+      std::vector<unsigned> stamp_, target_;
+      unsigned epoch_;
+    };
+
+    int N_;
+    std::vector<std::vector<Arc>> out_, in_;
+    std::vector<int> contractedNeighbours_, priority_;
+    std::vector<char> contracted_, excluded_;
+    std::vector<Witness> witness_;
+    ThreadPool pool_;
+
+
+    // Starts a new witness search, its targets are marked with the epoch.
+    static void newEpoch(Witness& ws) {
+      ws.ipq_->clear();
+      if (++ws.epoch_ == 0) {
+        std::fill(ws.stamp_.begin(), ws.stamp_.end(), 0);
+        std::fill(ws.target_.begin(), ws.target_.end(), 0);
+        ws.epoch_ = 1;
+      }
+    }
+
+
+    // Dijkstra from 'source' over the uncontracted graph, skipping 'avoid'
+    // and every node of the current round, up to a cost of 'maxCost' or until
+    // the 'targets' nodes marked in ws.target_ are settled.
+    void witnessSearch(Witness& ws, int source, int avoid, double maxCost, int targets, int settleLimit) {
+      ws.stamp_[source] = ws.epoch_;
+      ws.dist_[source] = 0;
+      ws.ipq_->insert(source, 0.0);
+
+      for (int settled = 0; !ws.ipq_->isEmpty() && settled < settleLimit; settled++) {
+        if (ws.ipq_->peekMinValue() > maxCost) break;
+        int x = ws.ipq_->pollMinKeyIndex();
+        if (ws.target_[x] == ws.epoch_ && --targets == 0) break;
+        for (const Arc& arc : out_[x]) {
+          int y = arc.node_;
+          if (y == avoid || excluded_[y]) continue;
+          double newDist = ws.dist_[x] + arc.cost_;
+          if (ws.stamp_[y] != ws.epoch_) {
+            ws.stamp_[y] = ws.epoch_;
+            ws.dist_[y] = newDist;
+            ws.ipq_->insert(y, newDist);
+          } else if (newDist < ws.dist_[y] && ws.ipq_->contains(y)) {
+            ws.dist_[y] = newDist;
+            ws.ipq_->decrease(y, newDist);
+          }
+        }
+      }
+    }
+
+
+    // Finds the shortcuts needed to contract 'v' and returns their number.
+    // They are appended to 'shortcuts' unless it is null.
+    int simulate(int v, int threadId, std::vector<Shortcut> *shortcuts) {
+      Witness& ws = witness_[threadId];
+      int count = 0;
+      for (const Arc& in : in_[v]) {
+        double maxCost = -1;
+        int targets = 0;
+        newEpoch(ws);
+        for (const Arc& out : out_[v]) {
+          if (out.node_ == in.node_) continue;
+          maxCost = std::max(maxCost, in.cost_ + out.cost_);
+          ws.target_[out.node_] = ws.epoch_;
+          targets++;
+        }
+        if (targets == 0) continue;
+
+        witnessSearch(ws, in.node_, v, maxCost, targets, shortcuts ? WITNESS_SETTLE_LIMIT : PRIORITY_SETTLE_LIMIT);
+        for (const Arc& out : out_[v]) {
+          if (out.node_ == in.node_) continue;
+          double via = in.cost_ + out.cost_;
+          if (ws.stamp_[out.node_] == ws.epoch_ && ws.dist_[out.node_] <= via) continue;
+          count++;
+          if (shortcuts) shortcuts->push_back({in.node_, out.node_, via});
+        }
+      }
+      return count;
+    }
+
+
+    int computePriority(int v, int threadId) {
+      int edgeDifference = simulate(v, threadId, nullptr) - (int)(in_[v].size() + out_[v].size());
+      return 2 * edgeDifference + contractedNeighbours_[v];
+    }
+
+
+    // Total order on the priorities, ties broken by a hash of the node id so
+    // that equal priorities do not produce long chains of waiting nodes.
+    bool before(int u, int v) const {
+      if (priority_[u] != priority_[v]) return priority_[u] < priority_[v];
+      uint32_t hu = (uint32_t)u * 2654435761u, hv = (uint32_t)v * 2654435761u;
+      return hu != hv ? hu < hv : u < v;
+    }
+
+
+    bool isLocalMinimum(int v) const {
+      for (const Arc& arc : out_[v]) if (!before(v, arc.node_)) return false;
+      for (const Arc& arc : in_[v]) if (!before(v, arc.node_)) return false;
+      return true;
+    }
+
+
+    static void eraseArcsTo(std::vector<Arc>& arcs, int node) {
+      arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [node](const Arc& a) { return a.node_ == node; }), arcs.end());
+    }
+
+
+    // Inserts the edge u -> w or lowers the cost of an existing one.
+    void addArc(int u, int w, double cost, int middle) {
+      for (Arc& arc : out_[u]) {
+        if (arc.node_ != w) continue;
+        if (cost < arc.cost_) {
+          arc.cost_ = cost;
+          arc.middle_ = middle;
+          for (Arc& back : in_[w]) {
+            if (back.node_ == u) {
+              back.cost_ = cost;
+              back.middle_ = middle;
+            }
+          }
+        }
+        return;
+      }
+      out_[u].push_back({w, cost, middle});
+      in_[w].push_back({u, cost, middle});
+    }
+
+  public:
+    template <typename GRAPH>
+    Builder(const GRAPH& graph, int numThreads) : pool_(numThreads) {
+      N_ = graph.size();
+      out_.resize(N_);
+      in_.resize(N_);
+      for (int u = 0; u < N_; u++) {
+        for (auto edge: graph.edges(u)) {
+          if (edge.first < 0 || edge.first >= N_) throw std::invalid_argument("Invalid node index");
+          if (edge.second < 0) throw std::invalid_argument("Negative edge weight");
+          if (edge.first != u) addArc(u, edge.first, edge.second, -1);
+        }
+      }
+
+      contractedNeighbours_.assign(N_, 0);
+      priority_.assign(N_, 0);
+      contracted_.assign(N_, 0);
+      excluded_.assign(N_, 0);
+      witness_.resize(pool_.size());
+      for (Witness& ws : witness_) {
+        ws.ipq_ = std::make_unique<MinIndexedDHeap<double>>(4, std::max(1, N_));
+        ws.dist_.resize(N_, 0);
+        ws.stamp_.resize(N_, 0);
+        ws.target_.resize(N_, 0);
+        ws.epoch_ = 0;
+      }
+    }
+
+
+    // Contracts every node. 'rank' receives the contraction order, the
+    // edges leaving each node towards higher ranks are appended to 'up'
+    // (in original direction) and 'down' (reversed) together with the
+    // bypassed nodes of shortcuts.
+    void contract(std::vector<int>& rank, std::vector<Edge>& up, std::vector<int>& upMiddle,
+                  std::vector<Edge>& down, std::vector<int>& downMiddle,
+                  const std::function<void(int, int)>& progress) {
+      rank.assign(N_, -1);
+      pool_.parallelFor(0, N_, [&](int v, int tid) { priority_[v] = computePriority(v, tid); }, 64);
+
+      std::vector<int> remaining(N_);
+      for (int v = 0; v < N_; v++) remaining[v] = v;
+      std::vector<char> selected(N_, 0);
+      std::vector<std::vector<Shortcut>> shortcuts;
+      std::vector<int> touched;
+      int done = 0;
+
+      while (!remaining.empty()) {
+        pool_.parallelFor(0, remaining.size(), [&](int i, int) {
+          selected[remaining[i]] = isLocalMinimum(remaining[i]);
+        }, 256);
+
+        std::vector<int> round, rest;
+        for (int v : remaining) (selected[v] ? round : rest).push_back(v);
+        remaining.swap(rest);
+
+        for (int v : round) excluded_[v] = 1;
+        shortcuts.assign(round.size(), std::vector<Shortcut>());
+        pool_.parallelFor(0, round.size(), [&](int i, int tid) { simulate(round[i], tid, &shortcuts[i]); }, 4);
+        for (int v : round) excluded_[v] = 0;
+
+        touched.clear();
+        for (size_t i = 0; i < round.size(); i++) {
+          int v = round[i];
+          rank[v] = done++;
+          contracted_[v] = 1;
+          selected[v] = 0;
+
+          for (const Arc& arc : out_[v]) {
+            up.push_back({v, arc.node_, arc.cost_});
+            upMiddle.push_back(arc.middle_);
+            eraseArcsTo(in_[arc.node_], v);
+            contractedNeighbours_[arc.node_]++;
+            touched.push_back(arc.node_);
+          }
+          for (const Arc& arc : in_[v]) {
+            down.push_back({v, arc.node_, arc.cost_});
+            downMiddle.push_back(arc.middle_);
+            eraseArcsTo(out_[arc.node_], v);
+            contractedNeighbours_[arc.node_]++;
+            touched.push_back(arc.node_);
+          }
+          for (const Shortcut& s : shortcuts[i]) addArc(s.from_, s.to_, s.cost_, v);
+
+          std::vector<Arc>().swap(out_[v]);
+          std::vector<Arc>().swap(in_[v]);
+        }
+
+        // Only the priorities of the neighbours of contracted nodes change.
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        pool_.parallelFor(0, touched.size(), [&](int i, int tid) {
+          priority_[touched[i]] = computePriority(touched[i], tid);
+        }, 16);
+
+        if (progress) progress(done, N_);
+      }
+    }
+  };
+
+
+  int N_;
+  std::vector<int> rank_;
+  // up_ holds the edges u -> v with rank(u) < rank(v), down_ holds the edges
+  // u -> v with rank(u) > rank(v) reversed as v -> u. The middle arrays are
+  // parallel to their edge arrays.
+  CsrGraph up_, down_;
+  std::vector<int> upMiddle_, downMiddle_;
+  int shortcuts_;
+
+
+  // Builds a CSR graph and reorders 'middle' the same way.
+  static CsrGraph toCsr(int n, const std::vector<Edge>& edges, std::vector<int>& middle) {
+    CsrGraph csr(n, edges);
+    std::vector<int> pos(csr.offsets().begin(), csr.offsets().end() - 1);
+    std::vector<int> sorted(middle.size());
+    for (size_t i = 0; i < edges.size(); i++) sorted[pos[edges[i].from_]++] = middle[i];
+    middle.swap(sorted);
+    return csr;
+  }
+
+
+  void build(std::vector<Edge>& up, std::vector<Edge>& down) {
+    shortcuts_ = 0;
+    for (int m : upMiddle_) shortcuts_ += m != -1;
+    for (int m : downMiddle_) shortcuts_ += m != -1;
+    up_ = toCsr(N_, up, upMiddle_);
+    down_ = toCsr(N_, down, downMiddle_);
+  }
+
+
+  template <typename T>
+  static void write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  static void read(std::istream& in, T& value) {
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+      throw std::invalid_argument("Truncated contraction hierarchy");
+  }
+
+  static constexpr uint32_t MAGIC = 0x31484344; // "DCH1"
+
+
+  void writeEdges(std::ostream& out, const CsrGraph& graph, const std::vector<int>& middle) const {
+    write(out, (uint32_t)graph.edgeCount());
+    for (int u = 0; u < N_; u++) {
+      int i = graph.offsets()[u];
+      for (auto edge: graph.edges(u)) {
+        write(out, (int32_t)u);
+        write(out, (int32_t)edge.first);
+        write(out, edge.second);
+        write(out, (int32_t)middle[i++]);
+      }
+    }
+  }
+
+
+  // Reads the edges of upward() or downward(). Both are stored from the
+  // lower to the higher ranked node, and the node bypassed by a shortcut
+  // must rank below both ends or unpacking it would not terminate.
+  void readEdges(std::istream& in, std::vector<Edge>& edges, std::vector<int>& middle) {
+    uint32_t count;
+    read(in, count);
+    for (uint32_t i = 0; i < count; i++) {
+      int32_t from, to, mid;
+      double cost;
+      read(in, from);
+      read(in, to);
+      read(in, cost);
+      read(in, mid);
+      if (from < 0 || from >= N_ || to < 0 || to >= N_ || rank_[from] >= rank_[to])
+        throw std::invalid_argument("Invalid contraction hierarchy");
+      if (mid < -1 || mid >= N_ || (mid != -1 && rank_[mid] >= rank_[from]))
+        throw std::invalid_argument("Invalid contraction hierarchy");
+      edges.push_back({from, to, cost});
+      middle.push_back(mid);
+    }
+  }
+
+public:
+  // Contracts 'graph' using 'numThreads' threads. 'progress(contracted, total)'
+  // is called after every round of contractions.
+  template <typename GRAPH>
+  explicit ContractionHierarchy(const GRAPH *graph, int numThreads = 1,
+                                const std::function<void(int, int)>& progress = nullptr) :
+    up_(0, std::vector<Edge>()), down_(0, std::vector<Edge>()) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    N_ = graph->size();
+
+    std::vector<Edge> up, down;
+    Builder builder(*graph, numThreads);
+    builder.contract(rank_, up, upMiddle_, down, downMiddle_, progress);
+    build(up, down);
+  }
+
+
+  // Loads a hierarchy written by save().
+  explicit ContractionHierarchy(std::istream& in) : up_(0, std::vector<Edge>()), down_(0, std::vector<Edge>()) {
+    uint32_t magic, n;
+    read(in, magic);
+    if (magic != MAGIC) throw std::invalid_argument("Not a contraction hierarchy");
+    read(in, n);
+    N_ = n;
+    rank_.resize(N_);
+    std::vector<char> taken(N_, 0);
+    for (int v = 0; v < N_; v++) {
+      int32_t r;
+      read(in, r);
+      // The ranks must be a permutation of [0, n).
+      if (r < 0 || r >= N_ || taken[r]) throw std::invalid_argument("Invalid contraction hierarchy");
+      taken[r] = 1;
+      rank_[v] = r;
+    }
+
+    std::vector<Edge> up, down;
+    readEdges(in, up, upMiddle_);
+    readEdges(in, down, downMiddle_);
+    build(up, down);
+  }
+
+
+  // Writes the hierarchy in a binary format (native byte order).
+  void save(std::ostream& out) const {
+    // A local copy, binding MAGIC itself to write() would need a definition
+    // of the member outside the class before C++17.
+    uint32_t magic = MAGIC;
+    write(out, magic);
+    write(out, (uint32_t)N_);
+    for (int r : rank_) write(out, (int32_t)r);
+    writeEdges(out, up_, upMiddle_);
+    writeEdges(out, down_, downMiddle_);
+  }
+
+
+  // Get number of nodes
+  int size() const {
+    return N_;
+  }
+
+
+  // Get the position of 'node' in the contraction order.
+  int rank(int node) const {
+    return rank_[node];
+  }
+
+
+  // Get the number of shortcut edges.
+  int shortcutCount() const {
+    return shortcuts_;
+  }
+
+
+  // Edges to higher ranked nodes, for the forward search.
+  const CsrGraph& upward() const {
+    return up_;
+  }
+
+
+  // Reversed edges from higher ranked nodes, for the backward search.
+  const CsrGraph& downward() const {
+    return down_;
+  }
+
+
+  // The node bypassed by the i-th edge of upward() / downward(), -1 if the
+  // edge is an original edge.
+  int upwardMiddle(int i) const {
+    return upMiddle_[i];
+  }
+
+  int downwardMiddle(int i) const {
+    return downMiddle_[i];
+  }
+
+
+  // The node bypassed by the edge u -> v of the hierarchy.
+  int middleOf(int u, int v) const {
+    if (rank_[u] < rank_[v]) {
+      for (int i = up_.offsets()[u]; i < up_.offsets()[u + 1]; i++)
+        if (up_.targets()[i] == v) return upMiddle_[i];
+    } else {
+      for (int i = down_.offsets()[v]; i < down_.offsets()[v + 1]; i++)
+        if (down_.targets()[i] == u) return downMiddle_[i];
+    }
+    throw std::invalid_argument("No such edge in the hierarchy");
+  }
+};
+
+
+
+// Upward bidirectional Dijkstra on a ContractionHierarchy. Like the other
+// query engines it keeps its heaps and arrays between queries.
+class ContractionHierarchyQuery {
+private:
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // The state of the search in one direction. prev_ is the node the search
+  // came from and middle_ the bypassed node of the edge it used.
+  struct Search {
+    std::unique_ptr<MinIndexedDHeap<double>> ipq_;
+    std::vector<double> dist_;
+    std::vector<int> prev_, middle_;
+    std::vector<unsigned> stamp_;
+  };
+
+  int N_;
+  const ContractionHierarchy *ch_;
+  Search forward_, backward_;
+  unsigned epoch_;
+  int settledCount_;
+  double best_;
+  int meeting_;
+
+
+  void init(Search& search) {
+    search.ipq_ = std::make_unique<MinIndexedDHeap<double>>(4, std::max(1, N_));
+    search.dist_.resize(N_, inf);
+    search.prev_.resize(N_, -1);
+    search.middle_.resize(N_, -1);
+    search.stamp_.resize(N_, 0);
+  }
+
+
+  void checkNode(int node) const {
+    if (node < 0 || node >= N_) throw std::invalid_argument("Invalid node index");
+  }
+
+
+  bool finished(const Search& search) const {
+    return search.ipq_->isEmpty() || search.ipq_->peekMinValue() >= best_;
+  }
+
+
+  void step(Search& search, const Search& other, const CsrGraph& graph, bool forward) {
+    int nodeId = search.ipq_->pollMinKeyIndex();
+    settledCount_++;
+
+    int i = graph.offsets()[nodeId];
+    for (auto edge: graph.edges(nodeId)) {
+      int to = edge.first;
+      int middle = forward ? ch_->upwardMiddle(i++) : ch_->downwardMiddle(i++);
+      double newDist = search.dist_[nodeId] + edge.second;
+      if (search.stamp_[to] != epoch_) {
+        search.stamp_[to] = epoch_;
+        search.dist_[to] = newDist;
+        search.ipq_->insert(to, newDist);
+      } else if (newDist < search.dist_[to] && search.ipq_->contains(to)) {
+        search.dist_[to] = newDist;
+        search.ipq_->decrease(to, newDist);
+      } else {
+        continue;
+      }
+      search.prev_[to] = nodeId;
+      search.middle_[to] = middle;
+
+      if (other.stamp_[to] == epoch_ && newDist + other.dist_[to] < best_) {
+        best_ = newDist + other.dist_[to];
+        meeting_ = to;
+      }
+    }
+  }
+
+
+  double query(int start, int end) {
+    forward_.ipq_->clear();
+    backward_.ipq_->clear();
+    settledCount_ = 0;
+    if (++epoch_ == 0) {
+      std::fill(forward_.stamp_.begin(), forward_.stamp_.end(), 0);
+      std::fill(backward_.stamp_.begin(), backward_.stamp_.end(), 0);
+      epoch_ = 1;
+    }
+
+    for (Search *search : {&forward_, &backward_}) {
+      int source = search == &forward_ ? start : end;
+      search->stamp_[source] = epoch_;
+      search->dist_[source] = 0;
+      search->prev_[source] = -1;
+      search->middle_[source] = -1;
+      search->ipq_->insert(source, 0.0);
+    }
+    best_ = start == end ? 0 : inf;
+    meeting_ = start == end ? start : -1;
+
+    // Unlike plain bidirectional Dijkstra, both searches go on until their
+    // own queue can no longer improve the best path: the upward searches do
+    // not meet at the middle of the path but at its highest ranked node.
+    for (;;) {
+      bool forwardDone = finished(forward_), backwardDone = finished(backward_);
+      if (forwardDone && backwardDone) break;
+      if (!forwardDone && (backwardDone || forward_.ipq_->peekMinValue() <= backward_.ipq_->peekMinValue()))
+        step(forward_, backward_, ch_->upward(), true);
+      else
+        step(backward_, forward_, ch_->downward(), false);
+    }
+    return best_;
+  }
+
+
+  // Appends the original path of the hierarchy edge u -> v (without u).
+  void unpack(int u, int v, int middle, std::list<int>& path) const {
+    std::vector<std::pair<std::pair<int, int>, int>> stack{{{u, v}, middle}};
+    while (!stack.empty()) {
+      auto top = stack.back();
+      stack.pop_back();
+      int from = top.first.first, to = top.first.second, mid = top.second;
+      if (mid == -1) {
+        path.push_back(to);
+      } else {
+        stack.push_back({{mid, to}, ch_->middleOf(mid, to)});
+        stack.push_back({{from, mid}, ch_->middleOf(from, mid)});
+      }
+    }
+  }
+
+public:
+  ContractionHierarchyQuery(const ContractionHierarchy *ch) {
+    if (ch == nullptr) throw std::invalid_argument("CH NULL");
+    ch_ = ch;
+    N_ = ch->size();
+    init(forward_);
+    init(backward_);
+    epoch_ = 0;
+    settledCount_ = 0;
+    best_ = inf;
+    meeting_ = -1;
+  }
+
+
+  ContractionHierarchyQuery(const ContractionHierarchyQuery&) = delete;
+  ContractionHierarchyQuery& operator=(ContractionHierarchyQuery const&) = delete;
+
+
+  // Returns the cost of the shortest path from 'start' to 'end', or infinity
+  // if 'end' is unreachable.
+  double shortestPath(int start, int end) {
+    checkNode(start);
+    checkNode(end);
+    return query(start, end);
+  }
+
+
+  // Number of nodes settled by the last query, both directions together.
+  int settledNodes() const {
+    return settledCount_;
+  }
+
+
+  // Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive,
+  // with all shortcuts unpacked into original edges.
+  //
+  // @return An array of node indexes of the shortest path from 'start' to 'end'. If 'start' and
+  //     'end' are not connected then an empty array is returned.
+  //
+  std::list<int> reconstructPath(int start, int end) {
+    double dist = shortestPath(start, end);
+    std::list<int> path;
+    if (dist == inf) return path;
+
+    // Hierarchy edges from the start up to the meeting node.
+    std::vector<int> upPath;
+    for (int at = meeting_; at != -1; at = forward_.prev_[at]) upPath.push_back(at);
+    std::reverse(upPath.begin(), upPath.end());
+
+    path.push_back(start);
+    for (size_t i = 1; i < upPath.size(); i++)
+      unpack(upPath[i - 1], upPath[i], forward_.middle_[upPath[i]], path);
+    // And down from the meeting node to the end.
+    for (int at = meeting_; backward_.prev_[at] != -1; at = backward_.prev_[at])
+      unpack(at, backward_.prev_[at], backward_.middle_[at], path);
+    return path;
+  }
+
+};
+
+
+
+// Example usage of ContractionHierarchy
+int ContractionHierarchies_test()
+{
+  Graph graph(8);
+
+  graph.addDirectedEdge(6, 0, 1.1);
+  graph.addDirectedEdge(6, 2, 0.2);
+  graph.addDirectedEdge(3, 4, 3.6);
+  graph.addDirectedEdge(6, 4, 0.4);
+  graph.addDirectedEdge(2, 0, 0.7);
+  graph.addDirectedEdge(0, 1, 3.4);
+  graph.addDirectedEdge(4, 5, 6.9);
+  graph.addDirectedEdge(5, 6, 0.9);
+  graph.addDirectedEdge(3, 7, 8.2);
+  graph.addDirectedEdge(7, 5, 0.3);
+  graph.addDirectedEdge(1, 2, 4.6);
+  graph.addDirectedEdge(7, 3, 6.4);
+  graph.addDirectedEdge(5, 0, 10.1);
+
+  ContractionHierarchy ch(&graph, ThreadPool::hardwareThreads(), [](int done, int total) {
+    std::cout << "Contracted " << done << "/" << total << " nodes" << std::endl;
+  });
+
+  // The hierarchy can be stored and loaded again.
+  std::stringstream buffer;
+  ch.save(buffer);
+  ContractionHierarchy loaded(buffer);
+
+  ContractionHierarchyQuery query(&loaded);
+  int start = 3, end = 0;
+  std::list<int> path = query.reconstructPath(start, end);
+
+  std::cout << "CH shortest path from " << start << " to " << end << ": [";
+  for (auto node: path) std::cout << node << ",";
+  std::cout << "] cost " << query.shortestPath(start, end) << std::endl;
+  // Prints:
+  // CH shortest path from 3 to 0: [3,7,5,6,2,0,] cost 10.3
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_CONTRACTIONHIERARCHIES_H */
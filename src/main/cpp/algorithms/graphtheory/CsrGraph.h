@@ -0,0 +1,380 @@
+/*
+ * @file   CsrGraph.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   An immutable graph stored in Compressed Sparse Row (CSR) format.
+ *
+ * The outgoing edges of node u are stored contiguously in the index range
+ * [offsets[u], offsets[u+1]) of the 'targets' and 'weights' arrays. Compared
+ * to the hash map based adjacency list of Graph, visiting the neighbours of
+ * a node is a linear scan over memory instead of a chain of pointer chases.
+ *
+ * The graph interface. The graph algorithms templated on a graph type GRAPH
+ * only use the read-only interface which Graph and CsrGraph both provide:
+ *   size()      - number of nodes, the node ids are in [0, size())
+ *   edgeCount() - number of directed edges
+ *   edges(u)    - range of (Node ID, Cost) pairs leaving node u, empty if u
+ *                 is not a node; its size() is the out degree of u
+ * so they run on either one, or on any other type with this interface.
+ *
+ * Construction Time Complexity: O(V + E)
+ */
+
+#ifndef D_GRAPH_CSRGRAPH_H
+#define D_GRAPH_CSRGRAPH_H
+
+#include <Graph.h>
+#include <ThreadPool.h>
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <atomic>
+
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace dsa {
+
+class CsrGraph
+{
+
+public:
+
+  // Forward iterator over the outgoing edges of a node. Dereferencing yields
+  // a (Node ID, Cost) pair, mirroring the element type of Graph::GRAPH_EDGE.
+  class EdgeIterator
+  {
+    const int *to_;
+    const double *cost_;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<int, double>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    EdgeIterator(const int *to, const double *cost) : to_(to), cost_(cost) {
+    }
+
+    value_type operator*() const {
+      return value_type(*to_, *cost_);
+    }
+
+    EdgeIterator& operator++() {
+      ++to_;
+      ++cost_;
+      return *this;
+    }
+
+    EdgeIterator operator++(int) {
+      EdgeIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const EdgeIterator& rhs) const {
+      return to_ == rhs.to_;
+    }
+
+    bool operator!=(const EdgeIterator& rhs) const {
+      return to_ != rhs.to_;
+    }
+  };
+
+
+  // The outgoing edges of a single node.
+  class EdgeRange
+  {
+    const int *to_;
+    const double *cost_;
+    unsigned size_;
+
+  public:
+    EdgeRange(const int *to, const double *cost, unsigned size) : to_(to), cost_(cost), size_(size) {
+    }
+
+    EdgeIterator begin() const {
+      return EdgeIterator(to_, cost_);
+    }
+
+    EdgeIterator end() const {
+      return EdgeIterator(to_ + size_, cost_ + size_);
+    }
+
+    unsigned size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+  };
+
+private:
+  unsigned n_;
+  std::vector<int> offsets_; // Size n + 1
+  std::vector<int> targets_; // Size E
+  std::vector<double> weights_; // Size E
+
+
+  void checkNode(int u) const {
+    if (u < 0 || (unsigned)u >= n_) throw std::invalid_argument("Invalid node index");
+  }
+
+public:
+  // Builds a CSR copy of an adjacency list graph. The edges of every node keep
+  // the iteration order of the source graph so traversals visit nodes in the
+  // same order on both representations. Node ids are expected in [0, size).
+  explicit CsrGraph(const Graph& graph) {
+    n_ = graph.size();
+    offsets_.resize(n_ + 1, 0);
+    for (unsigned u = 0; u < n_; u++)
+      offsets_[u + 1] = offsets_[u] + graph.edges(u).size();
+
+    targets_.reserve(offsets_[n_]);
+    weights_.reserve(offsets_[n_]);
+    for (unsigned u = 0; u < n_; u++) {
+      for (auto edge: graph.edges(u)) {
+        checkNode(edge.first);
+        targets_.push_back(edge.first);
+        weights_.push_back(edge.second);
+      }
+    }
+  }
+
+
+  // Builds a graph with n nodes from a list of directed edges. Parallel edges
+  // are kept and the edges of each node keep their relative input order.
+  CsrGraph(int n, const std::vector<Edge>& edges) {
+    if (n < 0) throw std::invalid_argument("n < 0");
+    n_ = n;
+    offsets_.resize(n_ + 1, 0);
+
+    // Counting sort of the edges by their source node.
+    for (const Edge& e: edges) {
+      checkNode(e.from_);
+      checkNode(e.to_);
+      offsets_[e.from_ + 1]++;
+    }
+    for (unsigned u = 0; u < n_; u++) offsets_[u + 1] += offsets_[u];
+
+    targets_.resize(edges.size());
+    weights_.resize(edges.size());
+    std::vector<int> pos(offsets_.begin(), offsets_.end() - 1);
+    for (const Edge& e: edges) {
+      int i = pos[e.from_]++;
+      targets_[i] = e.to_;
+      weights_[i] = e.cost_;
+    }
+  }
+
+
+  // Builds the reverse of 'graph' (every edge u -> v becomes v -> u), as
+  // needed by backward searches. GRAPH is Graph, CsrGraph or any type with
+  // the same read-only interface.
+  template <typename GRAPH>
+  static CsrGraph reverseOf(const GRAPH& graph) {
+    std::vector<Edge> edges;
+    edges.reserve(graph.edgeCount());
+    for (int u = 0; u < (int)graph.size(); u++)
+      for (auto edge: graph.edges(u))
+        edges.push_back({edge.first, u, edge.second});
+    return CsrGraph(graph.size(), edges);
+  }
+
+
+  // Builds the same reverse as reverseOf(graph) on the threads of 'pool'.
+  // Every thread counts the in edges coming from its own block of source
+  // nodes, a prefix sum over the nodes and then the blocks gives every
+  // thread its own slots, and the threads fill them in parallel. Needs O(V)
+  // extra memory per thread.
+  template <typename GRAPH>
+  static CsrGraph reverseOf(const GRAPH& graph, ThreadPool& pool) {
+    int n = graph.size(), blocks = pool.size();
+    auto block = [&](int b) { return (int)((long long)n * b / blocks); };
+    std::vector<std::vector<int>> slot(blocks);
+    std::atomic<bool> invalid(false);
+
+    pool.run([&](int b) {
+      std::vector<int>& count = slot[b];
+      count.assign(n, 0);
+      for (int u = block(b); u < block(b + 1); u++) {
+        for (auto edge: graph.edges(u)) {
+          if (edge.first < 0 || edge.first >= n) invalid.store(true, std::memory_order_relaxed);
+          else count[edge.first]++;
+        }
+      }
+    });
+    if (invalid.load()) throw std::invalid_argument("Invalid node index");
+
+    CsrGraph reverse(n, std::vector<Edge>());
+    std::vector<int>& offsets = reverse.offsets_;
+    pool.parallelFor(0, n, [&](int v, int) {
+      int total = 0;
+      for (int b = 0; b < blocks; b++) total += slot[b][v];
+      offsets[v + 1] = total;
+    }, 4096);
+    for (int v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+
+    // slot[b][v] becomes the first slot of block b among the in edges of v.
+    pool.parallelFor(0, n, [&](int v, int) {
+      int at = offsets[v];
+      for (int b = 0; b < blocks; b++) {
+        int count = slot[b][v];
+        slot[b][v] = at;
+        at += count;
+      }
+    }, 4096);
+
+    reverse.targets_.resize(offsets[n]);
+    reverse.weights_.resize(offsets[n]);
+    pool.run([&](int b) {
+      std::vector<int>& pos = slot[b];
+      for (int u = block(b); u < block(b + 1); u++) {
+        for (auto edge: graph.edges(u)) {
+          int i = pos[edge.first]++;
+          reverse.targets_[i] = u;
+          reverse.weights_[i] = edge.second;
+        }
+      }
+    });
+    return reverse;
+  }
+
+
+  // Builds the condensation of 'graph': one node per component where ids[u]
+  // in [0, count) is the component of node u, and an edge between two
+  // components for every pair connected by at least one edge of 'graph'. The
+  // cost of such an edge is the lowest cost among those edges.
+  template <typename GRAPH>
+  static CsrGraph condensationOf(const GRAPH& graph, const std::vector<int>& ids, int count) {
+    int n = graph.size();
+    if (ids.size() != (unsigned)n) throw std::invalid_argument("ids.size() != graph.size()");
+    if (count < 0) throw std::invalid_argument("count < 0");
+
+    // Nodes grouped by component with a counting sort.
+    std::vector<int> first(count + 1, 0), nodes(n);
+    for (int u = 0; u < n; u++) {
+      if (ids[u] < 0 || ids[u] >= count) throw std::invalid_argument("Invalid component id");
+      first[ids[u] + 1]++;
+    }
+    for (int c = 0; c < count; c++) first[c + 1] += first[c];
+    std::vector<int> pos(first.begin(), first.end() - 1);
+    for (int u = 0; u < n; u++) nodes[pos[ids[u]]++] = u;
+
+    // last[d] is the last component with an edge to d and at[d] that edge.
+    std::vector<Edge> edges;
+    std::vector<int> last(count, -1), at(count);
+    for (int c = 0; c < count; c++) {
+      for (int i = first[c]; i < first[c + 1]; i++) {
+        for (auto edge: graph.edges(nodes[i])) {
+          int d = ids[edge.first];
+          if (d == c) continue;
+          if (last[d] != c) {
+            last[d] = c;
+            at[d] = edges.size();
+            edges.push_back({c, d, edge.second});
+          } else {
+            edges[at[d]].cost_ = std::min(edges[at[d]].cost_, (double)edge.second);
+          }
+        }
+      }
+    }
+    return CsrGraph(count, edges);
+  }
+
+
+  // Get size of graph
+  unsigned int size() const {
+    return n_;
+  }
+
+
+  // Get number of edges
+  unsigned int edgeCount() const {
+    return targets_.size();
+  }
+
+
+  // Get the outgoing edges of node 'u'. An empty range is returned if 'u'
+  // is not part of the graph.
+  EdgeRange edges(int u) const {
+    if (u < 0 || (unsigned)u >= n_) return EdgeRange(nullptr, nullptr, 0);
+    int from = offsets_[u];
+    return EdgeRange(targets_.data() + from, weights_.data() + from, offsets_[u + 1] - from);
+  }
+
+
+  // Get the number of edges leaving node 'u'.
+  int degree(int u) const {
+    checkNode(u);
+    return offsets_[u + 1] - offsets_[u];
+  }
+
+
+  // Raw CSR arrays.
+  const std::vector<int>& offsets() const {
+    return offsets_;
+  }
+
+  const std::vector<int>& targets() const {
+    return targets_;
+  }
+
+  const std::vector<double>& weights() const {
+    return weights_;
+  }
+
+
+  std::string toString() const {
+    std::stringstream os;
+    os << "CsrGraph[" << std::endl;
+    for (unsigned u = 0; u < n_; u++) {
+      os << " Node(" << u << ")[";
+      for (auto edge: edges(u)) {
+        os << "Edge(" << "->" << edge.first << ",cost:" << edge.second << ")";
+        os << ",";
+      }
+      os << "]" << std::endl;
+    }
+    os << "]";
+
+    return os.str();
+  }
+
+
+  friend std::ostream& operator<<(std::ostream &strm, const CsrGraph &g) {
+    return strm << g.toString();
+  }
+
+};
+
+
+
+// Example usage of CsrGraph
+int CsrGraph_test()
+{
+  Graph graph(4);
+  graph.addDirectedEdge(0, 1, 1.5);
+  graph.addDirectedEdge(0, 2, 2.5);
+  graph.addDirectedEdge(2, 3, 0.5);
+
+  CsrGraph csr(graph);
+  std::cout << csr << std::endl;
+
+  std::vector<Edge> edges{{0, 1, 1.5}, {0, 2, 2.5}, {2, 3, 0.5}};
+  CsrGraph csr2(4, edges);
+  std::cout << "Node 0 has " << csr2.degree(0) << " outgoing edges" << std::endl;
+  // Prints:
+  // Node 0 has 2 outgoing edges
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_CSRGRAPH_H */
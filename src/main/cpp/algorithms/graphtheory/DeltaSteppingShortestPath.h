@@ -0,0 +1,439 @@
+/*
+ * @file   DeltaSteppingShortestPath.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Parallel single source shortest paths with delta-stepping.
+ *
+ * Meyer and Sanders, "Delta-stepping: a parallelizable shortest path algorithm", 2003.
+ *
+ * Dijkstra settles one node at a time. Delta-stepping keeps the tentative distances in buckets
+ * of width delta, bucket i holding the nodes with a distance in [i * delta, (i + 1) * delta),
+ * and settles a whole bucket at once. An edge is light if its cost is at most delta and heavy
+ * otherwise. Relaxing a light edge can put a node back into the current bucket, a heavy edge
+ * always leads to a later bucket:
+ *
+ * function deltaStepping(s):
+ *   relax(s, 0)
+ *   for i = first non empty bucket, while there is one:
+ *     S = {}
+ *     while B[i] is not empty:            # light phases
+ *       R = B[i], B[i] = {}
+ *       parallel for u in R: relax the light edges of u
+ *       S = S + R
+ *     parallel for u in S: relax the heavy edges of u
+ *
+ * relax(v, d) lowers dist[v] to d and moves v to the bucket of d. Each thread collects the
+ * nodes it relaxes in buckets of its own which are merged when a bucket is taken, and a node
+ * left behind in an older bucket is skipped if its distance now falls into another one. The
+ * distance and the predecessor of a node are updated together under a per node lock.
+ *
+ * A relaxation from bucket i leads at most ceil(maxCost / delta) buckets further, so the
+ * buckets [i, i + slots) are kept in a cyclic array of slots. The number of slots is capped,
+ * and the few buckets beyond the window, only possible with a very small delta, wait in an
+ * ordered map until the window reaches them. The memory does not grow with dist / delta.
+ *
+ * A small delta settles few nodes per phase and is close to Dijkstra, a large delta needs
+ * many light phases to converge and is close to Bellman-Ford. The default delta is the
+ * largest edge cost divided by the average out degree, as suggested for random weights.
+ * Edge costs must not be negative.
+ */
+
+#ifndef D_GRAPH_DELTASTEPPINGSHORTESTPATH_H
+#define D_GRAPH_DELTASTEPPINGSHORTESTPATH_H
+
+#include <Graph.h>
+#include <ThreadPool.h>
+
+#include <vector>
+#include <list>
+#include <map>
+#include <algorithm>
+
+#include <memory>
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+namespace dsa {
+
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicDeltaSteppingShortestPath {
+private:
+  static constexpr int GRAIN = 64;
+  static constexpr size_t MAX_SLOTS = 4096;
+  // 2^64, the first index beyond unsigned long long.
+  static constexpr double BUCKET_LIMIT = 18446744073709551616.0;
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // Buckets and settled nodes of one thread. Bucket current_ + i is in slot
+  // (currentSlot_ + i) % slots_ of 'buckets' for i < slots_, the later ones
+  // are in 'far'.
+  struct Buckets {
+    std::vector<std::vector<int>> buckets;
+    std::map<unsigned long long, std::vector<int>> far;
+    std::vector<int> nodes;
+  };
+  using Buffer = PerThread<Buckets>;
+
+  const GRAPH *graph_;
+  int N_, numThreads_;
+  double delta_, maxCost_;
+  size_t slots_, currentSlot_;
+  unsigned long long current_;
+
+  // Copy of the edges, the edges out of u are [offsets_[u], offsets_[u + 1])
+  // with the light ones before lightEnd_[u].
+  std::vector<int> offsets_, lightEnd_, to_;
+  std::vector<double> cost_;
+
+  std::unique_ptr<ThreadPool> pool_;
+  std::vector<Buffer> buffers_;
+  std::vector<std::atomic<double>> tentative_;
+  std::vector<std::atomic<unsigned char>> lock_;
+  std::vector<std::atomic<unsigned>> settledIn_;
+  std::vector<int> frontier_, settled_;
+
+  // Result of the last solve().
+  int start_;
+  std::vector<double> dist_;
+  std::vector<int> prev_;
+  int buckets_, phases_;
+
+
+  void checkNode(int node) const {
+    if (node < 0 || node >= N_) throw std::invalid_argument("Invalid node index");
+  }
+
+
+  // The index of the bucket of 'dist'. With a small delta the index can
+  // exceed the integer range, such distances share the last bucket which is
+  // then settled over several rounds.
+  unsigned long long bucketOf(double dist) const {
+    double bucket = dist / delta_;
+    return bucket < BUCKET_LIMIT ? (unsigned long long)bucket : std::numeric_limits<unsigned long long>::max();
+  }
+
+
+  // Orders the edges of every node light first.
+  void split() {
+    for (int u = 0; u < N_; u++) {
+      int light = offsets_[u];
+      for (int e = offsets_[u]; e < offsets_[u + 1]; e++) {
+        if (cost_[e] > delta_) continue;
+        std::swap(to_[e], to_[light]);
+        std::swap(cost_[e], cost_[light]);
+        light++;
+      }
+      lightEnd_[u] = light;
+    }
+  }
+
+
+  // Lowers the distance of 'v' to 'dist' through 'u' and puts 'v' in the
+  // matching bucket of 'threadId'.
+  void relax(int u, int v, double dist, int threadId) {
+    while (lock_[v].exchange(1, std::memory_order_acquire)) std::this_thread::yield();
+    bool lower = dist < tentative_[v].load(std::memory_order_relaxed);
+    if (lower) {
+      tentative_[v].store(dist, std::memory_order_relaxed);
+      prev_[v] = u;
+    }
+    lock_[v].store(0, std::memory_order_release);
+
+    if (lower) {
+      Buffer& buffer = buffers_[threadId];
+      unsigned long long bucket = bucketOf(dist), offset = bucket - current_;
+      if (offset < slots_) {
+        size_t slot = currentSlot_ + offset;
+        buffer.buckets[slot < slots_ ? slot : slot - slots_].push_back(v);
+      } else {
+        buffer.far[bucket].push_back(v);
+      }
+    }
+  }
+
+
+  void relaxEdges(int u, int begin, int end, int threadId) {
+    double du = tentative_[u].load(std::memory_order_relaxed);
+    // Most edges do not improve anything, they are rejected here without a
+    // call or the lock.
+    for (int e = begin; e < end; e++) {
+      int v = to_[e];
+      double dist = du + cost_[e];
+      if (dist < tentative_[v].load(std::memory_order_relaxed)) relax(u, v, dist, threadId);
+    }
+  }
+
+
+  // Moves the buckets of 'far' which the window now reaches into their slots.
+  void fill() {
+    for (auto& buffer : buffers_) {
+      while (!buffer.far.empty() && buffer.far.begin()->first - current_ < slots_) {
+        auto it = buffer.far.begin();
+        auto& slot = buffer.buckets[(currentSlot_ + (it->first - current_)) % slots_];
+        slot.insert(slot.end(), it->second.begin(), it->second.end());
+        buffer.far.erase(it);
+      }
+    }
+  }
+
+
+  // Moves the window to the lowest non empty bucket. Returns false if all
+  // buckets are empty.
+  bool nextBucket() {
+    for (size_t i = 0; i < slots_; i++) {
+      size_t slot = (currentSlot_ + i) % slots_;
+      for (auto& buffer : buffers_) {
+        if (buffer.buckets[slot].empty()) continue;
+        current_ += i;
+        currentSlot_ = slot;
+        fill();
+        return true;
+      }
+    }
+
+    // The window is empty, jump to the lowest bucket of 'far'.
+    bool found = false;
+    for (auto& buffer : buffers_) {
+      if (buffer.far.empty()) continue;
+      unsigned long long first = buffer.far.begin()->first;
+      if (!found || first < current_) current_ = first;
+      found = true;
+    }
+    if (found) fill();
+    return found;
+  }
+
+
+  // Moves the current bucket of every thread into 'nodes'.
+  void take(std::vector<int>& nodes) {
+    nodes.clear();
+    for (auto& buffer : buffers_) {
+      auto& bucket = buffer.buckets[currentSlot_];
+      nodes.insert(nodes.end(), bucket.begin(), bucket.end());
+      bucket.clear();
+    }
+  }
+
+
+  void deltaStepping(int start) {
+    if (!pool_) pool_ = std::make_unique<ThreadPool>(numThreads_);
+    for (int u = 0; u < N_; u++) {
+      tentative_[u].store(inf, std::memory_order_relaxed);
+      settledIn_[u].store(0, std::memory_order_relaxed);
+    }
+    prev_.assign(N_, -1);
+    for (auto& buffer : buffers_) {
+      buffer.buckets.assign(slots_, std::vector<int>());
+      buffer.far.clear();
+    }
+    current_ = 0;
+    currentSlot_ = 0;
+    buckets_ = phases_ = 0;
+
+    relax(-1, start, 0.0, 0);
+    while (nextBucket()) {
+      // 'stamp' marks the nodes settled in this bucket, each of them relaxes
+      // its heavy edges once.
+      unsigned stamp = ++buckets_;
+      for (auto& buffer : buffers_) buffer.nodes.clear();
+
+      for (take(frontier_); !frontier_.empty(); take(frontier_)) {
+        phases_++;
+        pool_->parallelFor(0, frontier_.size(), [&](int i, int threadId) {
+          int u = frontier_[i];
+          // Stale entry, u has moved to another bucket since.
+          if (bucketOf(tentative_[u].load(std::memory_order_relaxed)) != current_) return;
+          if (settledIn_[u].exchange(stamp, std::memory_order_relaxed) != stamp)
+            buffers_[threadId].nodes.push_back(u);
+          relaxEdges(u, offsets_[u], lightEnd_[u], threadId);
+        }, GRAIN);
+      }
+
+      settled_.clear();
+      for (auto& buffer : buffers_) settled_.insert(settled_.end(), buffer.nodes.begin(), buffer.nodes.end());
+      pool_->parallelFor(0, settled_.size(), [&](int i, int threadId) {
+        int u = settled_[i];
+        relaxEdges(u, lightEnd_[u], offsets_[u + 1], threadId);
+      }, GRAIN);
+    }
+
+    dist_.resize(N_);
+    for (int u = 0; u < N_; u++) dist_[u] = tentative_[u].load(std::memory_order_relaxed);
+    start_ = start;
+  }
+
+public:
+  // Initialize the solver with the graph to query. 'delta' is the bucket
+  // width, 0 picks the largest edge cost divided by the average out degree.
+  BasicDeltaSteppingShortestPath(const GRAPH *graph, double delta = 0, int numThreads = ThreadPool::hardwareThreads()) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    if (numThreads < 1) throw std::invalid_argument("numThreads < 1");
+    graph_ = graph;
+    N_ = graph->size();
+    numThreads_ = numThreads;
+    start_ = -1;
+    buckets_ = phases_ = 0;
+    current_ = 0;
+    currentSlot_ = 0;
+
+    offsets_.assign(N_ + 1, 0);
+    lightEnd_.assign(N_, 0);
+    maxCost_ = 0;
+    for (int u = 0; u < N_; u++) {
+      for (auto edge: graph->edges(u)) {
+        if (edge.second < 0) throw std::invalid_argument("Negative edge cost");
+        to_.push_back(edge.first);
+        cost_.push_back(edge.second);
+        maxCost_ = std::max(maxCost_, edge.second);
+      }
+      offsets_[u + 1] = to_.size();
+    }
+
+    buffers_.resize(numThreads);
+    tentative_ = std::vector<std::atomic<double>>(N_);
+    lock_ = std::vector<std::atomic<unsigned char>>(N_);
+    settledIn_ = std::vector<std::atomic<unsigned>>(N_);
+    for (int u = 0; u < N_; u++) lock_[u].store(0, std::memory_order_relaxed);
+    setDelta(delta);
+  }
+
+
+  BasicDeltaSteppingShortestPath(const BasicDeltaSteppingShortestPath&) = delete;
+  BasicDeltaSteppingShortestPath& operator=(BasicDeltaSteppingShortestPath const&) = delete;
+
+  // The graph the solver runs on.
+  const GRAPH& operator()() {
+    return *graph_;
+  }
+
+
+  // Sets the bucket width, 0 picks the default.
+  void setDelta(double delta) {
+    if (delta < 0) throw std::invalid_argument("delta < 0");
+    if (delta == 0) {
+      double degree = N_ == 0 ? 1 : std::max(1.0, (double)to_.size() / N_);
+      delta = maxCost_ > 0 ? maxCost_ / degree : 1;
+    }
+    delta_ = delta;
+    // Bucket i + slots_ - 1 is the furthest one reached from bucket i, one
+    // more slot absorbs rounding.
+    double window = std::ceil(maxCost_ / delta_) + 2;
+    slots_ = window < MAX_SLOTS ? (size_t)window : (size_t)MAX_SLOTS;
+    split();
+  }
+
+
+  double delta() const {
+    return delta_;
+  }
+
+
+  // Computes the shortest paths from 'start' to every node.
+  void solve(int start) {
+    checkNode(start);
+    deltaStepping(start);
+  }
+
+
+  // Solves 'start' and returns the distance to every node, infinity for the
+  // unreachable ones.
+  const std::vector<double>& getShortestPaths(int start) {
+    solve(start);
+    return dist_;
+  }
+
+
+  // Returns the cost of the shortest path from 'start' to 'end', or infinity
+  // if 'end' is unreachable.
+  double shortestPath(int start, int end) {
+    checkNode(end);
+    solve(start);
+    return dist_[end];
+  }
+
+
+  // The distance to 'node' found by the last solve().
+  double getDistance(int node) const {
+    checkNode(node);
+    return start_ == -1 ? inf : dist_[node];
+  }
+
+
+  // The predecessor of 'node' in the last solve(), -1 if there is none.
+  int getPrev(int node) const {
+    checkNode(node);
+    return start_ == -1 ? -1 : prev_[node];
+  }
+
+
+  // Number of non empty buckets and of light phases of the last solve().
+  int buckets() const {
+    return buckets_;
+  }
+
+  int phases() const {
+    return phases_;
+  }
+
+
+  // Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive.
+  //
+  // @return An array of node indexes of the shortest path from 'start' to 'end'. If 'start' and
+  //     'end' are not connected then an empty array is returned.
+  //
+  std::list<int> reconstructPath(int start, int end) {
+    double dist = shortestPath(start, end);
+    std::list<int> path;
+    if (dist == inf) return path;
+    for (int at = end; at != -1; at = prev_[at])
+      path.push_front(at);
+    return path;
+  }
+
+};
+
+using DeltaSteppingShortestPath = BasicDeltaSteppingShortestPath<Graph>;
+
+
+
+// Example usage of DeltaSteppingShortestPath
+int DeltaSteppingShortestPath_test()
+{
+  Graph graph(8);
+
+  graph.addDirectedEdge(6, 0, 1.1);
+  graph.addDirectedEdge(6, 2, 0.2);
+  graph.addDirectedEdge(3, 4, 3.6);
+  graph.addDirectedEdge(6, 4, 0.4);
+  graph.addDirectedEdge(2, 0, 0.7);
+  graph.addDirectedEdge(0, 1, 3.4);
+  graph.addDirectedEdge(4, 5, 6.9);
+  graph.addDirectedEdge(5, 6, 0.9);
+  graph.addDirectedEdge(3, 7, 8.2);
+  graph.addDirectedEdge(7, 5, 0.3);
+  graph.addDirectedEdge(1, 2, 4.6);
+  graph.addDirectedEdge(7, 3, 6.4);
+  graph.addDirectedEdge(5, 0, 10.1);
+
+  DeltaSteppingShortestPath solver(&graph, 1.0, 2);
+
+  int start = 3, end = 0;
+  std::list<int> path = solver.reconstructPath(start, end);
+
+  std::cout << "Delta-stepping from " << start << " to " << end << ": [";
+  for (auto node: path) std::cout << node << ",";
+  std::cout << "] cost " << solver.getDistance(end) << std::endl;
+  // Prints:
+  // Delta-stepping from 3 to 0: [3,7,5,6,2,0,] cost 10.3
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_DELTASTEPPINGSHORTESTPATH_H */
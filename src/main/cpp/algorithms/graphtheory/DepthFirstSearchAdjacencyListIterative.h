@@ -47,24 +47,26 @@
 
 namespace dsa {
 
-class DepthFirstSearchAdjacencyListIterative
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicDepthFirstSearchAdjacencyListIterative
 {
 
 private:
-  Graph *graph_;
+  const GRAPH *graph_;
   unsigned n_;
 
 public:
-  DepthFirstSearchAdjacencyListIterative(Graph *graph) {
+  BasicDepthFirstSearchAdjacencyListIterative(const GRAPH *graph) {
     if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
 	n_ = graph->size();
     graph_ = graph;
   }
 
-  DepthFirstSearchAdjacencyListIterative(const DepthFirstSearchAdjacencyListIterative&) = delete;
-  DepthFirstSearchAdjacencyListIterative& operator=(DepthFirstSearchAdjacencyListIterative const&) = delete;
+  BasicDepthFirstSearchAdjacencyListIterative(const BasicDepthFirstSearchAdjacencyListIterative&) = delete;
+  BasicDepthFirstSearchAdjacencyListIterative& operator=(BasicDepthFirstSearchAdjacencyListIterative const&) = delete;
 
-  const Graph& operator()() {
+  const GRAPH& operator()() {
     return *graph_;
   }
 
@@ -95,23 +97,14 @@ public:
         count++;
         visited[node] = true;
         std::cout << "DFS visiting node: " <<  node << std::endl;
-        auto graphItr = (*graph_)()->find(node);
-        if (graphItr != (*graph_)()->end()) {
-          std::cout << "  is in graph map" <<  std::endl;
-          if (!graphItr->second.empty()){
-            for (auto edge: graphItr->second){
-              if (!visited[edge.first]) {
-                stack_.push(edge.first);
-                std::cout << "    visiting edge: " <<  graphItr->first << " -> " << edge.first << std::endl;
-              }
-              else{
-                std::cout << "    already visited edge: " <<  graphItr->first << " -> " << edge.first << std::endl;
-              }
-            }
+        for (auto edge: graph_->edges(node)) {
+          if (!visited[edge.first]) {
+            stack_.push(edge.first);
+            std::cout << "    visiting edge: " <<  node << " -> " << edge.first << std::endl;
+          }
+          else{
+            std::cout << "    already visited edge: " <<  node << " -> " << edge.first << std::endl;
           }
-        }
-        else {
-          std::cout << "  is not in graph map" <<  std::endl;
         }
       }
     }
@@ -122,6 +115,8 @@ public:
   }
 };
 
+using DepthFirstSearchAdjacencyListIterative = BasicDepthFirstSearchAdjacencyListIterative<Graph>;
+
 
 
 // Example usage of DFS
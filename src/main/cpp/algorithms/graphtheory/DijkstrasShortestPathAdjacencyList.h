@@ -171,7 +171,9 @@ typedef std::priority_queue<Node, std::vector<Node>, nodeComparison> nodepq_type
 using NODE_PQ = std::priority_queue<Node, std::vector<Node>, nodeComparison>;
 
 
-class DijkstrasShortestPathAdjacencyList {
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicDijkstrasShortestPathAdjacencyList {
 private:
   const double inf = std::numeric_limits<double>::infinity();
   const double negInf = -std::numeric_limits<double>::infinity();
@@ -179,7 +181,7 @@ private:
   int N_;
   std::vector<double> dist_;
   std::vector<int> prev_;
-  Graph *graph_;
+  const GRAPH *graph_;
 
   // Run Dijkstra's algorithm on a directed graph to find the shortest path
   // from a starting node to an ending node. If there is no path between the
@@ -187,17 +189,19 @@ private:
   // Double.POSITIVE_INFINITY.
   double dijkstra(int start, int end) {
     // Maintain an array of the minimum distance to each node
-    dist_.resize(N_, inf);
+    dist_.assign(N_, inf);
     dist_[start] = 0;
 
     // Keep a priority queue of the next most promising node to visit.
-    NODE_PQ pq;
+    // std::priority_queue keeps the largest element on top, reverse the
+    // comparison to poll the node with the smallest distance first.
+    NODE_PQ pq(nodeComparison(true));
     pq.push(Node(start, 0));
 
     // Array used to track which nodes have already been visited.
     std::vector<bool> visited;
     visited.resize(N_, false);
-    prev_.resize(N_, -1);
+    prev_.assign(N_, -1);
 
     while (!pq.empty()) {
       Node node = pq.top();
@@ -208,22 +212,17 @@ private:
       // processing this node so we can ignore it.
       if (dist_[node.id_] < node.value_) continue;
 
-      auto graphItr = (*graph_)()->find(node.id_);
-      if (graphItr != (*graph_)()->end()) {
-        if (!graphItr->second.empty()) {
-          for (auto edge: graphItr->second) {
-            // You cannot get a shorter path by revisiting
-            // a node you have already visited before.
-            if (visited[edge.first]) continue;
-
-            // Relax edge by updating minimum cost if applicable.
-            double newDist = dist_[graphItr->first] + edge.second;
-            if (newDist < dist_[edge.first]) {
-              prev_[edge.first] = graphItr->first;
-              dist_[edge.first] = newDist;
-              pq.push(Node(edge.first, dist_[edge.first]));
-            }
-          }
+      for (auto edge: graph_->edges(node.id_)) {
+        // You cannot get a shorter path by revisiting
+        // a node you have already visited before.
+        if (visited[edge.first]) continue;
+
+        // Relax edge by updating minimum cost if applicable.
+        double newDist = dist_[node.id_] + edge.second;
+        if (newDist < dist_[edge.first]) {
+          prev_[edge.first] = node.id_;
+          dist_[edge.first] = newDist;
+          pq.push(Node(edge.first, dist_[edge.first]));
         }
       }
 
@@ -243,18 +242,18 @@ private:
   // @param n - The number of nodes in the graph.
   //
 public:
-  DijkstrasShortestPathAdjacencyList(Graph *graph) {
+  BasicDijkstrasShortestPathAdjacencyList(const GRAPH *graph) {
     if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
     N_ = graph->size();
     graph_ = graph;
   }
 
-  DijkstrasShortestPathAdjacencyList(const DijkstrasShortestPathAdjacencyList&) = delete;
-  DijkstrasShortestPathAdjacencyList& operator=(DijkstrasShortestPathAdjacencyList const&) = delete;
+  BasicDijkstrasShortestPathAdjacencyList(const BasicDijkstrasShortestPathAdjacencyList&) = delete;
+  BasicDijkstrasShortestPathAdjacencyList& operator=(BasicDijkstrasShortestPathAdjacencyList const&) = delete;
 
   // Use {@link #addEdge} method to add edges to the graph and use this method
   // to retrieve the constructed graph.
-  const Graph& operator()() {
+  const GRAPH& operator()() {
     return *graph_;
   }
 
@@ -279,6 +278,8 @@ public:
 
 };
 
+using DijkstrasShortestPathAdjacencyList = BasicDijkstrasShortestPathAdjacencyList<Graph>;
+
 
 
 // Example usage of DijkstrasShortestPath
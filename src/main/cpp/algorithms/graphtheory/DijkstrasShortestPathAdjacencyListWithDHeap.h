@@ -16,6 +16,15 @@ in O(log(n)) than it is to update an existing key's
 value in O(n). It is inefficient for dense graphs.
 The eager version avoids duplicate key-value pairs by
 using an Indexed Priority Queue (IPQ).
+
+The solver is meant to be reused for many queries on the same graph: the
+heap and the distance arrays are allocated once. Instead of resetting the
+arrays before every query, each entry carries the number of the query
+(epoch) which last wrote it, entries of older epochs read as unvisited.
+A query therefore only costs time proportional to the part of the graph it
+explores. The arity D of the heap can be chosen per solver: a larger D
+makes decrease-key cheaper (fewer levels to swim up) and polls more
+expensive (D children to scan on the way down).
  */
 #ifndef D_GRAPH_DIJKSTRASHORTESTPATHDHEAP_H
 #define D_GRAPH_DIJKSTRASHORTESTPATHDHEAP_H
@@ -103,19 +112,32 @@ public:
   ~MinIndexedDHeap() {
   }
 
-  int size() {
+  int size() const {
     return sz_;
   }
 
-  bool isEmpty() {
+  int degree() const {
+    return D_;
+  }
+
+  bool isEmpty() const {
     return sz_ == 0;
   }
 
-  bool contains(int ki) {
+  bool contains(int ki) const {
     keyInBoundsOrThrow(ki);
     return pm_[ki] != -1;
   }
 
+  // Removes all keys in O(size) time.
+  void clear() {
+    for (int i = 0; i < sz_; i++) {
+      pm_[im_[i]] = -1;
+      im_[i] = -1;
+    }
+    sz_ = 0;
+  }
+
   int peekMinKeyIndex() {
     isNotEmptyOrThrow();
     return im_[0];
@@ -139,7 +161,7 @@ public:
   }
 
   void insert(int ki, T value) {
-    if (contains(ki)) throw std::invalid_argument("index already exists; received: " + ki);
+    if (contains(ki)) throw std::invalid_argument("index already exists; received: " + std::to_string(ki));
     valueNotNullOrThrow(value);
     pm_[ki] = sz_;
     im_[sz_] = ki;
@@ -203,7 +225,7 @@ public:
   }
 
   void swim(int i) {
-    while (i < parent_[i]) {
+    while (i > 0 && less(i, parent_[i])) {
       swap(i, parent_[i]);
       i = parent_[i];
     }
@@ -212,7 +234,7 @@ public:
   // From the parent node at index i find the minimum child below it
   int minChild(int i) {
     int index = -1, from = child_[i], to = std::min(sz_, from + D_);
-    for (int j = from; j < to; j++) if (j < i) index = i = j;
+    for (int j = from; j < to; j++) if (less(j, i)) index = i = j;
     return index;
   }
 
@@ -249,22 +271,24 @@ public:
   }
 
   void keyExistsOrThrow(int ki) {
-    if (!contains(ki)) throw std::out_of_range("Index does not exist; received: " + ki);
+    if (!contains(ki)) throw std::out_of_range("Index does not exist; received: " + std::to_string(ki));
   }
 
   void valueNotNullOrThrow(T value) {
   // if (value == nullptr) throw std::invalid_argument("value cannot be null");
   }
 
-  void keyInBoundsOrThrow(int ki) {
+  void keyInBoundsOrThrow(int ki) const {
     if (ki < 0 || ki >= N_)
-      throw std::invalid_argument("Key index out of bounds; received: " + ki);
+      throw std::invalid_argument("Key index out of bounds; received: " + std::to_string(ki));
   }
 };
 
 
 
-class DijkstrasShortestPathAdjacencyListWithDHeap {
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicDijkstrasShortestPathAdjacencyListWithDHeap {
 private:
   const double inf = std::numeric_limits<double>::infinity();
 
@@ -272,62 +296,75 @@ private:
   int edgeCount_;
   std::vector<double> dist_;
   std::vector<int> prev_;
-  Graph *graph_;
+  const GRAPH *graph_;
+
+  // Indexed Priority Queue (ipq) of the next most promising nodes to visit,
+  // kept across queries.
+  std::unique_ptr<MinIndexedDHeap<double>> ipq_;
+
+  // dist_[i] and prev_[i] are only valid if stamp_[i] == epoch_, node i is
+  // settled (visited) if settled_[i] == epoch_.
+  std::vector<unsigned> stamp_, settled_;
+  unsigned epoch_;
+  int settledCount_;
+
+
+  // Starts a new query by invalidating the results of the previous one.
+  void newEpoch() {
+    ipq_->clear();
+    settledCount_ = 0;
+    if (++epoch_ == 0) {
+      // The counter wrapped around, entries from 2^32 queries ago would
+      // look valid again.
+      std::fill(stamp_.begin(), stamp_.end(), 0);
+      std::fill(settled_.begin(), settled_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+
+  void checkNode(int node) const {
+    if (node < 0 || node >= N_) throw std::invalid_argument("Invalid node index");
+  }
+
 
   // Run Dijkstra's algorithm on a directed graph to find the shortest path
   // from a starting node to an ending node. If there is no path between the
   // starting node and the destination node the returned value is set to be
-  // Double.POSITIVE_INFINITY.
+  // Double.POSITIVE_INFINITY. With end == -1 every reachable node is settled.
   double dijkstra(int start, int end) {
+    newEpoch();
 
-    // Keep an Indexed Priority Queue (ipq) of the next most promising node
-    // to visit.
-    int degree = edgeCount_ / N_;
- //    std::unique_ptr<MinIndexedDHeap> ipq{ new MinIndexedDHeap<double>(degree, N_) };
-    std::unique_ptr<MinIndexedDHeap<double>> ipq = std::make_unique<MinIndexedDHeap<double>>(degree, N_);
-
-//    MinIndexedDHeap<double> ipq (degree, N_);
-
-    ipq->insert(start, 0.0);
-
-    // Maintain an array of the minimum distance to each node.
-    dist_.resize(N_, inf);
+    stamp_[start] = epoch_;
     dist_[start] = 0;
-
-    std::vector<bool> visited;
-    visited.resize(N_, false);
-    prev_.resize(N_, -1);
-
-    while (!ipq->isEmpty()) {
-      int nodeId = ipq->peekMinKeyIndex();
-
-      visited[nodeId] = true;
-      double minValue = ipq->pollMinValue();
-
-      // We already found a better path before we got to
-      // processing this node so we can ignore it.
-      if (minValue > dist_[nodeId]) continue;
-
-      auto graphItr = (*graph_)()->find(nodeId);
-      if (graphItr != (*graph_)()->end()) {
-        if (!graphItr->second.empty()) {
-          for (auto edge: graphItr->second) {
-
-            // We cannot get a shorter path by revisiting
-            // a node we have already visited before.
-            if (visited[edge.first]) continue;
-
-            // Relax edge by updating minimum cost if applicable.
-            double newDist = dist_[nodeId] + edge.second;
-            if (newDist < dist_[edge.first]) {
-              prev_[edge.first] = nodeId;
-              dist_[edge.first] = newDist;
-              // Insert the cost of going to a node for the first time in the PQ,
-              // or try and update it to a better value by calling decrease.
-              if (!ipq->contains(edge.first)) ipq->insert(edge.first, newDist);
-              else ipq->decrease(edge.first, newDist);
-            }
-          }
+    prev_[start] = -1;
+    ipq_->insert(start, 0.0);
+
+    while (!ipq_->isEmpty()) {
+      int nodeId = ipq_->pollMinKeyIndex();
+      settled_[nodeId] = epoch_;
+      settledCount_++;
+
+      for (auto edge: graph_->edges(nodeId)) {
+        int to = edge.first;
+
+        // We cannot get a shorter path by revisiting
+        // a node we have already visited before.
+        if (settled_[to] == epoch_) continue;
+
+        // Relax edge by updating minimum cost if applicable.
+        double newDist = dist_[nodeId] + edge.second;
+        if (stamp_[to] != epoch_) {
+          // Insert the cost of going to a node for the first time in the PQ.
+          stamp_[to] = epoch_;
+          dist_[to] = newDist;
+          prev_[to] = nodeId;
+          ipq_->insert(to, newDist);
+        } else if (newDist < dist_[to]) {
+          // Or try and update it to a better value by calling decrease.
+          dist_[to] = newDist;
+          prev_[to] = nodeId;
+          ipq_->decrease(to, newDist);
         }
       }
 
@@ -342,50 +379,109 @@ private:
   }
 
 
-  // Initialize the solver by providing the graph size and a starting node. Use the {@link #addEdge}
-  // method to actually add edges to the graph.
-  //
-  // @param n - The number of nodes in the graph.
+  // Initialize the solver with the graph to query. 'degree' is the arity of
+  // the heap, 0 picks the average out degree of the graph (at least 2).
   //
 public:
-  DijkstrasShortestPathAdjacencyListWithDHeap(Graph *graph) {
+  BasicDijkstrasShortestPathAdjacencyListWithDHeap(const GRAPH *graph, int degree = 0) {
     if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    if (degree < 0) throw std::invalid_argument("degree < 0");
     N_ = graph->size();
     edgeCount_ = graph->edgeCount();
     graph_ = graph;
+
+    if (degree == 0) degree = N_ == 0 ? 2 : edgeCount_ / N_;
+    ipq_ = std::make_unique<MinIndexedDHeap<double>>(degree, std::max(1, N_));
+
+    dist_.resize(N_, inf);
+    prev_.resize(N_, -1);
+    stamp_.resize(N_, 0);
+    settled_.resize(N_, 0);
+    epoch_ = 0;
+    settledCount_ = 0;
   }
 
 
-  DijkstrasShortestPathAdjacencyListWithDHeap(const DijkstrasShortestPathAdjacencyListWithDHeap&) = delete;
-  DijkstrasShortestPathAdjacencyListWithDHeap& operator=(DijkstrasShortestPathAdjacencyListWithDHeap const&) = delete;
+  BasicDijkstrasShortestPathAdjacencyListWithDHeap(const BasicDijkstrasShortestPathAdjacencyListWithDHeap&) = delete;
+  BasicDijkstrasShortestPathAdjacencyListWithDHeap& operator=(BasicDijkstrasShortestPathAdjacencyListWithDHeap const&) = delete;
 
   // Use {@link #addEdge} method to add edges to the graph and use this method to retrieve the
   // constructed graph.
   //
-  const Graph& operator()() {
+  const GRAPH& operator()() {
     return *graph_;
   }
 
 
+  // The arity of the heap.
+  int degree() const {
+    return ipq_->degree();
+  }
+
+
+  // Returns the cost of the shortest path from 'start' to 'end', or infinity
+  // if 'end' is unreachable. The search stops as soon as 'end' is settled.
+  double shortestPath(int start, int end) {
+    checkNode(start);
+    checkNode(end);
+    return dijkstra(start, end);
+  }
+
+
+  // Settles every node reachable from 'start', afterwards getDistance() and
+  // getPrev() hold the shortest path tree of 'start'.
+  void solve(int start) {
+    checkNode(start);
+    dijkstra(start, -1);
+  }
+
+
+  // The distance to 'node' found by the last query. It is final for settled
+  // nodes and infinity for nodes the query did not reach.
+  double getDistance(int node) const {
+    checkNode(node);
+    return stamp_[node] == epoch_ ? dist_[node] : inf;
+  }
+
+
+  // The predecessor of 'node' in the last query, -1 if there is none.
+  int getPrev(int node) const {
+    checkNode(node);
+    return stamp_[node] == epoch_ ? prev_[node] : -1;
+  }
+
+
+  // True if the last query settled 'node'.
+  bool isSettled(int node) const {
+    checkNode(node);
+    return settled_[node] == epoch_;
+  }
+
+
+  // Number of nodes settled by the last query.
+  int settledNodes() const {
+    return settledCount_;
+  }
+
+
   // Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive.
   //
   // @return An array of node indexes of the shortest path from 'start' to 'end'. If 'start' and
   //     'end' are not connected then an empty array is returned.
   //
   std::list<int> reconstructPath(int start, int end) {
-    if (end < 0 || end >= N_) throw std::invalid_argument("Invalid node index");
-    if (start < 0 || start >= N_) throw std::invalid_argument("Invalid node index");
-    double dist = dijkstra(start, end);
+    double dist = shortestPath(start, end);
     std::list<int> path;
     if (dist == inf) return path;
     for (int at = end; at != -1; at = prev_[at])
       path.push_front(at);
-  //  for (int at : prev_) if (at != -1) path.push_back(at);
     return path;
   }
 
 };
 
+using DijkstrasShortestPathAdjacencyListWithDHeap = BasicDijkstrasShortestPathAdjacencyListWithDHeap<Graph>;
+
 
 
 // Example usage of DijkstrasShortestPathDHeap
@@ -408,19 +504,22 @@ int DijkstrasShortestPathDHeap_test()
   graph.addDirectedEdge(5, 0, 10.1);
 
   try  {
-    std::unique_ptr<DijkstrasShortestPathAdjacencyListWithDHeap> solver = std::make_unique<DijkstrasShortestPathAdjacencyListWithDHeap>(&graph);
+    // A 4-ary heap, the solver can be reused for any number of queries.
+    std::unique_ptr<DijkstrasShortestPathAdjacencyListWithDHeap> solver = std::make_unique<DijkstrasShortestPathAdjacencyListWithDHeap>(&graph, 4);
 
-    int start = 3, end = 0;
+    for (int start : {3, 7}) {
+      int end = 0;
 
-    std::list<int> path = solver->reconstructPath(start, end);
+      std::list<int> path = solver->reconstructPath(start, end);
 
-    std::cout << "Dijkstras Shortest Path from " << start << " to " << end << ": [";
-    if (!path.empty()){
-      for (auto edge: path){
-        std::cout << edge << ",";
+      std::cout << "Dijkstras Shortest Path from " << start << " to " << end << ": [";
+      if (!path.empty()){
+        for (auto edge: path){
+          std::cout << edge << ",";
+        }
       }
+      std::cout << "] settled " << solver->settledNodes() << " nodes" << std::endl;
     }
-    std::cout << "]" << std::endl;
 
     solver = nullptr;
   }
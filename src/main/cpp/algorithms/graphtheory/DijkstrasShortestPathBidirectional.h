@@ -0,0 +1,279 @@
+/*
+ * @file   DijkstrasShortestPathBidirectional.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Bidirectional Dijkstra for point-to-point shortest path queries.
+ *
+ * A forward search from the start node over the graph and a backward search from the end node
+ * over the reversed graph run alternately, always advancing the side whose next node is closer.
+ * Each search only explores a ball of about half the radius of a plain Dijkstra, which on road
+ * like graphs settles roughly half as many nodes.
+ *
+ * Whenever an edge (u, v) is relaxed and the other search has already reached v, the path
+ * start -> v -> end is a candidate and the best one is kept as mu. The search stops
+ * once topForward + topBackward >= mu: any path which is still undiscovered has to leave the
+ * forward ball and enter the backward ball, so it costs at least that much.
+ *
+ * function bidirectional(s, t):
+ *   mu = inf
+ *   while both queues are non empty and top(F) + top(B) < mu:
+ *     side = F if top(F) <= top(B) else B
+ *     u = side.poll()
+ *     for (u, v, w) in side.graph:
+ *       side.relax(v, dist[u] + w)
+ *       if other.reached(v): mu = min(mu, side.dist[v] + other.dist[v])
+ *   return mu
+ *
+ * Like DijkstrasShortestPathAdjacencyListWithDHeap the solver keeps its heaps and arrays between
+ * queries and stamps every entry with the query which wrote it. Edge weights must be non negative.
+ */
+
+#ifndef D_GRAPH_DIJKSTRASHORTESTPATHBIDIRECTIONAL_H
+#define D_GRAPH_DIJKSTRASHORTESTPATHBIDIRECTIONAL_H
+
+#include <Graph.h>
+#include <CsrGraph.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+
+#include <vector>
+#include <list>
+#include <iterator>
+#include <algorithm>
+
+#include <memory>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace dsa {
+
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicDijkstrasShortestPathBidirectional {
+private:
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // The state of the search in one direction. For the backward search
+  // prev_[v] is the next node on the path from v to the end node.
+  struct Search {
+    std::unique_ptr<MinIndexedDHeap<double>> ipq_;
+    std::vector<double> dist_;
+    std::vector<int> prev_;
+    std::vector<unsigned> stamp_, settled_;
+
+    double top() const {
+      return ipq_->isEmpty() ? std::numeric_limits<double>::infinity() : ipq_->peekMinValue();
+    }
+  };
+
+  int N_;
+  const GRAPH *graph_;
+  CsrGraph reverse_;
+  Search forward_, backward_;
+  unsigned epoch_;
+  int settledCount_;
+
+  // Best path found by the last query: its cost and the node where the two
+  // searches meet.
+  double best_;
+  int meeting_;
+
+
+
+  void init(Search& search, int degree) {
+    search.ipq_ = std::make_unique<MinIndexedDHeap<double>>(degree, std::max(1, N_));
+    search.dist_.resize(N_, inf);
+    search.prev_.resize(N_, -1);
+    search.stamp_.resize(N_, 0);
+    search.settled_.resize(N_, 0);
+  }
+
+
+  void newEpoch() {
+    forward_.ipq_->clear();
+    backward_.ipq_->clear();
+    settledCount_ = 0;
+    if (++epoch_ == 0) {
+      for (Search *search : {&forward_, &backward_}) {
+        std::fill(search->stamp_.begin(), search->stamp_.end(), 0);
+        std::fill(search->settled_.begin(), search->settled_.end(), 0);
+      }
+      epoch_ = 1;
+    }
+  }
+
+
+  void checkNode(int node) const {
+    if (node < 0 || node >= N_) throw std::invalid_argument("Invalid node index");
+  }
+
+
+  bool reached(const Search& search, int node) const {
+    return search.stamp_[node] == epoch_;
+  }
+
+
+  // Settles the closest node of 'search' and relaxes its edges in 'graph'.
+  template <typename G>
+  void step(Search& search, const Search& other, const G& graph) {
+    int nodeId = search.ipq_->pollMinKeyIndex();
+    search.settled_[nodeId] = epoch_;
+    settledCount_++;
+
+    for (auto edge: graph.edges(nodeId)) {
+      int to = edge.first;
+      if (search.settled_[to] == epoch_) continue;
+
+      double newDist = search.dist_[nodeId] + edge.second;
+      if (!reached(search, to)) {
+        search.stamp_[to] = epoch_;
+        search.dist_[to] = newDist;
+        search.prev_[to] = nodeId;
+        search.ipq_->insert(to, newDist);
+      } else if (newDist < search.dist_[to]) {
+        search.dist_[to] = newDist;
+        search.prev_[to] = nodeId;
+        search.ipq_->decrease(to, newDist);
+      }
+
+      // A path through the edge (nodeId, to) which the other search
+      // continues to its source.
+      if (reached(other, to) && search.dist_[to] + other.dist_[to] < best_) {
+        best_ = search.dist_[to] + other.dist_[to];
+        meeting_ = to;
+      }
+    }
+  }
+
+
+  double bidirectional(int start, int end) {
+    newEpoch();
+    best_ = inf;
+    meeting_ = -1;
+
+    for (Search *search : {&forward_, &backward_}) {
+      int source = search == &forward_ ? start : end;
+      search->stamp_[source] = epoch_;
+      search->dist_[source] = 0;
+      search->prev_[source] = -1;
+      search->ipq_->insert(source, 0.0);
+    }
+    if (start == end) {
+      best_ = 0;
+      meeting_ = start;
+      return best_;
+    }
+
+    while (!forward_.ipq_->isEmpty() && !backward_.ipq_->isEmpty()) {
+      double topForward = forward_.top(), topBackward = backward_.top();
+      // No undiscovered path can be shorter than the best one found.
+      if (topForward + topBackward >= best_) break;
+
+      if (topForward <= topBackward) step(forward_, backward_, *graph_);
+      else step(backward_, forward_, reverse_);
+    }
+    return best_;
+  }
+
+
+public:
+  // Initialize the solver with the graph to query. 'degree' is the arity of
+  // the heaps, 0 picks the average out degree of the graph (at least 2).
+  BasicDijkstrasShortestPathBidirectional(const GRAPH *graph, int degree = 0) : reverse_(0, std::vector<Edge>()) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    if (degree < 0) throw std::invalid_argument("degree < 0");
+    N_ = graph->size();
+    graph_ = graph;
+    reverse_ = CsrGraph::reverseOf(*graph);
+    if (degree == 0) degree = N_ == 0 ? 2 : graph->edgeCount() / N_;
+    init(forward_, degree);
+    init(backward_, degree);
+    epoch_ = 0;
+    settledCount_ = 0;
+    best_ = inf;
+    meeting_ = -1;
+  }
+
+
+  BasicDijkstrasShortestPathBidirectional(const BasicDijkstrasShortestPathBidirectional&) = delete;
+  BasicDijkstrasShortestPathBidirectional& operator=(BasicDijkstrasShortestPathBidirectional const&) = delete;
+
+  // The graph the solver runs on.
+  const GRAPH& operator()() {
+    return *graph_;
+  }
+
+
+  // Returns the cost of the shortest path from 'start' to 'end', or infinity
+  // if 'end' is unreachable.
+  double shortestPath(int start, int end) {
+    checkNode(start);
+    checkNode(end);
+    return bidirectional(start, end);
+  }
+
+
+  // Number of nodes settled by the last query, both directions together.
+  int settledNodes() const {
+    return settledCount_;
+  }
+
+
+  // Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive.
+  //
+  // @return An array of node indexes of the shortest path from 'start' to 'end'. If 'start' and
+  //     'end' are not connected then an empty array is returned.
+  //
+  std::list<int> reconstructPath(int start, int end) {
+    double dist = shortestPath(start, end);
+    std::list<int> path;
+    if (dist == inf) return path;
+    for (int at = meeting_; at != -1; at = forward_.prev_[at])
+      path.push_front(at);
+    for (int at = backward_.prev_[meeting_]; at != -1; at = backward_.prev_[at])
+      path.push_back(at);
+    return path;
+  }
+
+};
+
+using DijkstrasShortestPathBidirectional = BasicDijkstrasShortestPathBidirectional<Graph>;
+
+
+
+// Example usage of DijkstrasShortestPathBidirectional
+int DijkstrasShortestPathBidirectional_test()
+{
+  Graph graph(8);
+
+  graph.addDirectedEdge(6, 0, 1.1);
+  graph.addDirectedEdge(6, 2, 0.2);
+  graph.addDirectedEdge(3, 4, 3.6);
+  graph.addDirectedEdge(6, 4, 0.4);
+  graph.addDirectedEdge(2, 0, 0.7);
+  graph.addDirectedEdge(0, 1, 3.4);
+  graph.addDirectedEdge(4, 5, 6.9);
+  graph.addDirectedEdge(5, 6, 0.9);
+  graph.addDirectedEdge(3, 7, 8.2);
+  graph.addDirectedEdge(7, 5, 0.3);
+  graph.addDirectedEdge(1, 2, 4.6);
+  graph.addDirectedEdge(7, 3, 6.4);
+  graph.addDirectedEdge(5, 0, 10.1);
+
+  DijkstrasShortestPathBidirectional solver(&graph);
+
+  int start = 3, end = 0;
+  std::list<int> path = solver.reconstructPath(start, end);
+
+  std::cout << "Bidirectional Dijkstra from " << start << " to " << end << ": [";
+  for (auto node: path) std::cout << node << ",";
+  std::cout << "] settled " << solver.settledNodes() << " nodes" << std::endl;
+  // Prints:
+  // Bidirectional Dijkstra from 3 to 0: [3,7,5,6,2,0,] settled 7 nodes
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_DIJKSTRASHORTESTPATHBIDIRECTIONAL_H */
@@ -0,0 +1,276 @@
+/*
+ * @file   DynamicTopologicalOrder.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   A topological order of a growing DAG, maintained on every edge insertion.
+ *
+ * Pearce and Kelly, "A dynamic topological sort algorithm for directed acyclic graphs", 2006.
+ *
+ * ord[v] is the position of v in the order. Inserting an edge x -> y with ord[x] < ord[y]
+ * keeps the order valid. Otherwise only the nodes with a position in [ord[y], ord[x]] can be
+ * out of order, the affected region:
+ *
+ * function addEdge(x, y):
+ *   lb = ord[y], ub = ord[x]
+ *   if lb < ub:
+ *     deltaF = nodes reachable from y with ord <= ub   # reaching x means a cycle
+ *     deltaB = nodes reaching x with ord >= lb
+ *     positions = sorted ord of deltaB and deltaF
+ *     assign positions to deltaB (sorted by ord), then to deltaF (sorted by ord)
+ *   add x -> y
+ *
+ * The searches and the reordering only touch the affected region, so an insertion costs
+ * O(|delta| log |delta| + edges of delta) instead of the O(V + E) of a full sort. An edge
+ * which would close a cycle is rejected and leaves the graph unchanged.
+ *
+ * The structure owns its edges and provides size(), edgeCount() and edges(node) like Graph,
+ * so the algorithms templated on the graph type run on it as well.
+ */
+
+#ifndef D_GRAPH_DYNAMICTOPOLOGICALORDER_H
+#define D_GRAPH_DYNAMICTOPOLOGICALORDER_H
+
+#include <Graph.h>
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace dsa {
+
+class DynamicTopologicalOrder
+{
+public:
+  using EDGES = std::vector<std::pair<int, double>>; // Node ID, Cost
+
+private:
+  std::vector<EDGES> out_, in_;
+  std::vector<int> ord_, order_;
+  int edgeCount_;
+
+  // Nodes found by the two searches of the last insertion.
+  std::vector<unsigned> visited_;
+  unsigned stamp_;
+  std::vector<int> deltaF_, deltaB_, stack_, positions_;
+
+
+  void checkNode(int u) const {
+    if (u < 0 || (unsigned)u >= out_.size()) throw std::invalid_argument("Invalid node index");
+  }
+
+
+  void newStamp() {
+    if (++stamp_ == 0) {
+      std::fill(visited_.begin(), visited_.end(), 0);
+      stamp_ = 1;
+    }
+  }
+
+
+  // Collects in 'delta' the nodes reachable from 'start' along 'edges' whose
+  // position is within [lb, ub]. Returns false if 'target' was reached.
+  bool collect(int start, const std::vector<EDGES>& edges, int lb, int ub, int target, std::vector<int>& delta) {
+    delta.clear();
+    stack_.clear();
+    visited_[start] = stamp_;
+    stack_.push_back(start);
+    while (!stack_.empty()) {
+      int u = stack_.back();
+      stack_.pop_back();
+      delta.push_back(u);
+      for (auto& edge : edges[u]) {
+        int v = edge.first;
+        if (v == target) return false;
+        if (visited_[v] != stamp_ && ord_[v] >= lb && ord_[v] <= ub) {
+          visited_[v] = stamp_;
+          stack_.push_back(v);
+        }
+      }
+    }
+    return true;
+  }
+
+
+  // Moves the nodes of deltaB before the nodes of deltaF, reusing their positions.
+  void reorder() {
+    auto byPosition = [&](int a, int b) { return ord_[a] < ord_[b]; };
+    std::sort(deltaB_.begin(), deltaB_.end(), byPosition);
+    std::sort(deltaF_.begin(), deltaF_.end(), byPosition);
+
+    positions_.clear();
+    for (int u : deltaB_) positions_.push_back(ord_[u]);
+    for (int u : deltaF_) positions_.push_back(ord_[u]);
+    std::sort(positions_.begin(), positions_.end());
+
+    int i = 0;
+    for (int u : deltaB_) ord_[u] = positions_[i++];
+    for (int u : deltaF_) ord_[u] = positions_[i++];
+    for (int p : positions_) order_[p] = -1;
+    for (int u : deltaB_) order_[ord_[u]] = u;
+    for (int u : deltaF_) order_[ord_[u]] = u;
+  }
+
+public:
+  DynamicTopologicalOrder(const DynamicTopologicalOrder&) = delete;
+  DynamicTopologicalOrder& operator=(DynamicTopologicalOrder const&) = delete;
+
+  // Creates a graph of 'n' nodes without edges, ordered 0, 1, ..., n - 1.
+  explicit DynamicTopologicalOrder(int n) {
+    if (n < 0) throw std::invalid_argument("n < 0");
+    edgeCount_ = 0;
+    stamp_ = 0;
+    for (int i = 0; i < n; i++) addNode();
+  }
+
+
+  // Creates the structure from the edges of a graph. Throws if the graph has
+  // a cycle. GRAPH is Graph, CsrGraph or any type with the same interface.
+  template <typename GRAPH>
+  explicit DynamicTopologicalOrder(const GRAPH *graph) : DynamicTopologicalOrder(graph == nullptr ? 0 : (int)graph->size()) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    for (int u = 0; u < (int)graph->size(); u++)
+      for (auto edge: graph->edges(u))
+        if (!addEdge(u, edge.first, edge.second)) throw std::invalid_argument("GRAPH has a cycle");
+  }
+
+
+  // Adds a node at the end of the order and returns its id.
+  int addNode() {
+    int id = out_.size();
+    out_.emplace_back();
+    in_.emplace_back();
+    ord_.push_back(id);
+    order_.push_back(id);
+    visited_.push_back(0);
+    return id;
+  }
+
+
+  // Adds the edge u -> v and updates the order. Returns false, and leaves the
+  // graph unchanged, if the edge would close a cycle.
+  bool addEdge(int u, int v, double cost = 0.0) {
+    checkNode(u);
+    checkNode(v);
+    if (u == v) return false;
+
+    int lb = ord_[v], ub = ord_[u];
+    if (lb < ub) {
+      newStamp();
+      if (!collect(v, out_, lb, ub, u, deltaF_)) return false;
+      collect(u, in_, lb, ub, -1, deltaB_);
+      reorder();
+    }
+
+    out_[u].push_back({v, cost});
+    in_[v].push_back({u, cost});
+    edgeCount_++;
+    return true;
+  }
+
+
+  // Returns true if the edge u -> v can be added without closing a cycle.
+  bool canAddEdge(int u, int v) {
+    checkNode(u);
+    checkNode(v);
+    if (u == v) return false;
+    int lb = ord_[v], ub = ord_[u];
+    if (lb > ub) return true;
+    newStamp();
+    return collect(v, out_, lb, ub, u, deltaF_);
+  }
+
+
+  // Get size of graph
+  unsigned int size() const {
+    return out_.size();
+  }
+
+
+  // Get number of edges
+  unsigned int edgeCount() const {
+    return edgeCount_;
+  }
+
+
+  // Get the outgoing edges of node 'u' as (Node ID, Cost) pairs.
+  const EDGES& edges(int u) const {
+    checkNode(u);
+    return out_[u];
+  }
+
+
+  // The nodes in topological order.
+  const std::vector<int>& topologicalSort() const {
+    return order_;
+  }
+
+
+  // The position of node 'u' in topologicalSort().
+  int position(int u) const {
+    checkNode(u);
+    return ord_[u];
+  }
+
+
+  // Shortest path to all nodes starting at 'start', with the semantics of
+  // TopologicalSortAdjacencyList::dagShortestPath(): -1 marks unreachable
+  // nodes. Only the nodes after 'start' in the order are visited.
+  std::vector<int> dagShortestPath(int start) const {
+    int n = out_.size();
+    std::vector<int> dist(n, -1);
+    if (n == 0) return dist;
+
+    if (start < 0 || start >= n) throw std::invalid_argument("Invalid start node index");
+
+    dist[start] = 0;
+    for (int i = ord_[start]; i < n; i++) {
+      int nodeIndex = order_[i];
+      if (dist[nodeIndex] == -1) continue;
+      for (auto& edge : out_[nodeIndex]) {
+        int newDist = dist[nodeIndex] + static_cast<int>(edge.second);
+        if (dist[edge.first] == -1) dist[edge.first] = newDist;
+        else dist[edge.first] = std::min(dist[edge.first], newDist);
+      }
+    }
+    return dist;
+  }
+
+};
+
+
+
+// Example usage of DynamicTopologicalOrder
+int DynamicTopologicalOrder_test()
+{
+  DynamicTopologicalOrder dag(7);
+
+  dag.addEdge(0, 1, 3.);
+  dag.addEdge(0, 2, 2.);
+  dag.addEdge(0, 5, 3.);
+  dag.addEdge(1, 3, 1.);
+  dag.addEdge(1, 2, 6.);
+  dag.addEdge(2, 3, 1.);
+  dag.addEdge(2, 4, 10.);
+  dag.addEdge(3, 4, 5.);
+  dag.addEdge(5, 4, 7.);
+  dag.addEdge(6, 0, 1.); // Moves 6 in front of 0.
+
+  std::cout << "Ordering:";
+  for (int node : dag.topologicalSort()) std::cout << " " << node;
+  std::cout << std::endl;
+  std::cout << "Edge 4 -> 0 closes a cycle: " << !dag.addEdge(4, 0) << std::endl;
+  std::cout << "Shortest path from 0 to 4: " << dag.dagShortestPath(0)[4] << std::endl;
+  // Prints:
+  // Ordering: 6 0 1 2 3 5 4
+  // Edge 4 -> 0 closes a cycle: 1
+  // Shortest path from 0 to 4: 8
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_DYNAMICTOPOLOGICALORDER_H */
@@ -9,6 +9,13 @@
  * shortest paths between nodes in a graph. We also demonstrate how to detect negative cycles and
  * reconstruct the shortest path.
  *
+ * The solver below keeps dp and next in contiguous row-major buffers and runs the
+ * blocked (tiled) variant of the algorithm: the k loop advances one block of nodes
+ * at a time and the matrix is updated tile by tile so every tile is reused from
+ * cache for a whole block of k. Negative cycles are then propagated by marking
+ * every pair (i, j) that can be routed through a node k with dp[k][k] < 0, which
+ * yields the same result as the second FW pass shown below.
+ *
  * Time Complexity: O(V^3)
  *
  * # Global/class scope variables
@@ -86,6 +93,7 @@
 #define D_GRAPH_FLOYDWARSHALL_H
 
 #include <Graph.h>
+#include <ThreadPool.h>
 
 #include <vector>
 #include <deque>
@@ -105,6 +113,8 @@
 #include <iostream>
 #include <limits>
 #include <cassert>
+#include <stdexcept>
+#include <tuple>
 
 namespace dsa {
 
@@ -113,15 +123,122 @@ class FloydWarshallSolver
   const int REACHES_NEGATIVE_CYCLE = -1;
   const double POSITIVE_INFINITY = std::numeric_limits<double>::infinity();
   const double NEGATIVE_INFINITY = -std::numeric_limits<double>::infinity();
-  int n_;
+  int n_, blockSize_, numThreads_;
   bool solved_;
-  std::vector<std::vector<double>> dp_;
-  std::vector<std::vector<int>> next_;
+
+  // The dp and next matrices are stored in single contiguous row-major
+  // buffers: entry (i, j) lives at index i * n + j.
+  std::vector<double> dp_;
+  std::vector<int> next_;
+
+  // Nested copy of dp_ handed out by getApspMatrix(), built on demand.
+  std::vector<std::vector<double>> apsp_;
+
+  // Workers of the parallel solve, alive while solve() runs.
+  std::unique_ptr<ThreadPool> pool_;
+
+
+  // Runs task(0), ..., task(count - 1) on the thread pool, or in order when
+  // solving serially.
+  template <typename F>
+  void forEachTask(int count, F task) {
+    if (pool_) pool_->parallelFor(0, count, [&](int t, int) { task(t); });
+    else for (int t = 0; t < count; t++) task(t);
+  }
+
+
+  // Relaxes the tile [i0, i1) x [j0, j1) of the dp matrix through the
+  // intermediate nodes [k0, k1). The inner loop is branch free so the
+  // compiler can turn it into vectorized min-plus instructions.
+  void relaxTile(int i0, int i1, int j0, int j1, int k0, int k1) {
+    const std::size_t n = n_;
+    double *dp = dp_.data();
+    int *next = next_.data();
+
+    for (int k = k0; k < k1; k++) {
+      const double *dk = dp + k * n;
+      for (int i = i0; i < i1; i++) {
+        double *di = dp + i * n;
+        const double dik = di[k];
+        // Nothing can be improved through 'k' if 'i' does not reach it.
+        if (dik == POSITIVE_INFINITY) continue;
+        int *ni = next + i * n;
+        const int nik = ni[k];
+        for (int j = j0; j < j1; j++) {
+          const double d = dik + dk[j];
+          const bool better = d < di[j];
+          di[j] = better ? d : di[j];
+          ni[j] = better ? nik : ni[j];
+        }
+      }
+    }
+  }
+
+
+  // Runs one k-phase of the blocked algorithm for the nodes [k0, k1): first
+  // the diagonal tile, then the tiles sharing its row or column, and last
+  // all remaining tiles which only depend on the row and column tiles.
+  // Tiles within the second and the third step are independent of each
+  // other, so they can be relaxed concurrently and in any order without
+  // changing a single bit of the result.
+  void relaxPhase(int k0, int k1) {
+    const int B = blockSize_;
+    const int blocks = (n_ + B - 1) / B;
+    const int kb = k0 / B;
+
+    relaxTile(k0, k1, k0, k1, k0, k1);
+
+    forEachTask(2 * blocks, [&](int t) {
+      int b = t / 2;
+      if (b == kb) return;
+      int b0 = b * B, b1 = std::min(b0 + B, n_);
+      if (t % 2 == 0) relaxTile(k0, k1, b0, b1, k0, k1);
+      else relaxTile(b0, b1, k0, k1, k0, k1);
+    });
+
+    forEachTask(blocks * blocks, [&](int t) {
+      int ib = t / blocks, jb = t % blocks;
+      if (ib == kb || jb == kb) return;
+      int i0 = ib * B, j0 = jb * B;
+      relaxTile(i0, std::min(i0 + B, n_), j0, std::min(j0 + B, n_), k0, k1);
+    });
+  }
+
+
+  // Propagates 'NEGATIVE_INFINITY' to every pair (i, j) whose path can be
+  // routed through a node 'k' lying on a negative cycle (dp[k][k] < 0).
+  void propagateNegativeCycles(const std::vector<int>& negativeNodes) {
+    const std::size_t n = n_;
+    const int B = blockSize_;
+    std::vector<char> reaches(n_);
+
+    for (int k : negativeNodes) {
+      // Snapshot which nodes 'k' reaches, rows are then marked independently.
+      const double *dk = dp_.data() + k * n;
+      for (int j = 0; j < n_; j++) reaches[j] = dk[j] != POSITIVE_INFINITY;
+
+      forEachTask((n_ + B - 1) / B, [&](int t) {
+        for (int i = t * B; i < std::min(t * B + B, n_); i++) {
+          double *di = dp_.data() + i * n;
+          if (di[k] == POSITIVE_INFINITY) continue;
+          int *ni = next_.data() + i * n;
+          for (int j = 0; j < n_; j++) {
+            di[j] = reaches[j] ? NEGATIVE_INFINITY : di[j];
+            ni[j] = reaches[j] ? REACHES_NEGATIVE_CYCLE : ni[j];
+          }
+        }
+      });
+    }
+  }
 
 public:
   FloydWarshallSolver(const FloydWarshallSolver&) = delete;
   FloydWarshallSolver& operator=(FloydWarshallSolver const&) = delete;
 
+  // Edge length of the square tiles the dp matrix is processed in. 64x64
+  // doubles keep the three tiles of an update within the L2 cache.
+  static const int DEFAULT_BLOCK_SIZE = 64;
+
 
   // As input, this class takes an adjacency matrix with edge weights between nodes, where
   // POSITIVE_INFINITY (inf) is used to indicate that two nodes are not connected.
@@ -130,16 +247,24 @@ public:
   // all i) since there is typically no cost to go from a node to itself, but this may depend on
   // your graph and the problem you are trying to solve.
   //
-  FloydWarshallSolver(std::vector<std::vector<double> > matrix) {
+  // @param blockSize - The edge length of the tiles.
+  // @param numThreads - The number of threads solve() runs on. The result is bit-identical
+  //     for every thread count.
+  //
+  FloydWarshallSolver(const std::vector<std::vector<double> >& matrix, int blockSize = DEFAULT_BLOCK_SIZE, int numThreads = 1) {
+    if (blockSize <= 0) throw std::invalid_argument("blockSize <= 0");
+    if (numThreads <= 0) throw std::invalid_argument("numThreads <= 0");
     n_ = matrix[0].size();
-    dp_.resize(n_, std::vector<double>(n_));
-    next_.resize(n_, std::vector<int>(n_));
+    blockSize_ = blockSize;
+    numThreads_ = numThreads;
+    dp_.resize((std::size_t)n_ * n_);
+    next_.resize((std::size_t)n_ * n_, 0);
 
     // Copy input matrix and setup 'next' matrix for path reconstruction.
     for (int i = 0; i < n_; i++) {
       for (int j = 0; j < n_; j++) {
-        if (matrix[i][j] != POSITIVE_INFINITY) next_[i][j] = j;
-        dp_[i][j] = matrix[i][j];
+        if (matrix[i][j] != POSITIVE_INFINITY) next_[(std::size_t)i * n_ + j] = j;
+        dp_[(std::size_t)i * n_ + j] = matrix[i][j];
       }
     }
     solved_ = false;
@@ -152,7 +277,20 @@ public:
   //
   std::vector<std::vector<double>>& getApspMatrix() {
     solve();
-    return dp_;
+    if (apsp_.empty()) {
+      apsp_.resize(n_);
+      for (int i = 0; i < n_; i++)
+        apsp_[i].assign(dp_.begin() + (std::size_t)i * n_, dp_.begin() + (std::size_t)(i + 1) * n_);
+    }
+    return apsp_;
+  }
+
+
+  // Returns the shortest distance from 'start' to 'end' without building
+  // the nested APSP matrix.
+  double getDistance(int start, int end) {
+    solve();
+    return dp_[(std::size_t)start * n_ + end];
   }
 
 
@@ -160,28 +298,20 @@ public:
   void solve() {
     if (solved_) return;
 
-    // Compute all pairs shortest paths.
-    for (int k = 0; k < n_; k++) {
-      for (int i = 0; i < n_; i++) {
-        for (int j = 0; j < n_; j++) {
-          if (dp_[i][k] + dp_[k][j] < dp_[i][j]) {
-            dp_[i][j] = dp_[i][k] + dp_[k][j];
-            next_[i][j] = next_[i][k];
-          }
-        }
-      }
-    }
+    if (numThreads_ > 1) pool_ = std::make_unique<ThreadPool>(numThreads_);
+
+    // Compute all pairs shortest paths one block of intermediate nodes at a time.
+    for (int k0 = 0; k0 < n_; k0 += blockSize_)
+      relaxPhase(k0, std::min(k0 + blockSize_, n_));
 
     // Identify negative cycles by propagating the value 'NEGATIVE_INFINITY'
     // to every edge that is part of or reaches into a negative cycle.
+    std::vector<int> negativeNodes;
     for (int k = 0; k < n_; k++)
-      for (int i = 0; i < n_; i++)
-        for (int j = 0; j < n_; j++)
-          if (dp_[i][k] + dp_[k][j] < dp_[i][j]) {
-            dp_[i][j] = NEGATIVE_INFINITY;
-            next_[i][j] = REACHES_NEGATIVE_CYCLE;
-          }
+      if (dp_[(std::size_t)k * n_ + k] < 0) negativeNodes.push_back(k);
+    propagateNegativeCycles(negativeNodes);
 
+    pool_ = nullptr;
     solved_ = true;
   }
 
@@ -195,15 +325,15 @@ public:
   std::tuple <bool, std::list<int>> reconstructShortestPath(int start, int end) {
     solve();
     std::list<int> path;
-    if (dp_[start][end] == POSITIVE_INFINITY) return make_tuple(false, path);
+    if (dp_[(std::size_t)start * n_ + end] == POSITIVE_INFINITY) return make_tuple(false, path);
     int at = start;
-    for (; at != end; at = next_[at][end]) {
+    for (; at != end; at = next_[(std::size_t)at * n_ + end]) {
       // Return null since there are an infinite number of shortest paths.
       if (at == REACHES_NEGATIVE_CYCLE) return make_tuple(true, path);
       path.push_back(at);
     }
     // Return null since there are an infinite number of shortest paths.
-    if (next_[at][end] == REACHES_NEGATIVE_CYCLE) return make_tuple(true, path);
+    if (next_[(std::size_t)at * n_ + end] == REACHES_NEGATIVE_CYCLE) return make_tuple(true, path);
     path.push_back(end);
     return make_tuple(false, path);
   }
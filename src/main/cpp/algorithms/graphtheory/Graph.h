@@ -26,11 +26,21 @@
 #include <sstream>
 #include <memory>
 #include <iostream>
+#include <stdexcept>
 
 namespace dsa {
 
 typedef std::vector<int> IntegerVector;
 
+
+// A directed, weighted edge used when a graph is given as a plain edge list.
+struct Edge {
+  int from_;
+  int to_;
+  double cost_;
+};
+
+
 class Graph
 {
 
@@ -40,12 +50,21 @@ public:
   using GRAPH_VERTEX = std::unordered_map<int, GRAPH_EDGE>; // Node ID, Edges
 
 private:
-  GRAPH_VERTEX *vertices_;
+  // Owned by the graph. A graph which was moved from has no vertices and
+  // behaves as an empty graph.
+  std::unique_ptr<GRAPH_VERTEX> vertices_;
   int edgeCount_;
 
+
+  GRAPH_VERTEX& vertices() {
+    if (!vertices_) vertices_ = std::make_unique<GRAPH_VERTEX>();
+    return *vertices_;
+  }
+
 public:
   Graph(int n) {
-    vertices_ = new GRAPH_VERTEX();
+    vertices_ = std::make_unique<GRAPH_VERTEX>();
+    vertices_->reserve(n);
     for (int i = 0; i < n; i++) {
       GRAPH_EDGE edge_;
       vertices_->insert(make_pair(i, std::move(edge_)));
@@ -54,91 +73,141 @@ public:
   }
 
 
-  virtual ~Graph() {
-	if (vertices_) {
-      delete vertices_;
-      vertices_ = nullptr;
-	}
+  // Creates a graph of 'n' nodes from a list of directed edges, see
+  // addDirectedEdges(). Node ids must be in [0, n).
+  Graph(int n, const std::vector<Edge>& edges) : Graph(n) {
+    addDirectedEdges(edges);
   }
 
 
+  virtual ~Graph() = default;
+
+
   Graph(const Graph& rhs) { // Copy constructor
-	std::cout << "Graph copy constructor" << std::endl;
-	vertices_ = rhs.vertices_;
-	edgeCount_ = rhs.edgeCount_;
+    vertices_ = rhs.vertices_ ? std::make_unique<GRAPH_VERTEX>(*rhs.vertices_) : nullptr;
+    edgeCount_ = rhs.edgeCount_;
   }
 
 
-  Graph(const Graph&& rhs) { // Move constructor
-	std::cout << "Graph move constructor" << std::endl;
-    vertices_ = rhs.vertices_;
-	edgeCount_ = rhs.edgeCount_;
+  Graph(Graph&& rhs) noexcept { // Move constructor
+    vertices_ = std::move(rhs.vertices_);
+    edgeCount_ = rhs.edgeCount_;
+    rhs.edgeCount_ = 0;
   }
 
 
   Graph& operator = (const Graph& rhs ) {
-	std::cout << "Graph copy operator" << std::endl;
-	if (this != &rhs) {
-      for (auto it = rhs.vertices_->begin();; it++) {
-    	if (it == rhs.vertices_->end()) break;
-    	GRAPH_EDGE edges;
-	    if (!it->second.empty()) {
-	      for (auto edge: it->second) {
-	    	edges.insert(std::move(edge));
-	      }
-	    }
-        vertices_->insert(make_pair(it->first, std::move(edges)));
-      }
-	}
-	std::cout << "Graph copy operator DONE" << std::endl;
-
-	return *this;
+    if (this != &rhs) {
+      vertices_ = rhs.vertices_ ? std::make_unique<GRAPH_VERTEX>(*rhs.vertices_) : nullptr;
+      edgeCount_ = rhs.edgeCount_;
+    }
+    return *this;
   }
 
-  Graph& operator = (Graph&& rhs ) {
-    std::cout << "Graph move operator" << std::endl;
-	if (this != &rhs) {
-      vertices_ = rhs.vertices_;
-	}
-	return *this;
+  Graph& operator = (Graph&& rhs ) noexcept {
+    if (this != &rhs) {
+      vertices_ = std::move(rhs.vertices_);
+      edgeCount_ = rhs.edgeCount_;
+      rhs.edgeCount_ = 0;
+    }
+    return *this;
   }
 
   GRAPH_VERTEX* operator()() {
-    return vertices_;
+    return &vertices();
   }
 
 
   // Empty this graph
   void clear() {
-    for (auto itr = vertices_->begin(); itr != vertices_->end(); itr++)
-      itr->second.erase(itr->second.begin(), itr->second.end());
-    vertices_->erase(vertices_->begin(), vertices_->end());
+    if (vertices_) vertices_->clear();
+    edgeCount_ = 0;
+  }
+
+
+  // Reserves room for 'n' nodes in total.
+  void reserve(unsigned int n) {
+    vertices().reserve(n);
+  }
+
+
+  // Reserves room for 'count' outgoing edges of node 'u', creating the node
+  // if needed.
+  void reserveEdges(int u, unsigned int count) {
+    vertices()[u].reserve(count);
   }
 
 
   // Get size of graph
-  unsigned int size() {
-    return vertices_->size();
+  unsigned int size() const {
+    return vertices_ ? vertices_->size() : 0;
   }
 
 
   // Get number of edges
-  unsigned int edgeCount() {
+  unsigned int edgeCount() const {
     return edgeCount_;
   }
 
 
+  // Get the outgoing edges of node 'u' as (Node ID, Cost) pairs. An empty
+  // edge list is returned if 'u' is not part of the graph.
+  const GRAPH_EDGE& edges(int u) const {
+    static const GRAPH_EDGE noEdges;
+    if (!vertices_) return noEdges;
+    auto itr = vertices_->find(u);
+    return itr != vertices_->end() ? itr->second : noEdges;
+  }
+
+
   // Add a directed edge from node 'u' to node 'v' with cost 'cost'.
   //
-  //  Adds a directed edge to the graph.
+  //  Adds a directed edge to the graph. Adding an edge which already exists
+  //  replaces its cost.
   //
   //  @param from - The index of the node the directed edge starts at.
   //  @param to - The index of the node the directed edge end at.
   //  @param cost - The cost of the edge.
   //
   void addDirectedEdge(int u, int v, double cost = 0.0) {
-	(*vertices_)[u][v] = cost;
-    edgeCount_++;
+    auto r = vertices()[u].emplace(v, cost);
+    if (r.second) edgeCount_++;
+    else r.first->second = cost;
+  }
+
+
+  // Adds a list of directed edges, with the same result as calling
+  // addDirectedEdge() for each of them in order: a repeated edge keeps the
+  // cost it is given last. The edges are grouped by source node with a
+  // counting sort and the edge table of every node is sized once, so no
+  // table is rehashed while the edges are inserted. Node ids must be in
+  // [0, size()), otherwise nothing is added.
+  void addDirectedEdges(const std::vector<Edge>& edges) {
+    int n = size(), maxFrom = -1;
+    for (const Edge& e: edges) {
+      if (e.from_ < 0 || e.from_ >= n || e.to_ < 0 || e.to_ >= n) throw std::invalid_argument("Invalid node index");
+      maxFrom = std::max(maxFrom, e.from_);
+    }
+
+    std::vector<size_t> offsets(maxFrom + 2, 0);
+    for (const Edge& e: edges) offsets[e.from_ + 1]++;
+    for (int u = 0; u <= maxFrom; u++) offsets[u + 1] += offsets[u];
+    std::vector<size_t> pos(offsets.begin(), offsets.end() - 1);
+    std::vector<int> order(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) order[pos[edges[i].from_]++] = i;
+
+    GRAPH_VERTEX& vertices = this->vertices();
+    for (int u = 0; u <= maxFrom; u++) {
+      if (offsets[u] == offsets[u + 1]) continue;
+      GRAPH_EDGE& out = vertices[u];
+      out.reserve(out.size() + offsets[u + 1] - offsets[u]);
+      for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+        const Edge& e = edges[order[i]];
+        auto r = out.emplace(e.to_, e.cost_);
+        if (r.second) edgeCount_++;
+        else r.first->second = e.cost_;
+      }
+    }
   }
 
 
@@ -176,16 +245,15 @@ public:
 	std::stringstream os;
     os << "Graph[" << std::endl;
 
-    for (auto it = vertices_->begin();; it++) {
-  	  if (it == vertices_->end()) break;
-      os << " Node(" << it->first << ")[";
-	  if (!it->second.empty()) {
-	    for (auto edge: it->second) {
+    if (vertices_) {
+      for (auto it = vertices_->begin(); it != vertices_->end(); it++) {
+        os << " Node(" << it->first << ")[";
+        for (auto edge: it->second) {
           os << "Edge(" << "->" << edge.first << ",cost:" << edge.second << ")";
-		  os << ",";
-	    }
-	  }
-      os << "]" << std::endl;
+          os << ",";
+        }
+        os << "]" << std::endl;
+      }
     }
 
     os << "]";
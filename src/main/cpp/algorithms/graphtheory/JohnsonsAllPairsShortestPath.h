@@ -0,0 +1,220 @@
+/*
+ * @file   JohnsonsAllPairsShortestPath.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Johnson's algorithm for all pairs shortest paths on sparse graphs.
+ *
+ * FloydWarshallSolver takes O(V^3) time and a V x V matrix whatever the number of edges.
+ * Johnson's algorithm runs one Dijkstra per source instead, O(V E log V) in total, after
+ * removing the negative edge costs with a potential h:
+ *
+ * function johnson(g):
+ *   add a node q with an edge q -> v of cost 0 to every node v
+ *   h = bellmanFord(q)                      # fails if g has a negative cycle
+ *   for every edge (u, v, w): w' = w + h[u] - h[v]     # w' >= 0
+ *   for every source s:
+ *     d' = dijkstra(s) on w'
+ *     dist(s, v) = d'(v) - h[s] + h[v]
+ *
+ * The cost of every path from s to v changes by the same h[s] - h[v], so the shortest paths
+ * stay the same. The potentials come from BellmanFordEdgeList and the searches from
+ * DijkstrasShortestPathAdjacencyListWithDHeap, one solver per thread with the sources handed
+ * out dynamically. Each row of distances is passed to a callback as soon as it is known, so
+ * the V x V result never has to be held in memory.
+ */
+
+#ifndef D_GRAPH_JOHNSONSALLPAIRSSHORTESTPATH_H
+#define D_GRAPH_JOHNSONSALLPAIRSSHORTESTPATH_H
+
+#include <Graph.h>
+#include <CsrGraph.h>
+#include <ThreadPool.h>
+#include <BellmanFordEdgeList.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <functional>
+
+#include <memory>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace dsa {
+
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicJohnsonsAllPairsShortestPath {
+public:
+  // Receives the distances and the predecessors of one source, infinity and
+  // -1 for unreachable nodes. It is called from several threads at once,
+  // must be thread safe and must not throw. The rows are only valid during
+  // the call.
+  using Callback = std::function<void(int source, const std::vector<double>& dist, const std::vector<int>& prev)>;
+
+private:
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // Output rows of one thread. Only the row data is written during the
+  // solve, and it is allocated separately per thread.
+  struct Buffer {
+    std::vector<double> dist;
+    std::vector<int> prev;
+  };
+
+  const GRAPH *graph_;
+  int N_, numThreads_;
+  std::vector<double> potential_;
+  CsrGraph reweighted_;
+
+
+  void checkNode(int node) const {
+    if (node < 0 || node >= N_) throw std::invalid_argument("Invalid node index");
+  }
+
+public:
+  // Computes the potentials and the reweighted graph. Throws if 'graph' has
+  // a negative cycle.
+  BasicJohnsonsAllPairsShortestPath(const GRAPH *graph, int numThreads = ThreadPool::hardwareThreads())
+      : reweighted_(0, std::vector<Edge>()) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    if (numThreads < 1) throw std::invalid_argument("numThreads < 1");
+    graph_ = graph;
+    N_ = graph->size();
+    numThreads_ = numThreads;
+
+    // Node N_ is the extra node q.
+    std::vector<Edge> edges;
+    edges.reserve(graph->edgeCount() + N_);
+    for (int u = 0; u < N_; u++)
+      for (auto edge: graph->edges(u)) edges.push_back({u, edge.first, edge.second});
+    for (int v = 0; v < N_; v++) edges.push_back({N_, v, 0});
+    CsrGraph augmented(N_ + 1, edges);
+
+    BasicBellmanFordEdgeList<CsrGraph> bellmanFord(N_, &augmented);
+    if (bellmanFord.hasNegativeCycle()) throw std::invalid_argument("GRAPH has a negative cycle");
+    potential_ = bellmanFord.getShortestPaths();
+    potential_.pop_back();
+
+    // Rounding can leave a reweighted cost just below zero.
+    edges.resize(edges.size() - N_);
+    for (Edge& edge : edges)
+      edge.cost_ = std::max(0.0, edge.cost_ + potential_[edge.from_] - potential_[edge.to_]);
+    reweighted_ = CsrGraph(N_, edges);
+  }
+
+
+  BasicJohnsonsAllPairsShortestPath(const BasicJohnsonsAllPairsShortestPath&) = delete;
+  BasicJohnsonsAllPairsShortestPath& operator=(BasicJohnsonsAllPairsShortestPath const&) = delete;
+
+  // The graph the solver runs on.
+  const GRAPH& operator()() {
+    return *graph_;
+  }
+
+
+  // The potential h of every node, the distance from the extra node q.
+  const std::vector<double>& potentials() const {
+    return potential_;
+  }
+
+
+  // Solves every node of 'sources' and streams the rows to 'callback', in
+  // no particular order.
+  void solve(const std::vector<int>& sources, const Callback& callback) {
+    for (int source : sources) checkNode(source);
+
+    std::vector<std::unique_ptr<BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph>>> solvers(numThreads_);
+    std::vector<Buffer> buffers(numThreads_);
+    for (int t = 0; t < numThreads_; t++) {
+      solvers[t] = std::make_unique<BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph>>(&reweighted_);
+      buffers[t].dist.resize(N_);
+      buffers[t].prev.resize(N_);
+    }
+
+    ThreadPool pool(numThreads_);
+    pool.parallelFor(0, sources.size(), [&](int i, int threadId) {
+      int source = sources[i];
+      auto& solver = *solvers[threadId];
+      Buffer& buffer = buffers[threadId];
+      solver.solve(source);
+      for (int v = 0; v < N_; v++) {
+        double dist = solver.getDistance(v);
+        buffer.dist[v] = dist == inf ? inf : dist - potential_[source] + potential_[v];
+        buffer.prev[v] = solver.getPrev(v);
+      }
+      callback(source, buffer.dist, buffer.prev);
+    });
+  }
+
+
+  // Solves all nodes as sources.
+  void solve(const Callback& callback) {
+    std::vector<int> sources(N_);
+    for (int u = 0; u < N_; u++) sources[u] = u;
+    solve(sources, callback);
+  }
+
+
+  // The full V x V distance matrix, for graphs small enough to hold it.
+  std::vector<std::vector<double>> getApspMatrix() {
+    std::vector<std::vector<double>> matrix(N_);
+    solve([&](int source, const std::vector<double>& dist, const std::vector<int>&) {
+      matrix[source] = dist;
+    });
+    return matrix;
+  }
+
+
+  // Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive.
+  //
+  // @return An array of node indexes of the shortest path from 'start' to 'end'. If 'start' and
+  //     'end' are not connected then an empty array is returned.
+  //
+  std::list<int> reconstructPath(int start, int end) {
+    checkNode(start);
+    checkNode(end);
+    BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph> solver(&reweighted_);
+    return solver.reconstructPath(start, end);
+  }
+
+};
+
+using JohnsonsAllPairsShortestPath = BasicJohnsonsAllPairsShortestPath<Graph>;
+
+
+
+// Example usage of JohnsonsAllPairsShortestPath
+int JohnsonsAllPairsShortestPath_test()
+{
+  Graph graph(5);
+
+  graph.addDirectedEdge(0, 1, 4);
+  graph.addDirectedEdge(0, 2, 1);
+  graph.addDirectedEdge(2, 1, -2);
+  graph.addDirectedEdge(1, 3, 2);
+  graph.addDirectedEdge(3, 4, -1);
+  graph.addDirectedEdge(4, 2, 3);
+
+  JohnsonsAllPairsShortestPath solver(&graph, 2);
+  std::vector<std::vector<double>> dist = solver.getApspMatrix();
+
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) std::cout << dist[i][j] << " ";
+    std::cout << std::endl;
+  }
+  // Prints:
+  // 0 -1 1 1 0
+  // inf 0 4 2 1
+  // inf -2 0 0 -1
+  // inf 0 2 0 -1
+  // inf 1 3 3 0
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_JOHNSONSALLPAIRSSHORTESTPATH_H */
@@ -0,0 +1,466 @@
+/*
+ * @file   ParallelSccSolver.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Parallel strongly connected components with trimming, forward-backward and coloring.
+ *
+ * The solver follows the Multistep method of Slota, Rajamanickam and Madduri:
+ *
+ *   1. Trim: a node without incoming or without outgoing edges (among the nodes left) is an
+ *      SCC of its own. Removing it can expose more such nodes, so trimming runs as a parallel
+ *      work list until none is left.
+ *   2. Forward-backward: the SCC of a pivot is the intersection of the nodes it reaches and
+ *      the nodes which reach it. With a high degree pivot this peels the giant component of
+ *      most real graphs in two parallel BFS.
+ *   3. Coloring: every node takes the largest node id which reaches it by propagating ids
+ *      along the edges until nothing changes. A node r which keeps its own color is the
+ *      largest of its SCC, and the SCC of r are the nodes of color r which reach r, found by a
+ *      backward search inside the color. Every color is processed in parallel and the rounds
+ *      repeat on the nodes left.
+ *   4. Once few nodes are left they are solved by the serial TarjanSccSolverAdjacencyList.
+ *
+ * Component ids follow the convention of TarjanSccSolverAdjacencyList::getComponentIds(): they
+ * are dense in [0, sccCount()) and every edge between two components goes to the lower id, so
+ * sccCount() - 1, ..., 0 is a topological order of the condensation. The ids do not depend on
+ * the number of threads: components are numbered by the post order of a depth first search on
+ * the condensation which starts from the components in order of their lowest node.
+ */
+
+#ifndef D_GRAPH_PARALLELSCCSOLVER_H
+#define D_GRAPH_PARALLELSCCSOLVER_H
+
+#include <Graph.h>
+#include <CsrGraph.h>
+#include <ThreadPool.h>
+#include <TarjanSccSolverAdjacencyList.h>
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <functional>
+
+#include <memory>
+#include <iostream>
+#include <atomic>
+#include <stdexcept>
+
+namespace dsa {
+
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicParallelSccSolver {
+private:
+  static constexpr int GRAIN = 256;
+  const int UNASSIGNED = -1;
+
+  // Nodes found by one thread.
+  using Buffer = NodeBuffer;
+
+  const GRAPH *graph_;
+  int N_, numThreads_;
+
+  // Below this many nodes left the rest is solved serially.
+  int serialThreshold_;
+
+  bool solved_;
+  int sccCount_;
+  std::vector<int> ids_;
+  CsrGraph condensation_;
+
+  // State of the solve: label_[v] is a node of the component of v, or
+  // UNASSIGNED, and active_ holds the nodes which are not assigned yet.
+  std::unique_ptr<ThreadPool> pool_;
+  CsrGraph reverse_;
+  std::vector<std::atomic<int>> label_, inDegree_, outDegree_, color_;
+  std::vector<std::atomic<unsigned char>> mark_;
+  std::vector<Buffer> buffers_;
+  std::vector<int> active_;
+
+
+  bool assigned(int node) const {
+    return label_[node].load(std::memory_order_relaxed) != UNASSIGNED;
+  }
+
+
+  // Assigns 'node' to the component labelled 'label' unless it is assigned
+  // already. Returns true if this call assigned it.
+  bool assign(int node, int label) {
+    int unassigned = UNASSIGNED;
+    return label_[node].compare_exchange_strong(unassigned, label, std::memory_order_relaxed);
+  }
+
+
+  void gather(std::vector<int>& nodes) {
+    nodes.clear();
+    for (auto& buffer : buffers_) {
+      nodes.insert(nodes.end(), buffer.nodes.begin(), buffer.nodes.end());
+      buffer.nodes.clear();
+    }
+  }
+
+
+  void removeAssigned() {
+    active_.erase(std::remove_if(active_.begin(), active_.end(),
+                                 [&](int node) { return assigned(node); }), active_.end());
+  }
+
+
+  // Removes the nodes without incoming or outgoing edges among the active
+  // nodes, repeatedly. Self loops are not counted.
+  void trim() {
+    pool_->parallelFor(0, active_.size(), [&](int i, int) {
+      int u = active_[i], out = 0;
+      for (auto edge: graph_->edges(u)) {
+        int v = edge.first;
+        if (v == u || assigned(v)) continue;
+        out++;
+        inDegree_[v].fetch_add(1, std::memory_order_relaxed);
+      }
+      outDegree_[u].store(out, std::memory_order_relaxed);
+    }, GRAIN);
+
+    std::vector<int> work;
+    for (int u : active_)
+      if (inDegree_[u].load(std::memory_order_relaxed) == 0 || outDegree_[u].load(std::memory_order_relaxed) == 0)
+        work.push_back(u);
+    for (int u : work) assign(u, u);
+
+    while (!work.empty()) {
+      pool_->parallelFor(0, work.size(), [&](int i, int threadId) {
+        int u = work[i];
+        for (auto edge: graph_->edges(u)) {
+          int v = edge.first;
+          if (v != u && !assigned(v) && inDegree_[v].fetch_sub(1, std::memory_order_relaxed) == 1 && assign(v, v))
+            buffers_[threadId].nodes.push_back(v);
+        }
+        for (auto edge: reverse_.edges(u)) {
+          int v = edge.first;
+          if (v != u && !assigned(v) && outDegree_[v].fetch_sub(1, std::memory_order_relaxed) == 1 && assign(v, v))
+            buffers_[threadId].nodes.push_back(v);
+        }
+      }, GRAIN);
+      gather(work);
+    }
+    removeAssigned();
+  }
+
+
+  // Marks every active node reachable from 'source' in 'graph' (restricted to
+  // nodes with mark_ == 'from') by raising its mark to 'from' + 1.
+  template <typename G>
+  void reach(const G& graph, int source, unsigned char from) {
+    std::vector<int> frontier{source};
+    mark_[source].store(from + 1, std::memory_order_relaxed);
+    while (!frontier.empty()) {
+      pool_->parallelFor(0, frontier.size(), [&](int i, int threadId) {
+        for (auto edge: graph.edges(frontier[i])) {
+          int v = edge.first;
+          unsigned char expected = from;
+          if (!assigned(v) && mark_[v].load(std::memory_order_relaxed) == from &&
+              mark_[v].compare_exchange_strong(expected, from + 1, std::memory_order_relaxed))
+            buffers_[threadId].nodes.push_back(v);
+        }
+      }, GRAIN);
+      gather(frontier);
+    }
+  }
+
+
+  // Assigns the SCC of a high degree pivot: the nodes it reaches which reach it.
+  void forwardBackward() {
+    int pivot = active_[0];
+    long long best = -1;
+    for (int u : active_) {
+      long long degree = (long long)(inDegree_[u].load(std::memory_order_relaxed) + 1) *
+                         (outDegree_[u].load(std::memory_order_relaxed) + 1);
+      if (degree > best) {
+        best = degree;
+        pivot = u;
+      }
+    }
+
+    for (int u : active_) mark_[u].store(0, std::memory_order_relaxed);
+    reach(*graph_, pivot, 0);
+    reach(reverse_, pivot, 1);
+    for (int u : active_)
+      if (mark_[u].load(std::memory_order_relaxed) == 2) label_[u].store(pivot, std::memory_order_relaxed);
+    removeAssigned();
+  }
+
+
+  // One coloring round, assigns at least the SCC of the largest active node.
+  void coloring() {
+    for (int u : active_) {
+      color_[u].store(u, std::memory_order_relaxed);
+      mark_[u].store(1, std::memory_order_relaxed); // In the work list.
+    }
+
+    // Propagate the largest color along the edges until nothing changes.
+    std::vector<int> work(active_);
+    while (!work.empty()) {
+      pool_->parallelFor(0, work.size(), [&](int i, int threadId) {
+        int u = work[i];
+        // Sequentially consistent with the raise below: either the raising
+        // thread queues u again or this load sees the raised color.
+        mark_[u].store(0);
+        int c = color_[u].load();
+        for (auto edge: graph_->edges(u)) {
+          int v = edge.first;
+          if (assigned(v)) continue;
+          int current = color_[v].load(std::memory_order_relaxed);
+          bool raised = false;
+          while (current < c && !(raised = color_[v].compare_exchange_weak(current, c)));
+          unsigned char idle = 0;
+          if (raised && mark_[v].compare_exchange_strong(idle, 1))
+            buffers_[threadId].nodes.push_back(v);
+        }
+      }, GRAIN);
+      gather(work);
+    }
+
+    // The SCC of every root: the nodes of its color which reach it.
+    std::vector<int> roots;
+    for (int u : active_)
+      if (color_[u].load(std::memory_order_relaxed) == u) roots.push_back(u);
+
+    pool_->parallelFor(0, roots.size(), [&](int i, int threadId) {
+      int root = roots[i];
+      std::vector<int>& stack = buffers_[threadId].nodes;
+      label_[root].store(root, std::memory_order_relaxed);
+      stack.push_back(root);
+      while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+        for (auto edge: reverse_.edges(u)) {
+          int v = edge.first;
+          // Only this root's task touches the nodes of its color.
+          if (color_[v].load(std::memory_order_relaxed) != root || assigned(v)) continue;
+          label_[v].store(root, std::memory_order_relaxed);
+          stack.push_back(v);
+        }
+      }
+    });
+    removeAssigned();
+  }
+
+
+  // Solves the active nodes with the serial solver on their induced subgraph.
+  void serial() {
+    if (active_.empty()) return;
+    std::vector<int> local(N_, -1);
+    for (unsigned i = 0; i < active_.size(); i++) local[active_[i]] = i;
+
+    std::vector<Edge> edges;
+    for (unsigned i = 0; i < active_.size(); i++)
+      for (auto edge: graph_->edges(active_[i]))
+        if (local[edge.first] != -1) edges.push_back({(int)i, local[edge.first], 0});
+    CsrGraph induced(active_.size(), edges);
+
+    BasicTarjanSccSolverAdjacencyList<CsrGraph> tarjan(&induced);
+    const std::vector<int>& ids = tarjan.getComponentIds();
+    std::vector<int> labelOf(tarjan.sccCount(), UNASSIGNED);
+    for (unsigned i = 0; i < active_.size(); i++) {
+      if (labelOf[ids[i]] == UNASSIGNED) labelOf[ids[i]] = active_[i];
+      label_[active_[i]].store(labelOf[ids[i]], std::memory_order_relaxed);
+    }
+    active_.clear();
+  }
+
+
+  // Numbers the components by the post order of a depth first search on the
+  // condensation, started from the components in order of their lowest node,
+  // and keeps the condensation relabelled by those numbers.
+  void number() {
+    std::vector<int> order(N_, UNASSIGNED), first(N_);
+    sccCount_ = 0;
+    for (int u = 0; u < N_; u++) {
+      int label = label_[u].load(std::memory_order_relaxed);
+      if (order[label] == UNASSIGNED) order[label] = sccCount_++;
+      first[u] = order[label];
+    }
+    CsrGraph dag = CsrGraph::condensationOf(*graph_, first, sccCount_);
+
+    std::vector<int> post(sccCount_, UNASSIGNED), next(sccCount_, 0), stack;
+    const std::vector<int>& offsets = dag.offsets();
+    const std::vector<int>& targets = dag.targets();
+    int count = 0;
+    for (int c = 0; c < sccCount_; c++) {
+      if (post[c] != UNASSIGNED) continue;
+      post[c] = -2; // On the stack.
+      stack.push_back(c);
+      while (!stack.empty()) {
+        int at = stack.back();
+        if (offsets[at] + next[at] < offsets[at + 1]) {
+          int to = targets[offsets[at] + next[at]++];
+          if (post[to] == UNASSIGNED) {
+            post[to] = -2;
+            stack.push_back(to);
+          }
+        } else {
+          post[at] = count++;
+          stack.pop_back();
+        }
+      }
+    }
+
+    ids_.resize(N_);
+    for (int u = 0; u < N_; u++) ids_[u] = post[first[u]];
+
+    // Node c of the condensation lists its edges in the order they are first
+    // seen among the nodes of c, which the relabelling keeps.
+    std::vector<int> component(sccCount_);
+    for (int c = 0; c < sccCount_; c++) component[post[c]] = c;
+    const std::vector<double>& weights = dag.weights();
+    std::vector<Edge> edges;
+    edges.reserve(dag.edgeCount());
+    for (int id = 0; id < sccCount_; id++) {
+      int c = component[id];
+      for (int i = offsets[c]; i < offsets[c + 1]; i++) edges.push_back({id, post[targets[i]], weights[i]});
+    }
+    condensation_ = CsrGraph(sccCount_, edges);
+  }
+
+
+  void solve() {
+    if (solved_) return;
+    pool_ = std::make_unique<ThreadPool>(numThreads_);
+    reverse_ = CsrGraph::reverseOf(*graph_, *pool_);
+    label_ = std::vector<std::atomic<int>>(N_);
+    inDegree_ = std::vector<std::atomic<int>>(N_);
+    outDegree_ = std::vector<std::atomic<int>>(N_);
+    color_ = std::vector<std::atomic<int>>(N_);
+    mark_ = std::vector<std::atomic<unsigned char>>(N_);
+    buffers_ = std::vector<Buffer>(numThreads_);
+    for (int u = 0; u < N_; u++) {
+      label_[u].store(UNASSIGNED, std::memory_order_relaxed);
+      inDegree_[u].store(0, std::memory_order_relaxed);
+    }
+    active_.resize(N_);
+    for (int u = 0; u < N_; u++) active_[u] = u;
+
+    trim();
+    if ((int)active_.size() > serialThreshold_) forwardBackward();
+    while ((int)active_.size() > serialThreshold_) coloring();
+    serial();
+    number();
+
+    pool_ = nullptr;
+    reverse_ = CsrGraph(0, std::vector<Edge>());
+    label_ = std::vector<std::atomic<int>>();
+    inDegree_ = std::vector<std::atomic<int>>();
+    outDegree_ = std::vector<std::atomic<int>>();
+    color_ = std::vector<std::atomic<int>>();
+    mark_ = std::vector<std::atomic<unsigned char>>();
+    buffers_.clear();
+    solved_ = true;
+  }
+
+public:
+  BasicParallelSccSolver(const BasicParallelSccSolver&) = delete;
+  BasicParallelSccSolver& operator=(BasicParallelSccSolver const&) = delete;
+
+  // @param numThreads - The number of threads the solver runs on.
+  BasicParallelSccSolver(const GRAPH *graph, int numThreads = ThreadPool::hardwareThreads())
+    : condensation_(0, std::vector<Edge>()), reverse_(0, std::vector<Edge>()) {
+    if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
+    if (graph->size() == 0) throw std::invalid_argument("GRAPH Empty");
+    if (numThreads <= 0) throw std::invalid_argument("numThreads <= 0");
+    graph_ = graph;
+    N_ = graph->size();
+    numThreads_ = numThreads;
+    serialThreshold_ = 4096;
+    solved_ = false;
+    sccCount_ = 0;
+  }
+
+
+  const GRAPH& operator()() {
+    return *graph_;
+  }
+
+
+  // Sets the number of nodes left below which the serial solver takes over,
+  // 0 runs the parallel phases to the end.
+  void setSerialThreshold(int nodes) {
+    if (nodes < 0) throw std::invalid_argument("nodes < 0");
+    if (solved_) throw std::logic_error("Already solved");
+    serialThreshold_ = nodes;
+  }
+
+
+  // Returns the number of strongly connected components in the graph.
+  int sccCount() {
+    if (!solved_) solve();
+    return sccCount_;
+  }
+
+
+  // Get the component id of every node, ids are in [0, sccCount()). Two
+  // nodes are in the same SCC if they have the same id, and if there is an
+  // edge from component a to another component b then a > b.
+  const std::vector<int>& getComponentIds() {
+    if (!solved_) solve();
+    return ids_;
+  }
+
+
+  // Get the connected components of this graph as sets of nodes.
+  std::set<std::set<int>> getSccs() {
+    if (!solved_) solve();
+    std::vector<std::set<int>> sccs(sccCount_);
+    for (int u = 0; u < N_; u++) sccs[ids_[u]].insert(u);
+    return std::set<std::set<int>>(sccs.begin(), sccs.end());
+  }
+
+
+  // Get the condensation DAG, node c of which is the component with id c.
+  // It can be passed to BasicTopologicalSortAdjacencyList<CsrGraph> as is.
+  const CsrGraph& condensation() {
+    if (!solved_) solve();
+    return condensation_;
+  }
+
+};
+
+using ParallelSccSolver = BasicParallelSccSolver<Graph>;
+
+
+
+// Example usage of ParallelSccSolver
+int ParallelSccSolver_test()
+{
+  Graph graph(8);
+
+  graph.addDirectedEdge(6, 0);
+  graph.addDirectedEdge(6, 2);
+  graph.addDirectedEdge(3, 4);
+  graph.addDirectedEdge(6, 4);
+  graph.addDirectedEdge(2, 0);
+  graph.addDirectedEdge(0, 1);
+  graph.addDirectedEdge(4, 5);
+  graph.addDirectedEdge(5, 6);
+  graph.addDirectedEdge(3, 7);
+  graph.addDirectedEdge(7, 5);
+  graph.addDirectedEdge(1, 2);
+  graph.addDirectedEdge(7, 3);
+  graph.addDirectedEdge(5, 0);
+
+  ParallelSccSolver solver(&graph, 2);
+  std::cout << "Number of Strongly Connected Components: " << solver.sccCount() << std::endl;
+  TarjanSccSolverAdjacencyList::printSCCList(solver.getSccs());
+
+  CsrGraph dag = solver.condensation();
+  std::cout << "Condensation with " << dag.size() << " nodes and " << dag.edgeCount() << " edges" << std::endl;
+  // Prints:
+  // Number of Strongly Connected Components: 3
+  // Nodes: [0,1,2,] form a Strongly Connected Component.
+  // Nodes: [3,7,] form a Strongly Connected Component.
+  // Nodes: [4,5,6,] form a Strongly Connected Component.
+  // Condensation with 3 nodes and 2 edges
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_PARALLELSCCSOLVER_H */
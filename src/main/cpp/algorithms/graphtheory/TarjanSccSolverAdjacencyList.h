@@ -7,6 +7,13 @@
  * @brief   An implementation of Tarjan's Strongly Connected Components algorithm using an adjacency list.
  * Time complexity: O(V+E)
  *
+ * The solver below runs Pearce's space efficient variant ("A space-efficient algorithm for
+ * finding strongly connected components", 2016) with an explicit stack instead of recursion.
+ * A single array rindex replaces ids, low and onStack: it holds the visit index of an active
+ * node, lowered to the lowest index reachable from it, and once a component is complete its
+ * nodes get a value above every visit index still in use. The pseudocode of the classic
+ * algorithm follows.
+ *
  * UNVISITED = -1
  * n = number of nodes in graph
  * g = adjacency list with directed edges
@@ -60,6 +67,7 @@
 #include <numeric>    // some numeric algorithm
 #include <functional>
 #include <stack>
+#include <utility>
 
 #include <sstream>
 #include <memory>
@@ -71,79 +79,128 @@
 namespace dsa {
 
 
-class TarjanSccSolverAdjacencyList {
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicTarjanSccSolverAdjacencyList {
 public:
   using SCC_LIST = std::unordered_map<int, std::set<int>>;
 private:
   const double POSITIVE_INFINITY = std::numeric_limits<double>::infinity();
   const double NEGATIVE_INFINITY = -std::numeric_limits<double>::infinity();
-  const int UNVISITED = -1;
+  const int UNVISITED = 0;
+
+  using EDGE_ITERATOR = decltype(std::declval<const GRAPH&>().edges(0).begin());
+
+  // A node of the explicit depth first search stack: the node, its next edge
+  // to look at and whether it is still the root of its component.
+  struct Frame {
+    int node;
+    EDGE_ITERATOR next, end;
+    bool root;
+  };
 
-  Graph *graph_;
+  const GRAPH *graph_;
   unsigned N_;
 
   bool solved_;
-  int sccCount_, id_;
-  std::vector<bool> onStack_;
-  std::vector<int> ids_, low_;
-  std::stack<int> stack_;
+  int sccCount_, index_, component_;
+
+  // Pearce's rindex: the visit index of an active node, or the lowest index
+  // reachable from it, and N - 1 - (component id) once its component is done.
+  std::vector<int> rindex_;
+  std::vector<int> ids_;
+  std::vector<int> stack_;
+  std::vector<Frame> callStack_;
 
   void solve() {
     if (solved_) return;
-    for (unsigned i = 0; i < N_; i++) if (ids_[i] == UNVISITED) dfs(i);
+    index_ = 1;
+    component_ = N_ - 1;
+    for (unsigned i = 0; i < N_; i++) if (rindex_[i] == UNVISITED) dfs(i);
+    sccCount_ = N_ - 1 - component_;
+
+    // Components are numbered in the order they are completed, which is a
+    // reverse topological order of the condensation.
+    ids_.resize(N_);
+    for (unsigned i = 0; i < N_; i++) ids_[i] = N_ - 1 - rindex_[i];
+    std::vector<int>().swap(rindex_);
+    std::vector<int>().swap(stack_);
+    std::vector<Frame>().swap(callStack_);
     solved_ = true;
   }
 
 
-  void dfs(int at) {
-    stack_.push(at);
-    onStack_[at] = true;
-    ids_[at] = low_[at] = id_++;
+  void beginVisit(int at) {
+    rindex_[at] = index_++;
+    auto&& edges = graph_->edges(at);
+    callStack_.push_back({at, edges.begin(), edges.end(), true});
+  }
 
-    auto graphItr = (*graph_)()->find(at);
-    if (graphItr != (*graph_)()->end()) {
-      if (!graphItr->second.empty()) {
-        for (auto edge: graphItr->second) {
-          if (ids_[edge.first] == UNVISITED) dfs(edge.first);
-          if (onStack_[edge.first]) low_[at] = std::min(low_[at], low_[edge.first]);
-        }
-      }
+
+  // Called once every edge of 'at' has been looked at.
+  void finishVisit(int at, bool root) {
+    if (!root) {
+      stack_.push_back(at);
+      return;
+    }
+    // 'at' is the first node of its component, every node of the component
+    // which is still on the stack has a visit index not below its own.
+    index_--;
+    while (!stack_.empty() && rindex_[at] <= rindex_[stack_.back()]) {
+      rindex_[stack_.back()] = component_;
+      stack_.pop_back();
+      index_--;
     }
+    rindex_[at] = component_--;
+  }
+
+
+  // Pearce's variant of Tarjan's algorithm with an explicit stack, so the
+  // search depth is only limited by memory.
+  void dfs(int start) {
+    beginVisit(start);
+    while (!callStack_.empty()) {
+      Frame& frame = callStack_.back();
+      if (frame.next == frame.end) {
+        int at = frame.node;
+        finishVisit(at, frame.root);
+        callStack_.pop_back();
+        continue;
+      }
 
-    // On recursive callback, if we're at the root node (start of SCC)
-    // empty the seen stack until back to root.
-    if (ids_[at] == low_[at]) {
-      while (!stack_.empty()) {
-        int node = stack_.top();
-        stack_.pop();
-        onStack_[node] = false;
-        low_[node] = ids_[at];
-        if (node == at) break;
+      int to = (*frame.next).first;
+      if (rindex_[to] == UNVISITED) {
+        // The edge is looked at again once 'to' is finished.
+        beginVisit(to);
+        continue;
+      }
+      if (rindex_[to] < rindex_[frame.node]) {
+        rindex_[frame.node] = rindex_[to];
+        frame.root = false;
       }
-      sccCount_++;
+      ++frame.next;
     }
   }
 
 public:
-  TarjanSccSolverAdjacencyList(const TarjanSccSolverAdjacencyList&) = delete;
-  TarjanSccSolverAdjacencyList& operator=(TarjanSccSolverAdjacencyList const&) = delete;
+  BasicTarjanSccSolverAdjacencyList(const BasicTarjanSccSolverAdjacencyList&) = delete;
+  BasicTarjanSccSolverAdjacencyList& operator=(BasicTarjanSccSolverAdjacencyList const&) = delete;
 
-  TarjanSccSolverAdjacencyList(Graph *graph) {
+  BasicTarjanSccSolverAdjacencyList(const GRAPH *graph) {
     if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
     N_ = graph->size();
     if (N_ == 0) throw std::invalid_argument("GRAPH Empty");
     graph_ = graph;
 
-    low_.resize(N_, -1); // Low link values
-    ids_.resize(N_, UNVISITED); // Nodes ids
-    onStack_.resize(N_, false);
-    id_ = 0;
+    rindex_.resize(N_, UNVISITED);
+    index_ = 1;
+    component_ = N_ - 1;
     solved_ = false;
     sccCount_ = 0;
   }
 
 
-  const Graph& operator()() {
+  const GRAPH& operator()() {
     return *graph_;
   }
 
@@ -155,30 +212,23 @@ public:
   }
 
 
-  // Get the connected components of this graph. If two indexes
-  // have the same value then they're in the same SCC.
-  std::set<std::set<int>> getSccs() {
+  // Get the component id of every node, ids are in [0, sccCount()). Two
+  // nodes are in the same SCC if they have the same id, and if there is an
+  // edge from component a to another component b then a > b.
+  const std::vector<int>& getComponentIds() {
     if (!solved_) solve();
+    return ids_;
+  }
 
-    std::unordered_map<int, std::set<int>> sccMAP;
-    std::set<std::set<int>> sccList;
 
-    for (unsigned i = 0; i < N_; i++) {
-      auto itr = sccMAP.find(low_[i]);
-      if (itr == sccMAP.end()) {
-    	sccMAP[low_[i]] = std::set<int>{};
-        itr = sccMAP.find(low_[i]);
-      }
-      itr->second.insert(i);
-    }
+  // Get the connected components of this graph as sets of nodes.
+  std::set<std::set<int>> getSccs() {
+    if (!solved_) solve();
 
-	for (auto scc : sccMAP) {
-	  if (!scc.second.empty()) {
-        sccList.insert(scc.second);
-	  }
-	}
+    std::vector<std::set<int>> sccs(sccCount_);
+    for (unsigned i = 0; i < N_; i++) sccs[ids_[i]].insert(i);
 
-    return std::move(sccList);
+    return std::set<std::set<int>>(sccs.begin(), sccs.end());
   }
 
 
@@ -195,6 +245,8 @@ public:
 
 };
 
+using TarjanSccSolverAdjacencyList = BasicTarjanSccSolverAdjacencyList<Graph>;
+
 
 
 // Example usage of TarjanScc
@@ -0,0 +1,160 @@
+/*
+ * @file   ThreadPool.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   A small fixed size thread pool used by the parallel graph solvers.
+ *
+ * The pool runs one job at a time on all of its threads, the calling thread
+ * taking part as thread 0, and returns once every thread has finished. This
+ * fits the bulk synchronous structure of the parallel solvers (one job per
+ * phase, level or round) without spawning threads for every phase.
+ *
+ * The jobs must not throw.
+ */
+
+#ifndef D_GRAPH_THREADPOOL_H
+#define D_GRAPH_THREADPOOL_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdexcept>
+
+namespace dsa {
+
+class ThreadPool
+{
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wake_, done_;
+  std::function<void(int)> job_;
+  unsigned long generation_;
+  int pending_;
+  bool stop_;
+
+
+  void workerLoop(int id) {
+    unsigned long seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) return;
+        seen = generation_;
+      }
+
+      job_(id);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) done_.notify_one();
+      }
+    }
+  }
+
+public:
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  // Creates a pool of 'numThreads' threads in total, including the calling
+  // thread. A pool of one thread runs every job inline.
+  explicit ThreadPool(int numThreads) {
+    if (numThreads <= 0) throw std::invalid_argument("numThreads <= 0");
+    generation_ = 0;
+    pending_ = 0;
+    stop_ = false;
+    for (int id = 1; id < numThreads; id++)
+      workers_.emplace_back(&ThreadPool::workerLoop, this, id);
+  }
+
+  virtual ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+  }
+
+
+  // The number of hardware threads, at least 1.
+  static int hardwareThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+
+  // Get number of threads
+  int size() const {
+    return workers_.size() + 1;
+  }
+
+
+  // Runs job(threadId) once on every thread of the pool and waits for all of
+  // them. Thread ids are in [0, size()).
+  void run(const std::function<void(int)>& job) {
+    if (workers_.empty()) {
+      job(0);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = job;
+      pending_ = workers_.size();
+      generation_++;
+    }
+    wake_.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_ == 0; });
+  }
+
+
+  // Calls fn(i, threadId) for every i in [begin, end). Indexes are handed out
+  // dynamically in chunks of 'grain' so uneven work items balance out.
+  template <typename F>
+  void parallelFor(int begin, int end, F fn, int grain = 1) {
+    if (begin >= end) return;
+    grain = std::max(1, grain);
+    std::atomic<int> next(begin);
+    run([&](int threadId) {
+      for (;;) {
+        int from = next.fetch_add(grain);
+        if (from >= end) break;
+        int to = std::min(end, from + grain);
+        for (int i = from; i < to; i++) fn(i, threadId);
+      }
+    });
+  }
+
+};
+
+
+// Data of one thread, kept in a std::vector indexed by thread id. The tail
+// padding of a whole cache line keeps the data of two threads off a common
+// cache line wherever the storage of the vector starts. alignas on T would
+// not: std::allocator ignores over-alignment before C++17.
+template <typename T>
+struct PerThread : T {
+  char padding_[64];
+};
+
+
+// Nodes found by one thread, e.g. its part of the next frontier.
+struct NodeList {
+  std::vector<int> nodes;
+};
+
+using NodeBuffer = PerThread<NodeList>;
+
+} // namespace dsa
+
+#endif /* D_GRAPH_THREADPOOL_H */
@@ -41,6 +41,32 @@
  *       dfs(edge.to, V, visitedNodes, graph)
  *
  *   visitedNodes.add(at)
+ *
+ *
+ * Kahn's algorithm processes the DAG in waves instead: wave 0 holds the nodes without
+ * incoming edges and wave k + 1 the nodes whose last incoming edge comes from wave k. The
+ * nodes of one wave do not depend on each other, so the level of a node (its wave) tells
+ * which tasks can run concurrently. Each wave is expanded in parallel with atomic in degree
+ * decrements, the thread which drops an in degree to zero appends the node to its own buffer:
+ *
+ * function kahn(graph):
+ *   inDegree = in degrees of all nodes
+ *   wave = [nodes with inDegree 0], level = 0
+ *   while wave is not empty:
+ *     for u in wave (in parallel):
+ *       levels[u] = level
+ *       for edge in graph.getEdgesOutFromNode(u):
+ *         if atomicDecrement(inDegree[edge.to]) == 0: next.add(edge.to)
+ *     ordering.addAll(wave), wave = sorted(next), level = level + 1
+ *   # Nodes never reaching in degree 0 lie on or behind a cycle.
+ *   return ordering
+ *
+ * The critical path mode raises, while a wave is expanded, the longest path known to end at the
+ * target of every edge to the path through the edge, with a compare-and-swap maximum. All tails
+ * of the incoming edges of a node lie in earlier waves, so its longest path is final once its
+ * own wave is reached, and no reverse graph is needed. The predecessors are found afterwards by
+ * one parallel pass over the edges: the predecessor of v is the lowest numbered u with an edge
+ * u -> v which ends a longest path at v, so it does not depend on the thread timing.
  */
 
 
@@ -48,6 +74,8 @@
 #define D_GRAPH_TOPOLOGICALSORT_H
 
 #include <Graph.h>
+#include <CsrGraph.h>
+#include <ThreadPool.h>
 
 #include <vector>
 #include <deque>
@@ -67,27 +95,123 @@
 #include <iostream>
 #include <limits>
 #include <cassert>
+#include <atomic>
+#include <climits>
+#include <stdexcept>
 
 namespace dsa {
 
-class TopologicalSortAdjacencyList
+// GRAPH is a graph type with the interface described in CsrGraph.h.
+template <typename GRAPH>
+class BasicTopologicalSortAdjacencyList
 {
 
 private:
-  Graph *graph_;
+  const GRAPH *graph_;
   unsigned n_;
 
+  // Pool of the parallel sort, kept between calls on the same number of threads.
+  std::unique_ptr<ThreadPool> pool_;
+
+  // Nodes of the next wave found by one thread.
+  using Buffer = NodeBuffer;
+
+
+  // Atomically sets 'value' to the larger of its value and 'candidate'.
+  template <typename T>
+  static void raise(std::atomic<T>& value, T candidate) {
+    T current = value.load(std::memory_order_relaxed);
+    while (candidate > current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed));
+  }
+
+
+  // Kahn's algorithm on 'numThreads' threads. Fills the ordering and the
+  // level of every node, and if 'dist' is not null the longest path ending at
+  // every node, with its predecessor on that path in 'prev' if that is not null.
+  void kahn(int numThreads, std::vector<int>& ordering, std::vector<int>& level,
+            std::vector<double> *dist, std::vector<int> *prev) {
+    if (numThreads <= 0) throw std::invalid_argument("numThreads <= 0");
+    if (!pool_ || pool_->size() != numThreads) pool_ = std::make_unique<ThreadPool>(numThreads);
+
+    std::vector<std::atomic<int>> inDegree(n_);
+    for (auto& d : inDegree) d.store(0, std::memory_order_relaxed);
+    pool_->parallelFor(0, n_, [&](int u, int) {
+      for (auto edge: graph_->edges(u)) inDegree[edge.first].fetch_add(1, std::memory_order_relaxed);
+    }, 1024);
+
+    // Longest path known to end at every node, 0 for the nodes of wave 0.
+    std::vector<std::atomic<double>> longest(dist != nullptr ? n_ : 0);
+    if (dist != nullptr) {
+      for (unsigned u = 0; u < n_; u++) {
+        bool first = inDegree[u].load(std::memory_order_relaxed) == 0;
+        longest[u].store(first ? 0 : -std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+      }
+    }
+
+    ordering.clear();
+    ordering.reserve(n_);
+    level.assign(n_, -1);
+    std::vector<int> wave;
+    for (unsigned u = 0; u < n_; u++) if (inDegree[u].load(std::memory_order_relaxed) == 0) wave.push_back(u);
+    std::vector<Buffer> buffers(numThreads);
+
+    for (int depth = 0; !wave.empty(); depth++) {
+      pool_->parallelFor(0, wave.size(), [&](int i, int threadId) {
+        int u = wave[i];
+        level[u] = depth;
+        double length = dist != nullptr ? longest[u].load(std::memory_order_relaxed) : 0;
+        for (auto edge: graph_->edges(u)) {
+          if (dist != nullptr) raise(longest[edge.first], length + edge.second);
+          if (inDegree[edge.first].fetch_sub(1, std::memory_order_relaxed) == 1)
+            buffers[threadId].nodes.push_back(edge.first);
+        }
+      }, 256);
+
+      ordering.insert(ordering.end(), wave.begin(), wave.end());
+      wave.clear();
+      for (auto& buffer : buffers) {
+        wave.insert(wave.end(), buffer.nodes.begin(), buffer.nodes.end());
+        buffer.nodes.clear();
+      }
+      // The order within a wave does not depend on the thread timing.
+      std::sort(wave.begin(), wave.end());
+    }
+
+    if (ordering.size() != n_) throw std::invalid_argument("GRAPH has a cycle");
+    if (dist == nullptr) return;
+    dist->resize(n_);
+    for (unsigned u = 0; u < n_; u++) (*dist)[u] = longest[u].load(std::memory_order_relaxed);
+    if (prev == nullptr) return;
+
+    // The predecessor of v is the lowest numbered u whose edge ends a longest
+    // path at v, found as -max(-u) over the tight edges.
+    std::vector<std::atomic<int>> predecessor(n_);
+    for (auto& p : predecessor) p.store(INT_MIN, std::memory_order_relaxed);
+    pool_->parallelFor(0, n_, [&](int u, int) {
+      double length = longest[u].load(std::memory_order_relaxed);
+      for (auto edge: graph_->edges(u))
+        if (length + edge.second == longest[edge.first].load(std::memory_order_relaxed))
+          raise(predecessor[edge.first], -u);
+    }, 1024);
+
+    prev->resize(n_);
+    for (unsigned u = 0; u < n_; u++) {
+      int p = predecessor[u].load(std::memory_order_relaxed);
+      (*prev)[u] = p == INT_MIN ? -1 : -p;
+    }
+  }
+
 public:
-  TopologicalSortAdjacencyList(Graph *graph) {
+  BasicTopologicalSortAdjacencyList(const GRAPH *graph) {
     if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
 	n_ = graph->size();
     graph_ = graph;
   }
 
-  TopologicalSortAdjacencyList(const TopologicalSortAdjacencyList&) = delete;
-  TopologicalSortAdjacencyList& operator=(TopologicalSortAdjacencyList const&) = delete;
+  BasicTopologicalSortAdjacencyList(const BasicTopologicalSortAdjacencyList&) = delete;
+  BasicTopologicalSortAdjacencyList& operator=(BasicTopologicalSortAdjacencyList const&) = delete;
 
-  const Graph& operator()() {
+  const GRAPH& operator()() {
     return *graph_;
   }
 
@@ -105,13 +229,8 @@ private:
 
     visited.at(at) = true;
 
-    auto graphItr = (*graph_)()->find(at);
-    if (graphItr != (*graph_)()->end()) {
-      if (!graphItr->second.empty()){
-        for (auto edge: graphItr->second){
-          if (!visited[edge.first]) i = dfs(i, edge.first, visited, ordering);
-        }
-      }
+    for (auto edge: graph_->edges(at)) {
+      if (!visited[edge.first]) i = dfs(i, edge.first, visited, ordering);
     }
 
     ordering[i] = at;
@@ -156,15 +275,10 @@ public:
       int nodeIndex = topsort[i];
       if (dist[nodeIndex] != -1) {
 
-        auto adjacentEdges = (*graph_)()->find(nodeIndex);
-        if (adjacentEdges != (*graph_)()->end()) {
-          if (!adjacentEdges->second.empty()) {
-            for (auto edge: adjacentEdges->second) {
-              int newDist = dist[nodeIndex] + static_cast<int>(edge.second);
-              if (dist[edge.first] == -1) dist[edge.first] = newDist;
-              else dist[edge.first] = std::min(dist[edge.first], newDist);
-            }
-          }
+        for (auto edge: graph_->edges(nodeIndex)) {
+          int newDist = dist[nodeIndex] + static_cast<int>(edge.second);
+          if (dist[edge.first] == -1) dist[edge.first] = newDist;
+          else dist[edge.first] = std::min(dist[edge.first], newDist);
         }
       }
     }
@@ -172,8 +286,47 @@ public:
     return dist;
   }
 
+
+  // Finds a topological ordering with Kahn's algorithm, expanding each wave of
+  // nodes on 'numThreads' threads. The ordering lists the nodes wave by wave,
+  // each wave in ascending node order. If 'levels' is not null it receives the
+  // wave of every node: nodes on the same level can be processed concurrently.
+  // Throws if the graph has a cycle.
+  std::vector<int> topologicalSortKahn(std::vector<int> *levels = nullptr, int numThreads = 1) {
+    std::vector<int> ordering, level;
+    kahn(numThreads, ordering, level, nullptr, nullptr);
+    if (levels != nullptr) levels->swap(level);
+    return ordering;
+  }
+
+
+  // Critical path mode of topologicalSortKahn(): the cost of the longest path
+  // ending at every node, starting anywhere (0 for nodes without incoming
+  // edges). If 'prev' is not null it receives the predecessor of every node on
+  // such a path, -1 for its first node.
+  std::vector<double> dagLongestPath(std::vector<int> *prev = nullptr, int numThreads = 1) {
+    std::vector<int> ordering, level;
+    std::vector<double> dist;
+    kahn(numThreads, ordering, level, &dist, prev);
+    return dist;
+  }
+
+
+  // The critical path: a longest path of the DAG, as a list of nodes.
+  std::list<int> criticalPath(int numThreads = 1) {
+    std::list<int> path;
+    if (n_ == 0) return path;
+    std::vector<int> prev;
+    std::vector<double> dist = dagLongestPath(&prev, numThreads);
+    int at = std::max_element(dist.begin(), dist.end()) - dist.begin();
+    for (; at != -1; at = prev[at]) path.push_front(at);
+    return path;
+  }
+
 };
 
+using TopologicalSortAdjacencyList = BasicTopologicalSortAdjacencyList<Graph>;
+
 
 
 // Example usage of TopologicalSort
@@ -216,6 +369,26 @@ int topologicalSort_test()
   // is null since 6 is not reachable!
   std::cout << "Find the shortest path from 0 to 6: " << dists[6] << std::endl;
 
+  // Levels of concurrent tasks, prints: 0 1 2 3 4 1 0
+  std::vector<int> levels;
+  solver.topologicalSortKahn(&levels, 2);
+  {
+  std::stringstream ss;
+  for (auto level: levels) ss << " " << level;
+  std::cout << "Levels :" << ss.str() << std::endl;
+  }
+
+  // The critical path, prints: -> 0-> 1-> 2-> 4
+  std::list<int> critical = solver.criticalPath();
+  {
+  std::stringstream ss;
+  for (auto node: critical) {
+    ss << "-> ";
+    ss << node;
+  }
+  std::cout << "Critical path :" << ss.str() << std::endl;
+  }
+
   return 0;
 }
 
@@ -0,0 +1,516 @@
+/*
+ * @file   TspBranchAndBound.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   An exact branch and bound solver for the traveling salesman problem. It takes the same
+ * distance matrix as TspDynamicProgrammingIterative but its memory grows with O(n^3) instead of
+ * O(n * 2^n), which makes it usable for instances the DP solver can not hold in memory.
+ *
+ * The search is a depth first search over partial tours starting at the start node. Every
+ * search node keeps a reduced cost matrix (Little et al.): subtracting the minimum of every row
+ * and column from a matrix lowers the cost of every tour by the same amount, so the sum of the
+ * subtracted values is a lower bound on the cost of completing the partial tour. This bound does
+ * not require a symmetric matrix and remains valid with negative edge weights.
+ *
+ * For symmetric matrices the search additionally uses a 1-tree bound: the rest of the tour is a
+ * path from the last node through the unvisited nodes back to the start, which costs at least
+ * the minimum spanning tree of the unvisited nodes plus the cheapest edges connecting it to the
+ * last and to the start node. Before the search, node penalties pi are tuned with the Held-Karp
+ * subgradient method and all edges are searched with costs d[i][j] + pi[i] + pi[j]. This adds
+ * the constant 2 * sum(pi) to every tour but makes the 1-tree bounds much tighter.
+ *
+ * # m - the reduced matrix of the parent node, bound - its lower bound
+ * function search(path, m, bound):
+ *   if bound >= bestCost: return
+ *   if path visits every node:
+ *     bestCost = min(bestCost, cost(path) + m[last][start])
+ *     return
+ *   for next in unvisited nodes ordered by m[last][next]:
+ *     child = copy of m with row 'last' and column 'next' removed
+ *             and the edge (next, start) forbidden
+ *     search(path + next, child, bound + m[last][next] + reduce(child))
+ *
+ * The search starts with the tour of a nearest neighbour + 2-opt heuristic as its upper
+ * bound and can be limited by a node count or a time budget. When a limit is hit the best tour
+ * found so far is returned and isOptimal() reports false.
+ *
+ * Time Complexity: O(n! * n^2) worst case, typically far less thanks to pruning.
+ */
+
+#ifndef D_GRAPH_TSPBRANCHANDBOUND_H
+#define D_GRAPH_TSPBRANCHANDBOUND_H
+
+#include <vector>
+#include <list>
+#include <iterator>
+#include <algorithm>
+#include <numeric>    // some numeric algorithm
+#include <functional>
+
+#include <chrono>
+#include <sstream>
+#include <memory>
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+
+namespace dsa {
+
+class TspBranchAndBound {
+private:
+  const double POSITIVE_INFINITY = std::numeric_limits<double>::infinity();
+
+  // Bounds within this (relative) distance of the best tour are still
+  // explored so rounding errors in the reductions never prune the optimum.
+  const double EPS = 1e-9;
+
+  int N_, start_;
+  std::vector<std::vector<double>> distance_;
+
+  // Search costs cost_[i * N + j] = d[i][j] + pi[i] + pi[j], every tour
+  // costs exactly 'offset_' more than with the original distances.
+  bool symmetric_;
+  std::vector<double> pi_, cost_;
+  double offset_;
+
+  long long nodeLimit_, nodes_;
+  double timeLimit_;
+  std::chrono::steady_clock::time_point deadline_;
+  bool budgetExceeded_;
+
+  // Reduced cost matrix of every depth of the search, each N x N row-major.
+  std::vector<std::vector<double>> reduced_;
+  std::vector<int> path_;
+  std::vector<bool> visited_;
+
+  std::vector<int> bestPath_;
+  double bestCost_;
+  std::list<int> tour_;
+  bool ranSolver_;
+
+
+  double pathCost(const std::vector<int>& path) const {
+    double cost = 0;
+    for (int i = 1; i < N_; i++) cost += distance_[path[i - 1]][path[i]];
+    return cost + distance_[path[N_ - 1]][path[0]];
+  }
+
+
+  // Subtracts the minimum of every row and then of every column from the
+  // matrix and returns the sum of the subtracted values. Rows and columns
+  // with no finite entry left are ignored.
+  double reduce(std::vector<double>& m) const {
+    const int n = N_;
+    double total = 0;
+
+    for (int i = 0; i < n; i++) {
+      double *row = m.data() + (std::size_t)i * n;
+      double min = *std::min_element(row, row + n);
+      if (min == POSITIVE_INFINITY || min == 0) continue;
+      for (int j = 0; j < n; j++) row[j] -= min;
+      total += min;
+    }
+
+    for (int j = 0; j < n; j++) {
+      double min = POSITIVE_INFINITY;
+      for (int i = 0; i < n; i++) min = std::min(min, m[(std::size_t)i * n + j]);
+      if (min == POSITIVE_INFINITY || min == 0) continue;
+      for (int i = 0; i < n; i++) m[(std::size_t)i * n + j] -= min;
+      total += min;
+    }
+
+    return total;
+  }
+
+
+  // Prunes search nodes whose lower bound (in search costs) can not beat
+  // the best tour found so far.
+  bool canPrune(double bound) const {
+    bound -= offset_;
+    return bound - EPS * std::max(1.0, std::abs(bestCost_)) >= bestCost_;
+  }
+
+
+  // Cost of a minimum spanning tree over 'nodes' with Prim's algorithm.
+  // If 'degree' is given the degree of every node in the tree is added to it.
+  double spanningTree(const std::vector<int>& nodes, std::vector<int> *degree) const {
+    const int k = nodes.size();
+    if (k <= 1) return 0;
+    std::vector<double> key(k, POSITIVE_INFINITY);
+    std::vector<int> parent(k, -1);
+    std::vector<bool> inTree(k, false);
+    double total = 0;
+    key[0] = 0;
+    for (int it = 0; it < k; it++) {
+      int u = -1;
+      for (int i = 0; i < k; i++)
+        if (!inTree[i] && (u == -1 || key[i] < key[u])) u = i;
+      inTree[u] = true;
+      total += key[u];
+      if (degree && parent[u] != -1) {
+        (*degree)[nodes[u]]++;
+        (*degree)[nodes[parent[u]]]++;
+      }
+      const double *row = cost_.data() + (std::size_t)nodes[u] * N_;
+      for (int i = 0; i < k; i++) {
+        if (!inTree[i] && row[nodes[i]] < key[i]) {
+          key[i] = row[nodes[i]];
+          parent[i] = u;
+        }
+      }
+    }
+    return total;
+  }
+
+
+  // Lower bound (in search costs) on completing a path which ends at 'last'.
+  double oneTreeBound(int last) const {
+    std::vector<int> unvisited;
+    for (int i = 0; i < N_; i++) if (!visited_[i]) unvisited.push_back(i);
+    if (unvisited.empty()) return cost_[(std::size_t)last * N_ + start_];
+
+    double fromLast = POSITIVE_INFINITY, toStart = POSITIVE_INFINITY;
+    for (int u : unvisited) {
+      fromLast = std::min(fromLast, cost_[(std::size_t)last * N_ + u]);
+      toStart = std::min(toStart, cost_[(std::size_t)u * N_ + start_]);
+    }
+    return fromLast + spanningTree(unvisited, nullptr) + toStart;
+  }
+
+
+  // Held-Karp subgradient optimization of the node penalties. Each step
+  // builds a 1-tree (a spanning tree of all nodes but the start plus the two
+  // cheapest edges of the start) and moves the penalties of nodes whose
+  // degree is not 2 so the next 1-tree looks more like a tour.
+  void tunePenalties() {
+    pi_.assign(N_, 0.0);
+    // Without a finite upper bound the step size would be infinite.
+    if (!symmetric_ || !std::isfinite(bestCost_)) return;
+
+    std::vector<int> others;
+    for (int i = 0; i < N_; i++) if (i != start_) others.push_back(i);
+
+    std::vector<double> bestPi = pi_;
+    double bestBound = -POSITIVE_INFINITY;
+    double lambda = 2.0;
+    int sinceImproved = 0;
+
+    for (int iter = 0; iter < 50 * N_ && lambda > 1e-6; iter++) {
+      for (int i = 0; i < N_; i++)
+        for (int j = 0; j < N_; j++)
+          cost_[(std::size_t)i * N_ + j] = distance_[i][j] + pi_[i] + pi_[j];
+
+      std::vector<int> degree(N_, 0);
+      double tree = spanningTree(others, &degree);
+
+      // Connect the start node with its two cheapest edges.
+      int first = -1, second = -1;
+      const double *row = cost_.data() + (std::size_t)start_ * N_;
+      for (int u : others) {
+        if (first == -1 || row[u] < row[first]) {
+          second = first;
+          first = u;
+        } else if (second == -1 || row[u] < row[second]) {
+          second = u;
+        }
+      }
+      tree += row[first] + row[second];
+      degree[first]++;
+      degree[second]++;
+      degree[start_] = 2;
+
+      double bound = tree - 2 * std::accumulate(pi_.begin(), pi_.end(), 0.0);
+      if (bound > bestBound + EPS) {
+        bestBound = bound;
+        bestPi = pi_;
+        sinceImproved = 0;
+      } else if (++sinceImproved >= N_ / 2 + 1) {
+        lambda /= 2;
+        sinceImproved = 0;
+      }
+
+      double norm = 0;
+      for (int i = 0; i < N_; i++) norm += (degree[i] - 2) * (degree[i] - 2);
+      // Every node has degree 2: the 1-tree is an optimal tour.
+      if (norm == 0) break;
+
+      double step = lambda * (bestCost_ - bound) / norm;
+      if (!(step > 0)) break;
+      for (int i = 0; i < N_; i++) pi_[i] += step * (degree[i] - 2);
+    }
+
+    pi_ = bestPi;
+  }
+
+
+  bool outOfBudget() {
+    if (budgetExceeded_) return true;
+    if (nodeLimit_ > 0 && nodes_ >= nodeLimit_) budgetExceeded_ = true;
+    if (timeLimit_ > 0 && (nodes_ & 1023) == 0 && std::chrono::steady_clock::now() >= deadline_)
+      budgetExceeded_ = true;
+    return budgetExceeded_;
+  }
+
+
+  void search(int depth, double bound, double cost, double searchCost) {
+    nodes_++;
+    int last = path_[depth - 1];
+
+    if (depth == N_) {
+      double tourCost = cost + distance_[last][start_];
+      if (tourCost < bestCost_) {
+        bestCost_ = tourCost;
+        bestPath_ = path_;
+      }
+      return;
+    }
+
+    const std::vector<double>& m = reduced_[depth - 1];
+    const double *row = m.data() + (std::size_t)last * N_;
+
+    // Try the cheapest reduced edges first to find good tours early.
+    std::vector<int> children;
+    for (int next = 0; next < N_; next++)
+      if (!visited_[next] && row[next] != POSITIVE_INFINITY) children.push_back(next);
+    std::sort(children.begin(), children.end(), [&](int a, int b) { return row[a] < row[b]; });
+
+    for (int next : children) {
+      if (outOfBudget()) return;
+      if (canPrune(bound + row[next])) break;
+
+      std::vector<double>& child = reduced_[depth];
+      child = m;
+      for (int j = 0; j < N_; j++) child[(std::size_t)last * N_ + j] = POSITIVE_INFINITY;
+      for (int i = 0; i < N_; i++) child[(std::size_t)i * N_ + next] = POSITIVE_INFINITY;
+      child[(std::size_t)next * N_ + start_] = POSITIVE_INFINITY;
+
+      double childBound = bound + row[next] + reduce(child);
+      if (canPrune(childBound)) continue;
+
+      double childSearchCost = searchCost + cost_[(std::size_t)last * N_ + next];
+      visited_[next] = true;
+      path_[depth] = next;
+      // The reduced matrix only carries the reduction bound, the 1-tree bound
+      // is used for pruning but not passed on.
+      bool prune = symmetric_ && canPrune(childSearchCost + oneTreeBound(next));
+      if (!prune) search(depth + 1, childBound, cost + distance_[last][next], childSearchCost);
+      visited_[next] = false;
+    }
+  }
+
+
+  // Builds the warm start tour with the nearest neighbour heuristic and
+  // improves it with 2-opt moves until no move shortens the tour.
+  void heuristicTour() {
+    std::vector<int> tour(1, start_);
+    std::vector<bool> used(N_, false);
+    used[start_] = true;
+    for (int i = 1; i < N_; i++) {
+      int last = tour.back(), nearest = -1;
+      for (int j = 0; j < N_; j++)
+        if (!used[j] && (nearest == -1 || distance_[last][j] < distance_[last][nearest])) nearest = j;
+      used[nearest] = true;
+      tour.push_back(nearest);
+    }
+
+    // Segment reversal changes the direction of every edge inside the
+    // segment, so moves are evaluated on the full tour cost.
+    double cost = pathCost(tour);
+    for (bool improved = true; improved; ) {
+      improved = false;
+      for (int i = 1; i < N_ - 1; i++) {
+        for (int k = i + 1; k < N_; k++) {
+          std::reverse(tour.begin() + i, tour.begin() + k + 1);
+          double newCost = pathCost(tour);
+          if (newCost < cost) {
+            cost = newCost;
+            improved = true;
+          } else {
+            std::reverse(tour.begin() + i, tour.begin() + k + 1);
+          }
+        }
+      }
+    }
+
+    if (cost < bestCost_) {
+      bestCost_ = cost;
+      bestPath_ = tour;
+    }
+  }
+
+
+  // Solves the traveling salesman problem and caches solution.
+  void solve() {
+    if (ranSolver_) return;
+
+    nodes_ = 0;
+    budgetExceeded_ = false;
+    if (timeLimit_ > 0)
+      deadline_ = std::chrono::steady_clock::now() +
+                  std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimit_));
+
+    heuristicTour();
+
+    cost_.resize((std::size_t)N_ * N_);
+    tunePenalties();
+    for (int i = 0; i < N_; i++)
+      for (int j = 0; j < N_; j++)
+        cost_[(std::size_t)i * N_ + j] = distance_[i][j] + pi_[i] + pi_[j];
+    offset_ = 2 * std::accumulate(pi_.begin(), pi_.end(), 0.0);
+
+    reduced_.assign(N_, std::vector<double>((std::size_t)N_ * N_));
+    std::vector<double>& root = reduced_[0];
+    for (int i = 0; i < N_; i++)
+      for (int j = 0; j < N_; j++)
+        root[(std::size_t)i * N_ + j] = i == j ? POSITIVE_INFINITY : cost_[(std::size_t)i * N_ + j];
+
+    path_.assign(N_, start_);
+    visited_.assign(N_, false);
+    visited_[start_] = true;
+
+    double bound = reduce(root);
+    bool prune = canPrune(bound) || (symmetric_ && canPrune(oneTreeBound(start_)));
+    if (!prune) search(1, bound, 0, 0);
+
+    reduced_.clear();
+
+    tour_.clear();
+    for (int node : bestPath_) tour_.push_back(node);
+    tour_.push_back(start_);
+
+    ranSolver_ = true;
+  }
+
+public:
+  TspBranchAndBound(const TspBranchAndBound&) = delete;
+  TspBranchAndBound& operator=(TspBranchAndBound const&) = delete;
+
+  TspBranchAndBound(std::vector<std::vector<double>>& distance) : TspBranchAndBound(0, distance) {}
+
+
+  TspBranchAndBound(int start, std::vector<std::vector<double>>& distance) {
+    N_ = distance[0].size();
+
+    if (N_ <= 2) throw std::invalid_argument("N <= 2 not yet supported.");
+    if (N_ != (int)distance.size()) throw std::invalid_argument("Matrix must be square (n x n)");
+    if (start < 0 || start >= N_) throw std::invalid_argument("Invalid start node.");
+
+    start_ = start;
+    distance_ = distance;
+    symmetric_ = true;
+    for (int i = 0; i < N_; i++)
+      for (int j = 0; j < i; j++)
+        if (distance_[i][j] != distance_[j][i]) symmetric_ = false;
+    offset_ = 0;
+    nodeLimit_ = 0;
+    nodes_ = 0;
+    timeLimit_ = 0;
+    budgetExceeded_ = false;
+    bestCost_ = POSITIVE_INFINITY;
+    ranSolver_ = false;
+  }
+
+
+  // Stops the search after 'limit' search nodes, 0 means no limit.
+  void setNodeLimit(long long limit) {
+    nodeLimit_ = std::max(0LL, limit);
+  }
+
+
+  // Stops the search after 'seconds' of wall clock time, 0 means no limit.
+  void setTimeLimit(double seconds) {
+    timeLimit_ = std::max(0.0, seconds);
+  }
+
+
+  // Seeds the search with a known tour as the initial upper bound. The tour
+  // lists every node once, e.g. [0, 3, 2, 1], optionally closed by repeating
+  // its first node, e.g. [0, 3, 2, 1, 0].
+  void setInitialTour(const std::vector<int>& tour) {
+    bool closed = (int)tour.size() == N_ + 1 && tour.front() == tour.back();
+    if ((int)tour.size() != N_ && !closed) throw std::invalid_argument("Invalid tour.");
+    std::vector<int> path(tour.begin(), tour.begin() + N_);
+    std::vector<bool> seen(N_, false);
+    for (int node : path) {
+      if (node < 0 || node >= N_ || seen[node]) throw std::invalid_argument("Invalid tour.");
+      seen[node] = true;
+    }
+    if ((int)path.size() != N_) throw std::invalid_argument("Invalid tour.");
+
+    // Rotate the tour so it begins at the start node.
+    std::rotate(path.begin(), std::find(path.begin(), path.end(), start_), path.end());
+    double cost = pathCost(path);
+    if (cost < bestCost_) {
+      bestCost_ = cost;
+      bestPath_ = path;
+    }
+  }
+
+
+  // Returns the best tour found, beginning and ending at the start node.
+  const std::list<int>& getTour() {
+    if (!ranSolver_) solve();
+    return tour_;
+  }
+
+
+  // Returns the cost of the best tour found.
+  double getTourCost() {
+    if (!ranSolver_) solve();
+    return bestCost_;
+  }
+
+
+  // Returns true if the search completed within its budget, i.e. the tour is optimal.
+  bool isOptimal() {
+    if (!ranSolver_) solve();
+    return !budgetExceeded_;
+  }
+
+
+  // Returns the number of search nodes explored.
+  long long exploredNodes() {
+    if (!ranSolver_) solve();
+    return nodes_;
+  }
+
+};
+
+
+
+// Example usage of TSP Branch and Bound
+int TspBranchAndBound_test()
+{
+  // Create adjacency matrix
+  int n = 6;
+  std::vector<std::vector<double>> distanceMatrix(n, std::vector<double> (n, 10000));
+  distanceMatrix[5][0] = 10;
+  distanceMatrix[1][5] = 12;
+  distanceMatrix[4][1] = 2;
+  distanceMatrix[2][4] = 4;
+  distanceMatrix[3][2] = 6;
+  distanceMatrix[0][3] = 8;
+
+  TspBranchAndBound solver(0, distanceMatrix);
+  solver.setTimeLimit(1.0);
+
+  // Prints: [0, 3, 2, 4, 1, 5, 0]
+  std::stringstream str;
+  str << "Tour: [";
+  for (auto node: solver.getTour()) {
+    str << "-> ";
+    str << node;
+  }
+  str << "]";
+  std::cout << str.str() << std::endl;
+
+  // Print: 42.0
+  std::cout << "Tour cost: " << solver.getTourCost() << (solver.isOptimal() ? " (optimal)" : "") << std::endl;
+  return 0;
+}
+
+} // namespace dsa
+
+#endif /* D_GRAPH_TSPBRANCHANDBOUND_H */
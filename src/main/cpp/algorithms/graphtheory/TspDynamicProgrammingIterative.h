@@ -9,6 +9,12 @@
  *
  * Time Complexity: O(n^2 * 2^n) Space Complexity: O(n * 2^n)
  *
+ * The solver below follows the pseudo code with a few changes to the memory layout:
+ * the start node is dropped from the subset bits (halving the table), the memo table
+ * is a single array indexed by [subset][end] so the inner loop reads one contiguous
+ * row, subsets of each size are enumerated in place with Gosper's hack instead of a
+ * list of combinations, and the loops only visit the set bits of a subset.
+ *
  * # Finds the minimum TSP tour cost.
  * # m - 2D adjacency matrix representing graph
  * # S - The start node (0 <= S < N)
@@ -129,6 +135,8 @@
 #ifndef D_GRAPH_TSPDYNAMICPROGITER_H
 #define D_GRAPH_TSPDYNAMICPROGITER_H
 
+#include <ThreadPool.h>
+
 #include <vector>
 #include <deque>
 #include <list>
@@ -148,59 +156,110 @@
 #include <limits>
 #include <cassert>
 #include <stdexcept>
+#include <cstdint>
 
 
 namespace dsa {
 
-class TspDynamicProgrammingIterative {
+// The memo table stores values of type T, use float to halve the memory
+// footprint of large instances at the cost of precision.
+template <typename T>
+class BasicTspDynamicProgrammingIterative {
+public:
+  using Subset = std::uint64_t;
+
 private:
   const double POSITIVE_INFINITY = std::numeric_limits<double>::infinity();
   const double NEGATIVE_INFINITY = -std::numeric_limits<double>::infinity();
 
-  int N_, start_;
-  std::vector<std::vector<double> > distance_;
+  // N_ nodes, M_ = N_ - 1 of them besides the start node.
+  int N_, M_, start_, numThreads_;
+
+  // cost_[next * M + end] is the distance from 'end' to 'next', both given
+  // as indexes in [0, M) of the nodes other than the start node.
+  std::vector<T> cost_;
+  std::vector<T> fromStart_, toStart_;
+
+  // memo_[subset * M + end] is the cost of the cheapest path which leaves
+  // the start node, visits every node of 'subset' and ends at 'end'. The
+  // start node is implied and not part of the subset bits.
+  std::vector<T> memo_;
+
   std::list<int> tour_;
   double minTourCost_;
   bool ranSolver_;
 
 
-private:
+  // Maps a node index in [0, M) back to its id in the input matrix.
+  int nodeId(int index) const {
+    return index < start_ ? index : index + 1;
+  }
 
-  bool notIn(int elem, int subset) {
-    return ((1 << elem) & subset) == 0;
+
+  // Index of the lowest set bit, 'set' must not be zero.
+  static int lowestBit(Subset set) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(set);
+#else
+    int i = 0;
+    while (!(set & 1)) {
+      set >>= 1;
+      i++;
+    }
+    return i;
+#endif
   }
 
 
-  // This method generates all bit sets of size n where r bits
-  // are set to one. The result is returned as a list of integer masks.
-  std::list<int> combinations(int r, int n) {
-    std::list<int> subsets;
-    combinations(0, 0, r, n, subsets);
-    return subsets;
+  // Gosper's hack: the next larger integer with the same number of set bits.
+  static Subset nextCombination(Subset set) {
+    Subset c = set & (~set + 1);
+    Subset r = set + c;
+    return (((r ^ set) >> 2) / c) | r;
   }
 
 
-  // To find all the combinations of size r we need to recurse until we have
-  // selected r elements (aka r = 0), otherwise if r != 0 then we still need to select
-  // an element which is found after the position of our last selected element
-  void combinations(int set, int at, int r, int n, std::list<int>& subsets) {
+  // Binomial coefficient n choose k.
+  static Subset choose(int n, int k) {
+    if (k < 0 || k > n) return 0;
+    Subset c = 1;
+    for (int i = 1; i <= k; i++) c = c * (n - k + i) / i;
+    return c;
+  }
 
-    // Return early if there are more elements left to select than what is available.
-    int elementsLeftToPick = n - at;
-    if (elementsLeftToPick < r) return;
 
-    // We selected 'r' elements so we found a valid subset!
-    if (r == 0) {
-      subsets.push_back(set);
-    } else {
-      for (int i = at; i < n; i++) {
-        // Try including this element
-        set ^= (1 << i);
+  // Returns the subset with 'r' bits at position 'rank' of Gosper's
+  // enumeration order (the combinatorial number system).
+  static Subset unrank(Subset rank, int r) {
+    Subset set = 0;
+    for (int i = r; i >= 1; i--) {
+      int c = i - 1;
+      while (choose(c + 1, i) <= rank) c++;
+      set |= (Subset)1 << c;
+      rank -= choose(c, i);
+    }
+    return set;
+  }
 
-        combinations(set, i + 1, r - 1, n, subsets);
 
-        // Backtrack and try the instance where we did not include this element
-        set ^= (1 << i);
+  // Fills the memo entries of every subset with 'r' bits in [first, last)
+  // (ranges of Gosper's enumeration order).
+  void solveSubsets(Subset first, Subset last) {
+    const std::size_t M = M_;
+    for (Subset subset = first; subset < last; subset = nextCombination(subset)) {
+      T *row = memo_.data() + subset * M;
+      for (Subset nexts = subset; nexts; nexts &= nexts - 1) {
+        int next = lowestBit(nexts);
+        Subset state = subset ^ ((Subset)1 << next);
+        const T *prevRow = memo_.data() + state * M;
+        const T *toNext = cost_.data() + next * M;
+        T minDist = std::numeric_limits<T>::infinity();
+        for (Subset ends = state; ends; ends &= ends - 1) {
+          int end = lowestBit(ends);
+          T newDistance = prevRow[end] + toNext[end];
+          if (newDistance < minDist) minDist = newDistance;
+        }
+        row[next] = minDist;
       }
     }
   }
@@ -211,92 +270,122 @@ private:
 
     if (ranSolver_) return;
 
-    int END_STATE = (1 << N_) - 1;
-    std::vector<std::vector<double>> memo(N_ , std::vector<double> (1 << N_, POSITIVE_INFINITY));
+    const std::size_t M = M_;
+    const Subset END_STATE = ((Subset)1 << M) - 1;
+    memo_.assign(((std::size_t)1 << M) * M, std::numeric_limits<T>::infinity());
 
     // Add all outgoing edges from the starting node to memo table.
-    for (int end = 0; end < N_; end++) {
-      if (end == start_) continue;
-      memo[end][(1 << start_) | (1 << end)] = distance_[start_][end];
-    }
-
-    for (int r = 3; r <= N_; r++) {
-      for (int subset : combinations(r, N_)) {
-        if (notIn(start_, subset)) continue;
-        for (int next = 0; next < N_; next++) {
-          if (next == start_ || notIn(next, subset)) continue;
-          int subsetWithoutNext = subset ^ (1 << next);
-          double minDist = POSITIVE_INFINITY;
-          for (int end = 0; end < N_; end++) {
-            if (end == start_ || end == next || notIn(end, subset)) continue;
-            double newDistance = memo[end][subsetWithoutNext] + distance_[end][next];
-            if (newDistance < minDist) {
-              minDist = newDistance;
-            }
-          }
-          memo[next][subset] = minDist;
-        }
+    for (int end = 0; end < M_; end++)
+      memo_[((Subset)1 << end) * M + end] = fromStart_[end];
+
+    // Subsets are solved in order of increasing size, each size r in the
+    // lexicographic order of Gosper's hack. Subsets of the same size only
+    // depend on the previous layer, so a layer can be split into ranges of
+    // subsets which are solved concurrently.
+    std::unique_ptr<ThreadPool> pool;
+    if (numThreads_ > 1) pool = std::make_unique<ThreadPool>(numThreads_);
+
+    for (int r = 2; r <= M_; r++) {
+      Subset first = ((Subset)1 << r) - 1;
+      Subset layerSize = choose(M_, r);
+      if (!pool || layerSize < PARALLEL_LAYER_SIZE) {
+        solveSubsets(first, END_STATE + 1);
+        continue;
       }
+
+      int chunks = pool->size() * 16;
+      pool->parallelFor(0, chunks, [&](int c, int) {
+        Subset from = layerSize * c / chunks, to = layerSize * (c + 1) / chunks;
+        if (from == to) return;
+        solveSubsets(unrank(from, r), to == layerSize ? END_STATE + 1 : unrank(to, r));
+      });
     }
+    pool = nullptr;
 
     // Connect tour back to starting node and minimize cost.
-    for (int i = 0; i < N_; i++) {
-      if (i == start_) continue;
-      double tourCost = memo[i][END_STATE] + distance_[i][start_];
+    for (int i = 0; i < M_; i++) {
+      double tourCost = (double)(memo_[END_STATE * M + i] + toStart_[i]);
       if (tourCost < minTourCost_) {
         minTourCost_ = tourCost;
       }
     }
 
-    int lastIndex = start_;
-    int state = END_STATE;
+    // Reconstruct TSP path from memo table.
+    int lastIndex = -1; // The start node
+    Subset state = END_STATE;
     tour_.push_front(start_);
 
-    // Reconstruct TSP path from memo table.
     for (int i = 1; i < N_; i++) {
-
+      const T *row = memo_.data() + state * M;
       int index = -1;
-      for (int j = 0; j < N_; j++) {
-        if (j == start_ || notIn(j, state)) continue;
-        if (index == -1) index = j;
-        double prevDist = memo[index][state] + distance_[index][lastIndex];
-        double newDist = memo[j][state] + distance_[j][lastIndex];
-        if (newDist < prevDist) {
+      T bestDist = 0;
+      for (Subset js = state; js; js &= js - 1) {
+        int j = lowestBit(js);
+        T newDist = row[j] + (lastIndex == -1 ? toStart_[j] : cost_[lastIndex * M + j]);
+        if (index == -1 || newDist < bestDist) {
           index = j;
+          bestDist = newDist;
         }
       }
 
-      tour_.push_front(index);
-      state = state ^ (1 << index);
+      tour_.push_front(nodeId(index));
+      state = state ^ ((Subset)1 << index);
       lastIndex = index;
     }
 
     tour_.push_front(start_);
 
+    // The memo table is only needed to solve and reconstruct the tour.
+    std::vector<T>().swap(memo_);
     ranSolver_ = true;
   }
 
 public:
-  TspDynamicProgrammingIterative(const TspDynamicProgrammingIterative&) = delete;
-  TspDynamicProgrammingIterative& operator=(TspDynamicProgrammingIterative const&) = delete;
+  BasicTspDynamicProgrammingIterative(const BasicTspDynamicProgrammingIterative&) = delete;
+  BasicTspDynamicProgrammingIterative& operator=(BasicTspDynamicProgrammingIterative const&) = delete;
+
+  // Layers with fewer subsets than this are solved on the calling thread.
+  static const Subset PARALLEL_LAYER_SIZE = 4096;
 
-  TspDynamicProgrammingIterative(std::vector<std::vector<double>>& distance) :  TspDynamicProgrammingIterative(0, distance) {}
+  BasicTspDynamicProgrammingIterative(std::vector<std::vector<double>>& distance) :  BasicTspDynamicProgrammingIterative(0, distance) {}
 
 
-  TspDynamicProgrammingIterative(int start, std::vector<std::vector<double>>& distance) {
+  // @param numThreads - The number of threads each layer of subsets is solved on.
+  //     The tour and its cost do not depend on the thread count.
+  BasicTspDynamicProgrammingIterative(int start, std::vector<std::vector<double>>& distance, int numThreads = 1) {
     minTourCost_ = POSITIVE_INFINITY;
     ranSolver_ = false;
     N_ = distance[0].size();
 
     if (N_ <= 2) throw std::invalid_argument("N <= 2 not yet supported.");
-    if (N_ != distance.size()) throw std::invalid_argument("Matrix must be square (n x n)");
+    if (N_ != (int)distance.size()) throw std::invalid_argument("Matrix must be square (n x n)");
     if (start < 0 || start >= N_) throw std::invalid_argument("Invalid start node.");
+    if (numThreads <= 0) throw std::invalid_argument("numThreads <= 0");
     if (N_ > 32)
       throw std::invalid_argument(
           "Matrix too large! A matrix that size for the DP TSP problem with a time complexity of O(n^2*2^n) requires way too much computation for any modern home computer to handle");
 
     start_ = start;
-    distance_ = distance;
+    M_ = N_ - 1;
+    numThreads_ = numThreads;
+
+    cost_.resize((std::size_t)M_ * M_);
+    fromStart_.resize(M_);
+    toStart_.resize(M_);
+    for (int i = 0; i < M_; i++) {
+      fromStart_[i] = (T)distance[start_][nodeId(i)];
+      toStart_[i] = (T)distance[nodeId(i)][start_];
+      for (int j = 0; j < M_; j++)
+        cost_[(std::size_t)j * M_ + i] = (T)distance[nodeId(i)][nodeId(j)];
+    }
+  }
+
+
+  // Returns the number of bytes the memo table of an n node instance takes.
+  // Use it to refuse instances which do not fit into memory before solving.
+  static std::size_t memoryEstimate(int n) {
+    if (n <= 1) return 0;
+    return ((std::size_t)1 << (n - 1)) * (std::size_t)(n - 1) * sizeof(T);
   }
 
 
@@ -315,6 +404,8 @@ public:
 
 };
 
+using TspDynamicProgrammingIterative = BasicTspDynamicProgrammingIterative<double>;
+
 
 // Example usage of TSP Dynamic Programming
 int TspDynProgIter_test()
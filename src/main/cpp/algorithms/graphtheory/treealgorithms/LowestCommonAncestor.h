@@ -0,0 +1,311 @@
+/*
+ * @file   LowestCommonAncestor.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Lowest common ancestor queries on a RootingTree.
+ *
+ * Three methods with different trade offs between build time, memory and query time:
+ *
+ * BinaryLifting: up[v][k] is the 2^k-th ancestor of v. A query lifts the deeper node to the
+ *   depth of the other one and then both nodes together, highest jump first.
+ *   Build O(n log h), memory n log h, query O(log h), where h is the height of the tree.
+ *
+ * SparseTable: range minimum queries over the Euler tour of the tree. The tour is reduced
+ *   to its first visits, which is the preorder: for u and v with index(u) < index(v) the
+ *   nodes at preorder positions (index(u), index(v)] all lie below the lca, and the child of
+ *   the lca towards v is among them. So the smallest preorder index of a parent over that
+ *   range is the index of the lca. The table holds the minimum of every range of length 2^k.
+ *   Build O(n log n), memory n log n, query O(1).
+ *
+ * Offline: Tarjan's algorithm answers a batch of queries in one depth first pass. When v is
+ *   finished it is linked to its parent in a union find forest, so the root of a finished node
+ *   is its deepest unfinished ancestor. A query (u, v) is answered when the second of its two
+ *   nodes is finished: the lca is the root of the other node.
+ *   No index, O(n + q) per batch.
+ *
+ * All three methods are iterative and handle trees of any depth.
+ */
+
+#ifndef D_LOWESTCOMMONANCESTOR_H
+#define D_LOWESTCOMMONANCESTOR_H
+
+#include <RootingTree.h>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace dsa {
+
+
+class LowestCommonAncestor {
+public:
+  enum class Method {
+    BinaryLifting,
+    SparseTable,
+    Offline
+  };
+
+private:
+  const RootingTree *tree_;
+  Method method_;
+  int n_;
+
+  // BinaryLifting: the 2^k-th ancestor of v is up_[v * levels_ + k], the
+  // root being its own ancestor. The jumps of one node share a cache line.
+  std::vector<int> up_;
+  int levels_;
+
+  // SparseTable: table_[k * m + p] is the smallest preorder index of a
+  // parent over the preorder positions [p, p + 2^k), m being the number of
+  // nodes in the tree.
+  std::vector<int> table_;
+
+
+  // Index of the highest set bit of 'x' > 0.
+  static int highestBit(unsigned x) {
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    int bit = 0;
+    while (x >>= 1) bit++;
+    return bit;
+#endif
+  }
+
+
+  void checkNode(int u) const {
+    if (!tree_->contains(u)) throw std::invalid_argument("Node is not in the tree");
+  }
+
+
+  void buildBinaryLifting() {
+    const std::vector<int>& depth = tree_->depths();
+    const std::vector<int>& preorder = tree_->preorder();
+    int height = 0;
+    for (int node : preorder) height = std::max(height, depth[node]);
+    levels_ = height == 0 ? 1 : highestBit(height) + 1;
+
+    up_.assign((size_t)n_ * levels_, -1);
+    // Ancestors come first in preorder, so their jumps are already known.
+    for (int node : preorder) {
+      int *jumps = &up_[(size_t)node * levels_];
+      int parent = tree_->parent(node);
+      jumps[0] = parent == -1 ? node : parent;
+      for (int k = 1; k < levels_; k++)
+        jumps[k] = up_[(size_t)jumps[k - 1] * levels_ + k - 1];
+    }
+  }
+
+
+  void buildSparseTable() {
+    const std::vector<int>& preorder = tree_->preorder();
+    int m = preorder.size();
+    int levels = highestBit(std::max(1, m)) + 1;
+    table_.assign((size_t)m * levels, 0);
+
+    for (int p = 1; p < m; p++) table_[p] = tree_->index(tree_->parent(preorder[p]));
+    for (int k = 1; k < levels; k++) {
+      const int *prev = &table_[(size_t)(k - 1) * m];
+      int *row = &table_[(size_t)k * m];
+      int half = 1 << (k - 1);
+      for (int p = 0; p + 2 * half <= m; p++) row[p] = std::min(prev[p], prev[p + half]);
+    }
+  }
+
+
+  int binaryLifting(int u, int v) const {
+    const std::vector<int>& depth = tree_->depths();
+    if (depth[u] < depth[v]) std::swap(u, v);
+    // Lift u to the depth of v.
+    for (unsigned diff = depth[u] - depth[v]; diff != 0; diff &= diff - 1)
+      u = up_[(size_t)u * levels_ + highestBit(diff & -diff)];
+    if (u == v) return u;
+    // Lift both to just below the lca.
+    for (int k = levels_ - 1; k >= 0; k--) {
+      int pu = up_[(size_t)u * levels_ + k], pv = up_[(size_t)v * levels_ + k];
+      if (pu != pv) {
+        u = pu;
+        v = pv;
+      }
+    }
+    return up_[(size_t)u * levels_];
+  }
+
+
+  int sparseTable(int u, int v) const {
+    int i = tree_->index(u), j = tree_->index(v);
+    if (i == j) return u;
+    if (i > j) std::swap(i, j);
+    size_t m = tree_->preorder().size();
+    int k = highestBit(j - i);
+    int best = std::min(table_[k * m + i + 1], table_[k * m + j - (1 << k) + 1]);
+    return tree_->preorder()[best];
+  }
+
+
+  std::vector<int> offline(const std::vector<std::pair<int, int>>& queries) const {
+    std::vector<int> answers(queries.size(), -1);
+
+    // The queries of every node, in CSR form.
+    std::vector<int> offsets(n_ + 1, 0), byNode(2 * queries.size());
+    for (auto& query : queries) {
+      offsets[query.first + 1]++;
+      offsets[query.second + 1]++;
+    }
+    for (int u = 0; u < n_; u++) offsets[u + 1] += offsets[u];
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int q = 0; q < (int)queries.size(); q++) {
+      byNode[fill[queries[q].first]++] = q;
+      byNode[fill[queries[q].second]++] = q;
+    }
+
+    // Union find forest. A node is its own root until it is finished, then
+    // it is linked to its parent.
+    std::vector<int> link(n_);
+    std::vector<char> finished(n_, 0);
+    auto find = [&](int x) {
+      while (link[x] != x) {
+        link[x] = link[link[x]];
+        x = link[x];
+      }
+      return x;
+    };
+
+    // Depth first search over the child links with an explicit stack.
+    // next[u] is the next child of u to descend into.
+    std::vector<int> next(n_, -1), stack{tree_->root()};
+    link[tree_->root()] = tree_->root();
+    next[tree_->root()] = tree_->firstChild(tree_->root());
+    while (!stack.empty()) {
+      int u = stack.back();
+      if (next[u] != -1) {
+        int child = next[u];
+        next[u] = tree_->nextSibling(child);
+        link[child] = child;
+        next[child] = tree_->firstChild(child);
+        stack.push_back(child);
+        continue;
+      }
+
+      stack.pop_back();
+      finished[u] = 1;
+      for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+        int q = byNode[i];
+        int other = queries[q].first == u ? queries[q].second : queries[q].first;
+        if (finished[other]) answers[q] = find(other);
+      }
+      if (!stack.empty()) link[u] = stack.back();
+    }
+    return answers;
+  }
+
+public:
+  LowestCommonAncestor(const LowestCommonAncestor&) = delete;
+  LowestCommonAncestor& operator=(LowestCommonAncestor const&) = delete;
+
+  // Builds the index of 'method' for 'tree'. The tree must outlive the
+  // object. The Offline method builds nothing and only answers batches.
+  LowestCommonAncestor(const RootingTree *tree, Method method = Method::SparseTable) {
+    if (tree == nullptr) throw std::invalid_argument("TREE NULL");
+    tree_ = tree;
+    method_ = method;
+    n_ = tree->size();
+    levels_ = 0;
+    if (method == Method::BinaryLifting) buildBinaryLifting();
+    else if (method == Method::SparseTable) buildSparseTable();
+  }
+
+
+  const RootingTree& operator()() {
+    return *tree_;
+  }
+
+
+  Method method() const {
+    return method_;
+  }
+
+
+  // The lowest common ancestor of 'u' and 'v'. Both nodes must be in the
+  // tree. Not available for the Offline method.
+  int lca(int u, int v) const {
+    checkNode(u);
+    checkNode(v);
+    if (method_ == Method::BinaryLifting) return binaryLifting(u, v);
+    if (method_ == Method::SparseTable) return sparseTable(u, v);
+    throw std::invalid_argument("Single queries need an online method");
+  }
+
+
+  // The lowest common ancestor of every pair in 'queries', in the same order.
+  std::vector<int> lca(const std::vector<std::pair<int, int>>& queries) const {
+    for (auto& query : queries) {
+      checkNode(query.first);
+      checkNode(query.second);
+    }
+    if (method_ == Method::Offline) return offline(queries);
+
+    std::vector<int> answers(queries.size());
+    for (size_t q = 0; q < queries.size(); q++)
+      answers[q] = method_ == Method::BinaryLifting ? binaryLifting(queries[q].first, queries[q].second)
+                                                    : sparseTable(queries[q].first, queries[q].second);
+    return answers;
+  }
+
+
+  // Bytes held by the index, without the tree itself.
+  size_t memoryUsage() const {
+    return (up_.capacity() + table_.capacity()) * sizeof(int);
+  }
+
+};
+
+
+
+// Example usage of LowestCommonAncestor
+void LowestCommonAncestor_test()
+{
+  Graph graph(9);
+
+  graph.addUndirectedEdge(0, 1);
+  graph.addUndirectedEdge(2, 1);
+  graph.addUndirectedEdge(2, 3);
+  graph.addUndirectedEdge(3, 4);
+  graph.addUndirectedEdge(5, 3);
+  graph.addUndirectedEdge(2, 6);
+  graph.addUndirectedEdge(6, 7);
+  graph.addUndirectedEdge(6, 8);
+
+  // Rooted at 6 the tree looks like:
+  //           6
+  //      2    7     8
+  //    1   3
+  //  0    4 5
+  RootingTree tree(&graph, 6);
+
+  LowestCommonAncestor lifting(&tree, LowestCommonAncestor::Method::BinaryLifting);
+  LowestCommonAncestor table(&tree, LowestCommonAncestor::Method::SparseTable);
+  LowestCommonAncestor offline(&tree, LowestCommonAncestor::Method::Offline);
+
+  std::vector<std::pair<int, int>> queries{{0, 4}, {4, 5}, {7, 0}, {3, 2}};
+  std::vector<int> answers = offline.lca(queries);
+  for (size_t q = 0; q < queries.size(); q++) {
+    int u = queries[q].first, v = queries[q].second;
+    std::cout << "lca(" << u << ", " << v << ") = " << lifting.lca(u, v)
+              << " " << table.lca(u, v) << " " << answers[q] << std::endl;
+  }
+  // Prints:
+  // lca(0, 4) = 2 2 2
+  // lca(4, 5) = 3 3 3
+  // lca(7, 0) = 6 6 6
+  // lca(3, 2) = 2 2 2
+}
+
+} // namespace dsa
+
+#endif /* D_LOWESTCOMMONANCESTOR_H */
@@ -9,6 +9,12 @@
  *
  * <p>Time Complexity: O(V+E)
  *
+ * The rooted tree is stored in flat arrays indexed by node id: parent, first child and next
+ * sibling links, the depth, the subtree size and the preorder index of every node. The tree
+ * is built with an explicit stack, so the depth is only limited by memory, and the nodes of the
+ * subtree of v are exactly preorder[index(v), index(v) + subtreeSize(v)), which makes
+ * ancestor tests and subtree ranges O(1).
+ *
  */
 
 #ifndef D_ROOTINGTREE_H
@@ -17,170 +23,258 @@
 #include <Graph.h>
 
 #include <vector>
-#include <deque>
-#include <queue>
-#include <list>
-#include <set>   // set and multiset
-#include <map>   // map and multimap
-#include <unordered_set>  // unordered set/multiset
-#include <unordered_map>  // unordered map/multimap
 #include <iterator>
 #include <algorithm>
-#include <numeric>    // some numeric algorithm
-#include <functional>
-#include <stack>
 
-#include <chrono>
-#include <random>
 #include <sstream>
 #include <memory>
 #include <iostream>
-#include <cmath>
+#include <stdexcept>
 
 namespace dsa {
 
 
 class RootingTree {
 public:
-  class TreeNode {
+  // Iterates over the children of a node along the next sibling links.
+  class ChildIterator {
   private:
-    int id_;
-    TreeNode *parent_;
-    std::unordered_set<TreeNode*> children_;
+    const int *nextSibling_;
+    int node_;
   public:
-    // Useful constructor for root node.
-    TreeNode(int id) : TreeNode(id, nullptr) {
-    }
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = int;
 
-    TreeNode(int id, TreeNode *parent) {
-      id_ = id;
-      parent_ = parent;
+    ChildIterator(const int *nextSibling, int node) : nextSibling_(nextSibling), node_(node) {
     }
 
-    virtual ~TreeNode() {
-      for (auto c : children_) {
-        if (c) delete c;
-      }
+    int operator*() const {
+      return node_;
     }
 
-    TreeNode(const TreeNode& rhs) { // Copy constructor
-  	  std::cout << "TreeNode copy constructor" << std::endl;
-  	  id_ = rhs.id_;
-  	  parent_ = rhs.parent_;
-      children_ = rhs.children_;
+    ChildIterator& operator++() {
+      node_ = nextSibling_[node_];
+      return *this;
     }
 
-    TreeNode(const TreeNode&& rhs) { // Move constructor
-      id_ = rhs.id_;
-      parent_ = rhs.parent_;
-      children_ = rhs.children_;
+    ChildIterator operator++(int) {
+      ChildIterator tmp = *this;
+      ++(*this);
+      return tmp;
     }
 
-    TreeNode& operator = (const TreeNode& rhs) {
-      if (this != &rhs) {
-        id_ = rhs.id_;
-        parent_ = rhs.parent_;
-        children_ = rhs.children_;
-  	  }
-  	  return *this;
+    bool operator==(const ChildIterator& rhs) const {
+      return node_ == rhs.node_;
     }
 
-    // overloaded == operator
-    bool operator ==(const TreeNode& rhs) {
-       if(id_ == rhs.id_) {
-          return true;
-       }
-       return false;
+    bool operator!=(const ChildIterator& rhs) const {
+      return node_ != rhs.node_;
     }
+  };
 
-    void addChildren(TreeNode *node) {
-      children_.insert(node);
+  // The children of one node, usable in a range based for loop.
+  class ChildRange {
+  private:
+    const int *nextSibling_;
+    int first_;
+  public:
+    ChildRange(const int *nextSibling, int first) : nextSibling_(nextSibling), first_(first) {
     }
 
-    int id() {
-      return id_;
+    ChildIterator begin() const {
+      return ChildIterator(nextSibling_, first_);
     }
 
-    TreeNode* parent() {
-      return parent_;
+    ChildIterator end() const {
+      return ChildIterator(nextSibling_, -1);
     }
 
-    const std::unordered_set<TreeNode*>& children() {
-      return children_;
+    bool empty() const {
+      return first_ == -1;
     }
+  };
 
-    std::string toString() const {
-  	  std::stringstream os;
-      os << id_;
-      return os.str();
-    }
+private:
+  int n_, root_;
 
-    friend std::ostream& operator<<(std::ostream &strm, const TreeNode &tn) {
-      return strm << tn.toString();
-    }
+  // -1 marks the absence of a node: the parent of the root, the first child
+  // of a leaf, the next sibling of a last child, and every entry of a node
+  // which is not connected to the root.
+  std::vector<int> parent_, firstChild_, nextSibling_;
+  std::vector<int> depth_, size_, index_;
+  std::vector<int> preorder_;
 
-  };
 
-private:
-  TreeNode *root_;
-  Graph *graph_;
+  void checkNode(int u) const {
+    if (u < 0 || u >= n_) throw std::invalid_argument("Invalid node index");
+  }
 
 public:
-  RootingTree(Graph *graph, int rootId) {
+  RootingTree(const RootingTree&) = delete;
+  RootingTree& operator=(RootingTree const&) = delete;
+
+  // Roots the tree given by the undirected 'graph' at 'rootId'. Nodes which
+  // are not connected to the root are left out. Throws if the component of
+  // the root has a cycle. GRAPH is Graph, CsrGraph or any type with the same
+  // read-only interface.
+  template <typename GRAPH>
+  RootingTree(const GRAPH *graph, int rootId) {
     if (graph == nullptr) throw std::invalid_argument("GRAPH NULL");
-	graph_ = graph;
-    root_ = new TreeNode(rootId);
-    root_ = buildTree(root_);
+    n_ = graph->size();
+    checkNode(rootId);
+    root_ = rootId;
+
+    parent_.assign(n_, -1);
+    firstChild_.assign(n_, -1);
+    nextSibling_.assign(n_, -1);
+    depth_.assign(n_, -1);
+    size_.assign(n_, 0);
+    index_.assign(n_, -1);
+
+    // Depth first search which numbers the nodes in preorder. The children of
+    // a node are linked in the order of its edges and pushed in reverse so
+    // they are visited in that order.
+    std::vector<int> stack{rootId}, children;
+    depth_[rootId] = 0;
+    while (!stack.empty()) {
+      int node = stack.back();
+      stack.pop_back();
+      index_[node] = preorder_.size();
+      preorder_.push_back(node);
+
+      children.clear();
+      for (auto edge: graph->edges(node)) {
+        int child = edge.first;
+        // Ignore the edge pointing back to the parent.
+        if (child == parent_[node]) continue;
+        if (depth_[child] != -1) throw std::invalid_argument("GRAPH is not a tree");
+        parent_[child] = node;
+        depth_[child] = depth_[node] + 1;
+        children.push_back(child);
+      }
+      for (int i = (int)children.size() - 1; i >= 0; i--) {
+        nextSibling_[children[i]] = firstChild_[node];
+        firstChild_[node] = children[i];
+        stack.push_back(children[i]);
+      }
+    }
+
+    // Subtree sizes, children before parents.
+    for (int i = (int)preorder_.size() - 1; i >= 0; i--) {
+      int node = preorder_[i];
+      size_[node] += 1;
+      if (parent_[node] != -1) size_[parent_[node]] += size_[node];
+    }
   }
 
-  virtual ~RootingTree() {
-    if (root_) delete root_;
-    root_ = nullptr;
+
+  // The id of the root node.
+  int root() const {
+    return root_;
   }
 
-  TreeNode& operator()() {
-    return *root_;
+
+  // Number of node ids, including nodes which are not part of the tree.
+  int size() const {
+    return n_;
   }
 
-  const std::unordered_set<TreeNode*>& children() {
-    return root_->children();
+
+  // True if 'u' is connected to the root.
+  bool contains(int u) const {
+    checkNode(u);
+    return index_[u] != -1;
   }
 
-  std::string toString() const {
-	std::stringstream os;
-    os << *root_;
-    return os.str();
+
+  int parent(int u) const {
+    checkNode(u);
+    return parent_[u];
   }
 
-  friend std::ostream& operator<<(std::ostream &strm, const RootingTree &rt) {
-    return strm << rt.toString();
+
+  int firstChild(int u) const {
+    checkNode(u);
+    return firstChild_[u];
   }
 
-private:
-  // Do dfs to construct rooted tree.
-  TreeNode *buildTree(TreeNode *node) {
 
-    auto graphItr = (*graph_)()->find(node->id());
-    if (graphItr == (*graph_)()->end()) return node;
+  int nextSibling(int u) const {
+    checkNode(u);
+    return nextSibling_[u];
+  }
 
-    if (!graphItr->second.empty()) {
-      for (auto edge: graphItr->second) {
 
-        // Ignore adding an edge pointing back to parent.
-        if (node->parent() != nullptr) {
-          if (edge.first == node->parent()->id()) {
-            continue;
-          }
-        }
+  // The children of 'u' in the order of its edges.
+  ChildRange children(int u) const {
+    checkNode(u);
+    return ChildRange(nextSibling_.data(), firstChild_[u]);
+  }
 
-        TreeNode *child = new TreeNode(edge.first, node);
-        node->addChildren(child);
 
-        buildTree(child);
-      }
-    }
+  // The children of the root.
+  ChildRange children() const {
+    return children(root_);
+  }
 
-    return node;
+
+  // Number of edges between 'u' and the root.
+  int depth(int u) const {
+    checkNode(u);
+    return depth_[u];
+  }
+
+
+  // Number of nodes in the subtree of 'u', including 'u'.
+  int subtreeSize(int u) const {
+    checkNode(u);
+    return size_[u];
+  }
+
+
+  // Position of 'u' in preorder().
+  int index(int u) const {
+    checkNode(u);
+    return index_[u];
+  }
+
+
+  // The nodes of the tree in preorder. The subtree of 'u' is the range
+  // [index(u), index(u) + subtreeSize(u)).
+  const std::vector<int>& preorder() const {
+    return preorder_;
+  }
+
+
+  // True if 'u' is an ancestor of 'v' or 'v' itself.
+  bool isAncestor(int u, int v) const {
+    checkNode(u);
+    checkNode(v);
+    return index_[u] != -1 && index_[v] != -1 &&
+           index_[u] <= index_[v] && index_[v] < index_[u] + size_[u];
+  }
+
+
+  const std::vector<int>& parents() const {
+    return parent_;
+  }
+
+  const std::vector<int>& depths() const {
+    return depth_;
+  }
+
+
+  std::string toString() const {
+	std::stringstream os;
+    os << root_;
+    return os.str();
+  }
+
+  friend std::ostream& operator<<(std::ostream &strm, const RootingTree &rt) {
+    return strm << rt.toString();
   }
 
 };
@@ -205,45 +299,37 @@ void RootingTree_test()
   //    1   3
   //  0    4 5
 
-  RootingTree *root = new RootingTree(&graph, 6);
+  RootingTree root(&graph, 6);
 
   // Layer 0: [6]
   std::cout << "Layer 0: [6]: ";
-  std::cout << (*root) << std::endl;
-
-
-#define PRINT_CHILDREN(r) \
-  do { \
-	std::cout << "["; \
-	for (auto c : r) std::cout << (*c) << ","; \
-	std::cout << "]"; \
-  } while(0)
+  std::cout << root << std::endl;
 
+  auto printChildren = [&](int node) {
+    std::cout << "[";
+    for (int child : root.children(node)) std::cout << child << ",";
+    std::cout << "]";
+  };
 
   // Layer 1: [2, 7, 8]
-  std::unordered_set<RootingTree::TreeNode*> children_root = root->children();
   std::cout << "Layer 1: [2, 7, 8]: ";
-  PRINT_CHILDREN(children_root);
+  printChildren(6);
   std::cout << std::endl;
 
-
   // Layer 2: [1, 3]
-  int expectedId = 2;
-  auto idComparer = [&expectedId](auto c2) -> bool { return ((*c2).id() == expectedId); };
-  auto itr = std::find_if(children_root.begin(), children_root.end(), idComparer);
-  std::unordered_set<RootingTree::TreeNode*> children_layer2 = (*itr)->children();
   std::cout << "Layer 2: [1, 3]: ";
-  PRINT_CHILDREN(children_layer2);
+  printChildren(2);
   std::cout << std::endl;
 
-
   // Layer 3: [0], [4, 5]
-  expectedId = 3;
-  itr = std::find_if(children_layer2.begin(), children_layer2.end(), idComparer);
-  std::unordered_set<RootingTree::TreeNode*> children_layer3 = (*itr)->children();
   std::cout << "Layer 3: [4, 5]: ";
-  PRINT_CHILDREN(children_layer3);
+  printChildren(3);
   std::cout << std::endl;
+
+  // The subtree of 2 is a contiguous range of the preorder.
+  std::cout << "Subtree of 2: [";
+  for (int i = root.index(2); i < root.index(2) + root.subtreeSize(2); i++) std::cout << root.preorder()[i] << ",";
+  std::cout << "]" << std::endl;
 }
 
 } // namespace dsa
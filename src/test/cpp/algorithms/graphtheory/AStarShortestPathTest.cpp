@@ -0,0 +1,228 @@
+/*
+ * @file   AStarShortestPathTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Unit test of A* with Euclidean, haversine and landmark (ALT) heuristics.
+ */
+
+#include <gtest\gtest.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+#include <AStarShortestPath.h>
+#include <CsrGraph.h>
+#include "ShortestPathTestHelpers.h"
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace dsa {
+
+class AStarShortestPathTest : public ShortestPathTest {
+protected:
+  // The heuristics sum square roots and sines, so the distances are compared loosely.
+  AStarShortestPathTest() : ShortestPathTest(1e-6) {
+  }
+
+  // Grid of points with random jitter. Every edge costs its Euclidean length
+  // times a random detour factor in [1, 2], and some edges are missing.
+  void geometricGrid(Graph& graph, std::vector<std::pair<double, double>>& coords,
+                     int rows, int cols, std::mt19937& rng) {
+    std::uniform_real_distribution<double> jitter(-0.3, 0.3), detour(1, 2), keep(0, 1);
+    coords.clear();
+    for (int r = 0; r < rows; r++)
+      for (int c = 0; c < cols; c++)
+        coords.push_back({c + jitter(rng), r + jitter(rng)});
+
+    EuclideanHeuristic length(coords);
+    for (int r = 0; r < rows; r++) {
+      for (int c = 0; c < cols; c++) {
+        int u = r * cols + c;
+        for (int v : {c + 1 < cols ? u + 1 : -1, r + 1 < rows ? u + cols : -1}) {
+          if (v == -1 || keep(rng) < 0.1) continue;
+          graph.addDirectedEdge(u, v, length(u, v) * detour(rng));
+          graph.addDirectedEdge(v, u, length(u, v) * detour(rng));
+        }
+      }
+    }
+  }
+};
+
+
+TEST_F(AStarShortestPathTest, testHeuristicsAgainstDijkstra) {
+  std::mt19937 rng(8);
+  int rows = 12, cols = 15, n = rows * cols;
+  Graph graph(n);
+  std::vector<std::pair<double, double>> coords;
+  geometricGrid(graph, coords, rows, cols, rng);
+
+  DijkstrasShortestPathAdjacencyListWithDHeap dijkstra(&graph);
+  BasicAStarShortestPath<Graph, EuclideanHeuristic> euclid(&graph, EuclideanHeuristic(coords));
+  LandmarkHeuristic alt(&graph, LandmarkHeuristic::farthestLandmarks(&graph, 4));
+  BasicAStarShortestPath<Graph, LandmarkHeuristic> landmarks(&graph, alt);
+  AStarShortestPath zero(&graph, [](int, int) { return 0.0; });
+
+  for (int s = 0; s < n; s += 7) {
+    for (int e = 0; e < n; e++) {
+      double expected = dijkstra.shortestPath(s, e);
+      if (expected == inf) {
+        EXPECT_EQ(euclid.shortestPath(s, e), inf);
+        EXPECT_EQ(landmarks.shortestPath(s, e), inf);
+        continue;
+      }
+      EXPECT_NEAR(euclid.shortestPath(s, e), expected, EPS);
+      EXPECT_NEAR(landmarks.shortestPath(s, e), expected, EPS);
+      EXPECT_NEAR(zero.shortestPath(s, e), expected, EPS);
+
+      std::list<int> path = landmarks.reconstructPath(s, e);
+      EXPECT_EQ(path.front(), s);
+      EXPECT_EQ(path.back(), e);
+      EXPECT_NEAR(pathCost(graph, path), expected, EPS);
+    }
+  }
+}
+
+
+TEST_F(AStarShortestPathTest, testLandmarkBoundsAreAdmissible) {
+  std::mt19937 rng(9);
+  int n = 60;
+  Graph graph(n);
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::uniform_real_distribution<double> cost(0, 5);
+  for (int i = 0; i < 3 * n; i++) graph.addDirectedEdge(node(rng), node(rng), cost(rng));
+
+  std::vector<int> landmarks = LandmarkHeuristic::farthestLandmarks(&graph, 5, 3);
+  EXPECT_EQ(landmarks.front(), 3);
+  std::sort(landmarks.begin(), landmarks.end());
+  EXPECT_TRUE(std::adjacent_find(landmarks.begin(), landmarks.end()) == landmarks.end());
+
+  LandmarkHeuristic alt(&graph, landmarks);
+  DijkstrasShortestPathAdjacencyListWithDHeap dijkstra(&graph);
+  for (int s = 0; s < n; s++) {
+    dijkstra.solve(s);
+    for (int e = 0; e < n; e++) {
+      EXPECT_GE(alt(s, e), 0);
+      EXPECT_LE(alt(s, e), dijkstra.getDistance(e) + EPS);
+    }
+  }
+  EXPECT_THROW(LandmarkHeuristic(&graph, std::vector<int>{n}), std::invalid_argument);
+}
+
+
+TEST_F(AStarShortestPathTest, testInconsistentHeuristicReopensNodes) {
+  std::mt19937 rng(10);
+  int rows = 10, cols = 10, n = rows * cols;
+  Graph graph(n);
+  std::vector<std::pair<double, double>> coords;
+  geometricGrid(graph, coords, rows, cols, rng);
+
+  // h = a random fraction of the true distance is admissible but not
+  // consistent, A* has to reopen nodes to stay exact.
+  std::vector<std::vector<double>> dist(n);
+  DijkstrasShortestPathAdjacencyListWithDHeap dijkstra(&graph);
+  std::vector<double> fraction(n * n);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  for (double& f : fraction) f = uniform(rng);
+  for (int t = 0; t < n; t++) {
+    dist[t].resize(n);
+    for (int v = 0; v < n; v++) dist[t][v] = dijkstra.shortestPath(v, t);
+  }
+
+  AStarShortestPath solver(&graph, [&](int v, int t) {
+    return dist[t][v] == inf ? 0.0 : fraction[v * n + t] * dist[t][v];
+  });
+  for (int s = 0; s < n; s += 3) {
+    for (int e = 0; e < n; e++) {
+      if (dist[e][s] != inf) EXPECT_NEAR(solver.shortestPath(s, e), dist[e][s], EPS);
+      else EXPECT_EQ(solver.shortestPath(s, e), inf);
+    }
+  }
+}
+
+
+TEST_F(AStarShortestPathTest, testHaversine) {
+  // Points 0.01 degrees apart around 48N 11E, costs are great circle lengths.
+  int rows = 8, cols = 8, n = rows * cols;
+  std::vector<std::pair<double, double>> latLon;
+  for (int r = 0; r < rows; r++)
+    for (int c = 0; c < cols; c++)
+      latLon.push_back({48.0 + 0.01 * r, 11.0 + 0.01 * c});
+  HaversineHeuristic meters(latLon);
+
+  // One degree of latitude is about 111.2 km.
+  EXPECT_NEAR(meters(0, cols), 1111.95, 0.1);
+
+  Graph graph(n);
+  for (int u = 0; u < n; u++) {
+    if (u % cols + 1 < cols) graph.addUndirectedEdge(u, u + 1, meters(u, u + 1));
+    if (u + cols < n) graph.addUndirectedEdge(u, u + cols, meters(u, u + cols));
+  }
+
+  DijkstrasShortestPathAdjacencyListWithDHeap dijkstra(&graph);
+  BasicAStarShortestPath<Graph, HaversineHeuristic> solver(&graph, meters);
+  for (int s = 0; s < n; s += 5)
+    for (int e = 0; e < n; e++)
+      EXPECT_NEAR(solver.shortestPath(s, e), dijkstra.shortestPath(s, e), EPS);
+}
+
+
+TEST_F(AStarShortestPathTest, testExpandedNodesBenchmark) {
+  std::mt19937 rng(12);
+  int rows = 300, cols = 300, n = rows * cols, queries = 100;
+  Graph graph(n);
+  std::vector<std::pair<double, double>> coords;
+  geometricGrid(graph, coords, rows, cols, rng);
+  CsrGraph csr(graph);
+
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < queries; i++) pairs.push_back({node(rng), node(rng)});
+
+  BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph> dijkstra(&csr, 4);
+  BasicAStarShortestPath<CsrGraph, EuclideanHeuristic> euclid(&csr, EuclideanHeuristic(coords), 4);
+  auto t0 = std::chrono::steady_clock::now();
+  LandmarkHeuristic alt(&csr, LandmarkHeuristic::farthestLandmarks(&csr, 8));
+  auto t1 = std::chrono::steady_clock::now();
+  BasicAStarShortestPath<CsrGraph, LandmarkHeuristic> landmarks(&csr, alt, 4);
+  std::cout << "ALT preprocessing with 8 landmarks: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  long long settled[3] = {0, 0, 0};
+  long long millis[3] = {0, 0, 0};
+  for (auto q : pairs) {
+    auto a = std::chrono::steady_clock::now();
+    double expected = dijkstra.shortestPath(q.first, q.second);
+    auto b = std::chrono::steady_clock::now();
+    double d1 = euclid.shortestPath(q.first, q.second);
+    auto c = std::chrono::steady_clock::now();
+    double d2 = landmarks.shortestPath(q.first, q.second);
+    auto d = std::chrono::steady_clock::now();
+
+    if (expected == inf) {
+      EXPECT_EQ(d1, inf);
+      EXPECT_EQ(d2, inf);
+    } else {
+      EXPECT_NEAR(d1, expected, EPS);
+      EXPECT_NEAR(d2, expected, EPS);
+    }
+    settled[0] += dijkstra.settledNodes();
+    settled[1] += euclid.expandedNodes();
+    settled[2] += landmarks.expandedNodes();
+    millis[0] += std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+    millis[1] += std::chrono::duration_cast<std::chrono::microseconds>(c - b).count();
+    millis[2] += std::chrono::duration_cast<std::chrono::microseconds>(d - c).count();
+  }
+
+  const char *names[3] = {"Dijkstra", "A* Euclidean", "A* ALT"};
+  for (int i = 0; i < 3; i++)
+    std::cout << names[i] << ": " << millis[i] / 1000 << "ms"
+              << " nodes/query: " << settled[i] / queries << std::endl;
+  EXPECT_LT(settled[1], settled[0]);
+  EXPECT_LT(settled[2], settled[0]);
+}
+
+} // namespace dsa
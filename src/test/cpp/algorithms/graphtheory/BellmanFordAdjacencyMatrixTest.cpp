@@ -0,0 +1,144 @@
+/*
+ * @file   BellmanFordAdjacencyMatrixTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Bellman-Ford adjacency matrix Unit Test.
+ */
+
+#include <gtest\gtest.h>
+#include <BellmanFordAdjacencyMatrix.h>
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+namespace dsa {
+
+class BellmanFordAdjacencyMatrixTest : public ::testing::Test {
+protected:
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // A random matrix with 'm' edges of integer costs in [minCost, maxCost].
+  std::vector<std::vector<double>> randomMatrix(int n, int m, int minCost, int maxCost, std::mt19937& rng) {
+    std::uniform_int_distribution<int> node(0, n - 1), cost(minCost, maxCost);
+    std::vector<std::vector<double>> matrix(n, std::vector<double>(n, inf));
+    for (int i = 0; i < n; i++) matrix[i][i] = 0;
+    for (int i = 0; i < m; i++) {
+      int u = node(rng), v = node(rng);
+      if (u != v) matrix[u][v] = cost(rng);
+    }
+    return matrix;
+  }
+};
+
+
+TEST_F(BellmanFordAdjacencyMatrixTest, testParallelRounds) {
+  std::mt19937 rng(7);
+  for (int trial = 0; trial < 40; trial++) {
+    int n = 2 + trial, m = n * (1 + trial % 5);
+    auto matrix = randomMatrix(n, m, trial % 3 == 0 ? 0 : -3, 10, rng);
+    int start = trial % n;
+
+    BellmanFordAdjacencyMatrix serial(start, &matrix);
+    BellmanFordAdjacencyMatrix parallel(start, &matrix, 4);
+    std::vector<double> expected = serial.getShortestPaths();
+    EXPECT_EQ(parallel.getShortestPaths(), expected);
+
+    // The paths of the parallel solver are valid shortest paths.
+    for (int end = 0; end < n; end++) {
+      if (expected[end] == inf || expected[end] == -inf) continue;
+      std::list<int> path;
+      parallel.reconstructShortestPath(end, path);
+      double cost = 0;
+      for (auto it = path.begin(); std::next(it) != path.end(); ++it) cost += matrix[*it][*std::next(it)];
+      EXPECT_EQ(path.front(), start);
+      EXPECT_EQ(path.back(), end);
+      EXPECT_EQ(cost, expected[end]);
+    }
+  }
+  std::vector<std::vector<double>> matrix;
+  EXPECT_THROW(BellmanFordAdjacencyMatrix(0, &matrix, 0), std::invalid_argument);
+}
+
+
+TEST_F(BellmanFordAdjacencyMatrixTest, testBatch) {
+  std::mt19937 rng(8);
+  for (int trial = 0; trial < 20; trial++) {
+    int n = 3 + 2 * trial;
+    auto matrix = randomMatrix(n, 3 * n, trial % 2 == 0 ? 0 : -2, 10, rng);
+    // More sources than one block, with repeats.
+    std::vector<int> sources;
+    for (int i = 0; i < 2 * n; i++) sources.push_back(i % n);
+
+    for (int numThreads : {1, 3}) {
+      BellmanFordAdjacencyMatrix solver(0, &matrix, numThreads);
+      std::vector<std::vector<int>> prev;
+      auto dists = solver.getShortestPaths(sources, &prev);
+      ASSERT_EQ(dists.size(), sources.size());
+      ASSERT_EQ(prev.size(), sources.size());
+      for (size_t s = 0; s < sources.size(); s++) {
+        BellmanFordAdjacencyMatrix serial(sources[s], &matrix);
+        EXPECT_EQ(dists[s], serial.getShortestPaths());
+        EXPECT_EQ(prev[s][sources[s]], -1);
+        for (int j = 0; j < n; j++) {
+          if (prev[s][j] == -1) continue;
+          EXPECT_EQ(dists[s][prev[s][j]] + matrix[prev[s][j]][j], dists[s][j]);
+        }
+      }
+    }
+  }
+}
+
+
+TEST_F(BellmanFordAdjacencyMatrixTest, testArbitrage) {
+  // Exchange rates between four currencies. With the weight -log(rate) a
+  // cycle whose rates multiply to more than one is a negative cycle.
+  std::vector<std::vector<double>> rates{
+    {1.0,   0.9,  0.8,  0},
+    {1.1,   1.0,  0.89, 0},
+    {1.26,  1.13, 1.0,  0},
+    {0.5,   0,    0,    1.0}};
+  int n = rates.size();
+  std::vector<std::vector<double>> matrix(n, std::vector<double>(n, inf));
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      if (rates[i][j] > 0) matrix[i][j] = -std::log(rates[i][j]);
+
+  BellmanFordAdjacencyMatrix solver(0, &matrix, 2);
+  auto dists = solver.getShortestPaths({0, 1, 2, 3});
+  for (int s = 0; s < 3; s++)
+    EXPECT_EQ(dists[s], (std::vector<double>{-inf, -inf, -inf, inf}));
+  // Currency 3 can be exchanged into the others, but not back.
+  EXPECT_EQ(dists[3], (std::vector<double>{-inf, -inf, -inf, 0}));
+}
+
+
+TEST_F(BellmanFordAdjacencyMatrixTest, benchmark) {
+  std::mt19937 rng(9);
+  int n = 200;
+  auto matrix = randomMatrix(n, n * n / 4, 1, 100, rng);
+  std::vector<int> sources;
+  for (int i = 0; i < 64; i++) sources.push_back(i);
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::vector<double>> expected;
+  for (int source : sources) {
+    BellmanFordAdjacencyMatrix solver(source, &matrix);
+    expected.push_back(solver.getShortestPaths());
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  BellmanFordAdjacencyMatrix batch(0, &matrix, ThreadPool::hardwareThreads());
+  EXPECT_EQ(batch.getShortestPaths(sources), expected);
+  auto t2 = std::chrono::steady_clock::now();
+
+  std::cout << sources.size() << " sources on a dense matrix of " << n << " nodes: serial "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, batch with "
+            << ThreadPool::hardwareThreads() << " threads "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+}
+
+} // namespace dsa
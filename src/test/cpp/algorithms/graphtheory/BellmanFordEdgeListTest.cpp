@@ -0,0 +1,180 @@
+/*
+ * @file   BellmanFordEdgeListTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Bellman-Ford edge list Unit Test.
+ */
+
+#include <gtest\gtest.h>
+#include <BellmanFordEdgeList.h>
+#include <BellmanFordAdjacencyMatrix.h>
+#include <CsrGraph.h>
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <limits>
+
+namespace dsa {
+
+using Method = BellmanFordEdgeList::Method;
+
+class BellmanFordEdgeListTest : public ::testing::Test {
+protected:
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // A random directed graph with integer costs in [minCost, maxCost], given
+  // as a Graph and as an adjacency matrix.
+  void randomGraph(int n, int m, int minCost, int maxCost, std::mt19937& rng,
+                   Graph& graph, std::vector<std::vector<double>>& matrix) {
+    std::uniform_int_distribution<int> node(0, n - 1), cost(minCost, maxCost);
+    matrix.assign(n, std::vector<double>(n, inf));
+    for (int i = 0; i < n; i++) matrix[i][i] = 0;
+    for (int i = 0; i < m; i++) {
+      int u = node(rng), v = node(rng);
+      if (u == v || matrix[u][v] != inf) continue;
+      double c = cost(rng);
+      graph.addDirectedEdge(u, v, c);
+      matrix[u][v] = c;
+    }
+  }
+
+  // Every path leads from the start to its end node over edges of the graph
+  // and costs the shortest distance.
+  void expectPaths(const Graph& graph, int start, BellmanFordEdgeList& solver) {
+    std::vector<double> dist = solver.getShortestPaths();
+    for (int end = 0; end < (int)graph.size(); end++) {
+      std::list<int> path;
+      solver.reconstructShortestPath(end, path);
+      if (dist[end] == inf || dist[end] == -inf) {
+        EXPECT_TRUE(path.empty());
+        continue;
+      }
+      ASSERT_FALSE(path.empty());
+      EXPECT_EQ(path.front(), start);
+      EXPECT_EQ(path.back(), end);
+      double cost = 0;
+      for (auto it = path.begin(); std::next(it) != path.end(); ++it)
+        cost += graph.edges(*it).at(*std::next(it));
+      EXPECT_EQ(cost, dist[end]);
+    }
+  }
+};
+
+
+TEST_F(BellmanFordEdgeListTest, testNegativeCycle) {
+  Graph graph(9);
+  graph.addDirectedEdge(0, 1, 1);
+  graph.addDirectedEdge(1, 2, 1);
+  graph.addDirectedEdge(2, 4, 1);
+  graph.addDirectedEdge(4, 3, -3);
+  graph.addDirectedEdge(3, 2, 1);
+  graph.addDirectedEdge(1, 5, 4);
+  graph.addDirectedEdge(1, 6, 4);
+  graph.addDirectedEdge(5, 6, 5);
+  graph.addDirectedEdge(6, 7, 4);
+  graph.addDirectedEdge(5, 7, 3);
+
+  std::vector<double> expected{0, 1, -inf, -inf, -inf, 5, 5, 8, inf};
+  for (Method method : {Method::Rounds, Method::Queue}) {
+    BellmanFordEdgeList solver(0, &graph, method);
+    EXPECT_EQ(solver.getShortestPaths(), expected);
+    EXPECT_TRUE(solver.hasNegativeCycle());
+    std::list<int> path;
+    solver.reconstructShortestPath(7, path);
+    EXPECT_EQ(path, (std::list<int>{0, 1, 5, 7}));
+    solver.reconstructShortestPath(3, path);
+    EXPECT_TRUE(path.empty());
+    solver.reconstructShortestPath(0, path);
+    EXPECT_EQ(path, std::list<int>{0});
+  }
+  EXPECT_THROW(BellmanFordEdgeList(9, &graph), std::invalid_argument);
+}
+
+
+TEST_F(BellmanFordEdgeListTest, testEarlyExit) {
+  // A path in edge list order needs a single round to settle and a second
+  // one to see that nothing changes.
+  int n = 1000;
+  Graph graph(n);
+  for (int i = 0; i + 1 < n; i++) graph.addDirectedEdge(i, i + 1, -1);
+
+  BellmanFordEdgeList solver(0, &graph, Method::Rounds);
+  EXPECT_EQ(solver.getShortestPaths()[n - 1], -(n - 1));
+  EXPECT_FALSE(solver.hasNegativeCycle());
+  EXPECT_EQ(solver.rounds(), 2);
+  EXPECT_EQ(solver.relaxations(), n - 1);
+}
+
+
+TEST_F(BellmanFordEdgeListTest, testAgainstAdjacencyMatrix) {
+  std::mt19937 rng(5);
+  for (int trial = 0; trial < 60; trial++) {
+    int n = 2 + trial % 40, m = n * (1 + trial % 4);
+    // Every third trial only has non negative cycles.
+    int minCost = trial % 3 == 0 ? 0 : -4;
+    Graph graph(n);
+    std::vector<std::vector<double>> matrix;
+    randomGraph(n, m, minCost, 10, rng, graph, matrix);
+    int start = trial % n;
+
+    BellmanFordAdjacencyMatrix reference(start, &matrix);
+    std::vector<double> expected = reference.getShortestPaths();
+    for (Method method : {Method::Rounds, Method::Queue}) {
+      BellmanFordEdgeList solver(start, &graph, method);
+      EXPECT_EQ(solver.getShortestPaths(), expected);
+      expectPaths(graph, start, solver);
+    }
+  }
+}
+
+
+TEST_F(BellmanFordEdgeListTest, benchmark) {
+  std::mt19937 rng(6);
+  int n = 600, m = 4 * n;
+  Graph graph(n);
+  std::vector<std::vector<double>> matrix;
+  randomGraph(n, m, -1, 20, rng, graph, matrix);
+
+  auto t0 = std::chrono::steady_clock::now();
+  BellmanFordAdjacencyMatrix reference(0, &matrix);
+  std::vector<double> expected = reference.getShortestPaths();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "Adjacency matrix, " << n << " nodes: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  for (Method method : {Method::Rounds, Method::Queue}) {
+    t0 = std::chrono::steady_clock::now();
+    BellmanFordEdgeList solver(0, &graph, method);
+    EXPECT_EQ(solver.getShortestPaths(), expected);
+    t1 = std::chrono::steady_clock::now();
+    std::cout << (method == Method::Rounds ? "Edge list rounds: " : "Edge list queue: ")
+              << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() << "us, "
+              << solver.relaxations() << " relaxations" << std::endl;
+  }
+
+  // A larger sparse graph, too big for the matrix.
+  n = 200000;
+  std::vector<Edge> edges;
+  std::uniform_int_distribution<int> node(0, n - 1), cost(-1, 20);
+  for (int i = 0; i < 4 * n; i++) edges.push_back({node(rng), node(rng), (double)cost(rng)});
+  for (int i = 0; i + 1 < n; i++) edges.push_back({i, i + 1, 30});
+  CsrGraph csr(n, edges);
+  std::vector<double> dist;
+  for (auto method : {BasicBellmanFordEdgeList<CsrGraph>::Method::Rounds, BasicBellmanFordEdgeList<CsrGraph>::Method::Queue}) {
+    t0 = std::chrono::steady_clock::now();
+    BasicBellmanFordEdgeList<CsrGraph> solver(0, &csr, method);
+    std::vector<double> result = solver.getShortestPaths();
+    t1 = std::chrono::steady_clock::now();
+    std::cout << "Sparse graph of " << n << " nodes, "
+              << (method == BasicBellmanFordEdgeList<CsrGraph>::Method::Rounds ? "rounds: " : "queue: ")
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, "
+              << solver.rounds() << " rounds, " << solver.relaxations() << " relaxations" << std::endl;
+    if (dist.empty()) dist = result;
+    else EXPECT_EQ(result, dist);
+  }
+}
+
+} // namespace dsa
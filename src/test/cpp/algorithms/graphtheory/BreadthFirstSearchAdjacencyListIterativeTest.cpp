@@ -13,6 +13,7 @@
 #include <TopologicalSortAdjacencyList.h>
 #include <DijkstrasShortestPathAdjacencyList.h>
 #include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+#include <CsrGraph.h>
 
 #include <chrono>
 #include <random>
@@ -79,6 +80,83 @@ std::vector<std::vector<double>> generateRandomGraph(Graph &graph1, int n) {
 }
 
 
+// Edges of an R-MAT graph with 2^scale nodes and edgeFactor * 2^scale undirected
+// edges, a low diameter graph with a skewed degree distribution like a social
+// network. Parallel edges are kept.
+std::vector<Edge> generateRmatEdges(int scale, int edgeFactor, std::mt19937 &rng) {
+  std::vector<Edge> edges;
+  std::uniform_real_distribution<double> coin(0, 1);
+  long long m = (long long)edgeFactor << scale;
+  for (long long i = 0; i < m; i++) {
+    int u = 0, v = 0;
+    for (int bit = 0; bit < scale; bit++) {
+      double r = coin(rng);
+      if (r < 0.57) continue;
+      if (r < 0.76) v |= 1 << bit;
+      else if (r < 0.95) u |= 1 << bit;
+      else { u |= 1 << bit; v |= 1 << bit; }
+    }
+    if (u == v) continue;
+    edges.push_back({u, v, 1});
+    edges.push_back({v, u, 1});
+  }
+  return edges;
+}
+
+
+// Hop distances from 'start' with a plain queue, -1 for unreachable nodes.
+template <typename GRAPH>
+std::vector<int> referenceLevels(const GRAPH &graph, int start) {
+  std::vector<int> level(graph.size(), -1);
+  std::queue<int> queue;
+  level[start] = 0;
+  queue.push(start);
+  while (!queue.empty()) {
+    int node = queue.front();
+    queue.pop();
+    for (auto edge: graph.edges(node))
+      if (level[edge.first] == -1) {
+        level[edge.first] = level[node] + 1;
+        queue.push(edge.first);
+      }
+  }
+  return level;
+}
+
+
+// Checks that 'prev' is a BFS tree of 'graph' from 'start' in the layout of bfs().
+template <typename GRAPH>
+void expectBfsTree(const GRAPH &graph, int start, const std::vector<int> &prev) {
+  std::vector<int> level = referenceLevels(graph, start);
+  ASSERT_EQ(prev.size(), level.size());
+  for (int v = 0; v < (int)graph.size(); v++) {
+    if (v == start || level[v] == -1) {
+      EXPECT_EQ(prev[v], 0);
+      continue;
+    }
+    int parent = prev[v];
+    EXPECT_EQ(level[parent], level[v] - 1);
+    bool edge = false;
+    for (auto e: graph.edges(parent)) edge |= e.first == v;
+    EXPECT_TRUE(edge);
+  }
+}
+
+
+// Checks the level statistics of the last direction optimizing search.
+template <typename GRAPH, typename SOLVER>
+void expectLevelStats(const GRAPH &graph, int start, const SOLVER &solver) {
+  std::vector<int> level = referenceLevels(graph, start);
+  int depth = *std::max_element(level.begin(), level.end());
+  std::vector<int> levelSize(depth + 1, 0);
+  for (int d : level) if (d >= 0) levelSize[d]++;
+
+  auto &stats = solver.levelStats();
+  ASSERT_EQ((int)stats.size(), depth + 1);
+  for (int d = 0; d <= depth; d++) EXPECT_EQ(stats[d].frontierSize, levelSize[d]);
+}
+
+
 #if 1
 TEST(BreadthFirstSearchAdjacencyListIterativeTest, testSingletonGraph) {
 
@@ -167,6 +245,254 @@ TEST(BreadthFirstSearchAdjacencyListIterativeTest, testShortestPathAgainstBellma
 }
 
 
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testDirectionOptimizingAgainstQueue) {
+  std::mt19937 rng(7);
+  for (int n = 1; n <= 200; n += 19) {
+    for (bool directed : {false, true}) {
+      Graph graph(n);
+      std::uniform_int_distribution<int> node(0, n - 1);
+      for (int i = 0; i < 3 * n; i++) {
+        if (directed) graph.addDirectedEdge(node(rng), node(rng), 1);
+        else graph.addUnweightedUndirectedEdge(node(rng), node(rng));
+      }
+
+      // Default thresholds, always bottom-up after the first level and almost always top-down.
+      for (auto parameters : std::vector<std::pair<int, int>>{{14, 24}, {1 << 30, 1 << 30}, {1, 1}}) {
+        BreadthFirstSearchAdjacencyListIterative solver(&graph);
+        solver.setDirectionParameters(parameters.first, parameters.second);
+        for (int start = 0; start < n; start += 5) {
+          expectBfsTree(graph, start, solver.bfsDirectionOptimizing(start));
+          expectLevelStats(graph, start, solver);
+        }
+      }
+    }
+  }
+
+  Graph graph(3);
+  BreadthFirstSearchAdjacencyListIterative solver(&graph);
+  EXPECT_THROW(solver.bfsDirectionOptimizing(3), std::invalid_argument);
+  EXPECT_THROW(solver.setDirectionParameters(0, 24), std::invalid_argument);
+}
+
+
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testDirectionOptimizingAfterGraphChanges) {
+  // Edges added after a search must be seen by the bottom-up steps as well
+  // once the solver is told of the change.
+  Graph graph(6);
+  graph.addUnweightedUndirectedEdge(0, 1);
+  graph.addUnweightedUndirectedEdge(1, 2);
+  BreadthFirstSearchAdjacencyListIterative solver(&graph);
+  solver.setDirectionParameters(1, 1);
+  expectBfsTree(graph, 0, solver.bfsDirectionOptimizing(0));
+
+  graph.addUnweightedUndirectedEdge(2, 3);
+  graph.addUnweightedUndirectedEdge(0, 4);
+  graph.addUnweightedUndirectedEdge(4, 5);
+  solver.invalidate();
+  std::vector<int> prev = solver.bfsDirectionOptimizing(0);
+  expectBfsTree(graph, 0, prev);
+  EXPECT_EQ(prev, solver.bfs(0));
+
+  // A rebuilt graph with the same node and edge count, and in edges from setReverse().
+  Graph star(10);
+  for (int v = 1; v < 10; v++) star.addUnweightedUndirectedEdge(0, v);
+  BreadthFirstSearchAdjacencyListIterative starSolver(&star);
+  starSolver.setDirectionParameters(1, 1);
+  expectBfsTree(star, 0, starSolver.bfsDirectionOptimizing(0));
+
+  star.clear();
+  star.addUnweightedUndirectedEdge(0, 1);
+  for (int v = 2; v < 10; v++) star.addUnweightedUndirectedEdge(1, v);
+  starSolver.invalidate();
+  prev = starSolver.bfsDirectionOptimizing(0);
+  expectBfsTree(star, 0, prev);
+  EXPECT_EQ(prev, starSolver.bfs(0));
+  for (int v = 2; v < 10; v++) EXPECT_EQ(prev[v], 1);
+
+  CsrGraph reverse = CsrGraph::reverseOf(star);
+  BreadthFirstSearchAdjacencyListIterative givenSolver(&star);
+  givenSolver.setDirectionParameters(1, 1);
+  givenSolver.setReverse(&reverse);
+  EXPECT_EQ(givenSolver.bfsDirectionOptimizing(0), prev);
+  givenSolver.setSymmetric(true);
+  EXPECT_EQ(givenSolver.bfsDirectionOptimizing(0), prev);
+}
+
+
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testDirectionOptimizingSamePrevOnTree) {
+  // Every node of a tree has a single parent, so both searches must agree exactly.
+  std::mt19937 rng(3);
+  int n = 5000;
+  Graph graph(n);
+  for (int v = 1; v < n; v++) graph.addUnweightedUndirectedEdge(std::uniform_int_distribution<int>(0, v - 1)(rng), v);
+
+  BreadthFirstSearchAdjacencyListIterative solver(&graph);
+  for (int start : {0, 17, n - 1}) {
+    EXPECT_EQ(solver.bfsDirectionOptimizing(start), solver.bfs(start));
+    bool bottomUp = false;
+    for (auto &level : solver.levelStats()) bottomUp |= level.bottomUp;
+    EXPECT_TRUE(bottomUp);
+  }
+}
+
+
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testDirectionOptimizingOnRmat) {
+  std::mt19937 rng(1);
+  int scale = 16;
+  CsrGraph csr(1 << scale, generateRmatEdges(scale, 16, rng));
+  int start = 0;
+
+  BasicBreadthFirstSearchAdjacencyListIterative<CsrGraph> solver(&csr);
+  solver.bfsDirectionOptimizing(start); // Builds the in edges, later searches reuse them.
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<int> expected = solver.bfs(start);
+  auto t1 = std::chrono::steady_clock::now();
+  std::vector<int> prev = solver.bfsDirectionOptimizing(start);
+  auto t2 = std::chrono::steady_clock::now();
+  expectBfsTree(csr, start, prev);
+  expectLevelStats(csr, start, solver);
+
+  // The R-MAT edges come in both directions, the out edges serve as in edges.
+  BasicBreadthFirstSearchAdjacencyListIterative<CsrGraph> symmetric(&csr);
+  symmetric.setSymmetric(true);
+  auto t3 = std::chrono::steady_clock::now();
+  std::vector<int> symmetricPrev = symmetric.bfsDirectionOptimizing(start);
+  auto t4 = std::chrono::steady_clock::now();
+  expectBfsTree(csr, start, symmetricPrev);
+  expectLevelStats(csr, start, symmetric);
+
+  long long examined = 0;
+  for (unsigned d = 0; d < solver.levelStats().size(); d++) {
+    auto &level = solver.levelStats()[d];
+    examined += level.edgesExamined;
+    std::cout << "level " << d << (level.bottomUp ? " bottom-up" : " top-down ")
+              << " frontier " << level.frontierSize << " edges " << level.edgesExamined << std::endl;
+  }
+  std::cout << "R-MAT scale " << scale << " with " << csr.edgeCount() << " edges: bfs "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, direction optimizing "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms examining "
+            << examined << " edges, symmetric "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t4 - t3).count() << "ms" << std::endl;
+  EXPECT_LT(examined, (long long)csr.edgeCount());
+  EXPECT_LE(t2 - t1, t1 - t0);
+}
+
+
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testParallelAgainstQueue) {
+  std::mt19937 rng(13);
+  for (int n = 1; n <= 300; n += 23) {
+    // Parallel edges and self loops included.
+    std::vector<Edge> edges;
+    std::uniform_int_distribution<int> node(0, n - 1);
+    for (int i = 0; i < 4 * n; i++) edges.push_back({node(rng), node(rng), 1});
+    for (int i = 0; i < n; i++) edges.push_back(edges[i]);
+    CsrGraph graph(n, edges);
+
+    BasicBreadthFirstSearchAdjacencyListIterative<CsrGraph> solver(&graph);
+    for (int threads : {1, 2, 4}) {
+      for (int start = 0; start < n; start += 7) {
+        EXPECT_EQ(solver.bfsParallel(start, threads, true), solver.bfs(start));
+        expectBfsTree(graph, start, solver.bfsParallel(start, threads));
+      }
+    }
+  }
+
+  Graph graph(3);
+  BreadthFirstSearchAdjacencyListIterative solver(&graph);
+  EXPECT_THROW(solver.bfsParallel(-1, 2), std::invalid_argument);
+  EXPECT_THROW(solver.bfsParallel(0, 0), std::invalid_argument);
+}
+
+
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testParallelScalingOnRmat) {
+  std::mt19937 rng(2);
+  int scale = 17;
+  CsrGraph csr(1 << scale, generateRmatEdges(scale, 16, rng));
+  int start = 0;
+
+  BasicBreadthFirstSearchAdjacencyListIterative<CsrGraph> solver(&csr);
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<int> expected = solver.bfs(start);
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "R-MAT scale " << scale << " with " << csr.edgeCount() << " edges, bfs: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  int maxThreads = std::max(4, ThreadPool::hardwareThreads());
+  for (int threads = 1; threads <= maxThreads; threads *= 2) {
+    for (bool deterministic : {false, true}) {
+      solver.bfsParallel(start, threads, deterministic); // Starts the pool.
+      auto t2 = std::chrono::steady_clock::now();
+      std::vector<int> prev = solver.bfsParallel(start, threads, deterministic);
+      auto t3 = std::chrono::steady_clock::now();
+      if (deterministic) EXPECT_EQ(prev, expected);
+      else expectBfsTree(csr, start, prev);
+      std::cout << "  " << threads << " threads" << (deterministic ? " deterministic: " : ": ")
+                << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count() << "ms" << std::endl;
+    }
+  }
+}
+
+
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testBatchAgainstQueue) {
+  std::mt19937 rng(17);
+  for (int n = 1; n <= 150; n += 29) {
+    std::vector<Edge> edges;
+    std::uniform_int_distribution<int> node(0, n - 1);
+    for (int i = 0; i < 2 * n; i++) edges.push_back({node(rng), node(rng), 1});
+    CsrGraph graph(n, edges);
+    BasicBreadthFirstSearchAdjacencyListIterative<CsrGraph> solver(&graph);
+
+    // One partial batch, several batches and a repeated source.
+    for (int count : {1, 64, 150}) {
+      std::vector<int> sources;
+      for (int i = 0; i < count; i++) sources.push_back(node(rng));
+      std::vector<std::vector<int>> distances1, distances4;
+      auto prev1 = solver.bfsBatch(sources, &distances1);
+      auto prev4 = solver.bfsBatch<4>(sources, &distances4);
+      ASSERT_EQ(prev1.size(), sources.size());
+      EXPECT_EQ(prev1, prev4);
+      EXPECT_EQ(distances1, distances4);
+      for (int i = 0; i < count; i++) {
+        EXPECT_EQ(distances1[i], referenceLevels(graph, sources[i]));
+        expectBfsTree(graph, sources[i], prev1[i]);
+      }
+    }
+  }
+
+  Graph graph(3);
+  BreadthFirstSearchAdjacencyListIterative solver(&graph);
+  EXPECT_TRUE(solver.bfsBatch({}).empty());
+  EXPECT_THROW(solver.bfsBatch({0, 3}), std::invalid_argument);
+}
+
+
+TEST(BreadthFirstSearchAdjacencyListIterativeTest, testBatchOnRmat) {
+  std::mt19937 rng(4);
+  int scale = 14, count = 256;
+  CsrGraph csr(1 << scale, generateRmatEdges(scale, 16, rng));
+  std::vector<int> sources;
+  for (int i = 0; i < count; i++) sources.push_back(std::uniform_int_distribution<int>(0, csr.size() - 1)(rng));
+
+  BasicBreadthFirstSearchAdjacencyListIterative<CsrGraph> solver(&csr);
+  std::vector<std::vector<int>> expected;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int source : sources) expected.push_back(solver.bfs(source));
+  auto t1 = std::chrono::steady_clock::now();
+  std::vector<std::vector<int>> distances1, distances4;
+  solver.bfsBatch<1>(sources, &distances1);
+  auto t2 = std::chrono::steady_clock::now();
+  solver.bfsBatch<4>(sources, &distances4);
+  auto t3 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(distances1, distances4);
+  for (int i = 0; i < count; i += 16) EXPECT_EQ(distances1[i], referenceLevels(csr, sources[i]));
+  std::cout << count << " sources on R-MAT scale " << scale << ": bfs "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, 64 wide batches "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, 256 wide batch "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count() << "ms" << std::endl;
+}
+
+
 TEST(DepthFirstSearchAdjacencyListIterativeTest, testFiveNodeGraph) {
   Graph graph(5);
 
@@ -9,6 +9,7 @@
 
 #include <gtest\gtest.h>
 #include <BridgesAdjacencyList.h>
+#include <CsrGraph.h>
 
 #include <chrono>
 #include <random>
@@ -39,6 +40,38 @@ std::set<std::pair<int, int>> getSortedBridges(const std::vector<int>& bridgeNod
 }
 
 
+// Undirected graph with both directions of every edge, parallel edges kept.
+CsrGraph undirectedGraph(int n, const std::vector<std::pair<int, int>>& edges) {
+  std::vector<Edge> directed;
+  for (auto e : edges) {
+    directed.push_back({e.first, e.second, 1});
+    directed.push_back({e.second, e.first, 1});
+  }
+  return CsrGraph(n, directed);
+}
+
+
+// Number of connected components among the nodes with 'alive' set, counting
+// the edges with 'use' set.
+int countComponents(int n, const std::vector<std::pair<int, int>>& edges,
+                    const std::vector<bool>& alive, const std::vector<bool>& use) {
+  std::vector<int> parent(n);
+  for (int i = 0; i < n; i++) parent[i] = i;
+  std::function<int(int)> find = [&](int x) { return parent[x] == x ? x : parent[x] = find(parent[x]); };
+  int count = 0;
+  for (int i = 0; i < n; i++) count += alive[i];
+  for (unsigned i = 0; i < edges.size(); i++) {
+    int a = edges[i].first, b = edges[i].second;
+    if (!use[i] || !alive[a] || !alive[b]) continue;
+    if (find(a) != find(b)) {
+      parent[find(a)] = find(b);
+      count--;
+    }
+  }
+  return count;
+}
+
+
 // Every edge should be a bridge if the input a tree
 TEST(BridgesAdjacencyListTest, testTreeCase) {
   Graph graph(12);
@@ -151,4 +184,102 @@ TEST(BridgesAdjacencyListTest, testDisconnectedGraph) {
   EXPECT_EQ(sortedBridges, expected);
 }
 
+
+TEST(BridgesAdjacencyListTest, testParallelEdges) {
+  // The doubled edge 0 - 1 is not a bridge, 1 - 2 is.
+  CsrGraph graph = undirectedGraph(4, {{0, 1}, {1, 0}, {1, 2}, {2, 2}});
+  BasicBridgesAdjacencyList<CsrGraph> solver(&graph);
+
+  const std::set<std::pair<int, int>> expected{std::make_pair(1, 2)};
+  EXPECT_EQ(getSortedBridges(solver.findBridges()), expected);
+  EXPECT_EQ(solver.findArticulationPoints(), std::vector<int>{1});
+  EXPECT_EQ(solver.biconnectedComponentCount(), 2);
+
+  std::vector<std::vector<int>> components = solver.getBiconnectedComponents();
+  std::sort(components.begin(), components.end());
+  std::vector<std::vector<int>> expectedComponents{{0, 1}, {1, 2}};
+  EXPECT_EQ(components, expectedComponents);
+}
+
+
+TEST(BridgesAdjacencyListTest, testAgainstBruteForce) {
+  std::mt19937 rng(12);
+  for (int n = 1; n <= 40; n += 3) {
+    for (int density : {1, 2}) {
+      std::uniform_int_distribution<int> node(0, n - 1);
+      std::vector<std::pair<int, int>> edges;
+      for (int i = 0; i < density * n; i++) edges.push_back({node(rng), node(rng)});
+      CsrGraph graph = undirectedGraph(n, edges);
+      BasicBridgesAdjacencyList<CsrGraph> solver(&graph);
+
+      std::vector<bool> alive(n, true), use(edges.size(), true);
+      int components = countComponents(n, edges, alive, use);
+
+      // A bridge is an edge whose removal disconnects its ends.
+      std::set<std::pair<int, int>> bridges;
+      for (unsigned i = 0; i < edges.size(); i++) {
+        if (edges[i].first == edges[i].second) continue;
+        use[i] = false;
+        if (countComponents(n, edges, alive, use) > components)
+          bridges.insert({std::min(edges[i].first, edges[i].second), std::max(edges[i].first, edges[i].second)});
+        use[i] = true;
+      }
+      EXPECT_EQ(getSortedBridges(solver.findBridges()), bridges);
+
+      // An articulation point is a node whose removal disconnects the rest.
+      std::vector<int> articulationPoints;
+      for (int u = 0; u < n; u++) {
+        alive[u] = false;
+        if (countComponents(n, edges, alive, use) > components) articulationPoints.push_back(u);
+        alive[u] = true;
+      }
+      EXPECT_EQ(solver.findArticulationPoints(), articulationPoints);
+
+      // Every block is connected without articulation point, and the blocks
+      // of a connected component with k nodes have sum(|block| - 1) = k - 1.
+      std::vector<std::pair<int, int>> solverEdges = solver.getEdges();
+      const std::vector<int>& ids = solver.getEdgeComponentIds();
+      std::vector<std::vector<int>> blocks = solver.getBiconnectedComponents();
+      ASSERT_EQ((int)blocks.size(), solver.biconnectedComponentCount());
+      int blockSum = 0;
+      for (unsigned b = 0; b < blocks.size(); b++) {
+        blockSum += blocks[b].size() - 1;
+        std::vector<bool> inBlock(n, false), blockEdge(solverEdges.size());
+        for (int u : blocks[b]) inBlock[u] = true;
+        for (unsigned i = 0; i < solverEdges.size(); i++) blockEdge[i] = ids[i] == (int)b;
+        EXPECT_EQ(countComponents(n, solverEdges, inBlock, blockEdge), 1);
+        if (blocks[b].size() > 2) {
+          for (int u : blocks[b]) {
+            inBlock[u] = false;
+            EXPECT_EQ(countComponents(n, solverEdges, inBlock, blockEdge), 1);
+            inBlock[u] = true;
+          }
+        }
+      }
+      std::vector<bool> touched(n, false);
+      for (auto e : solverEdges) touched[e.first] = touched[e.second] = true;
+      int nonIsolated = 0;
+      for (int u = 0; u < n; u++) nonIsolated += touched[u];
+      EXPECT_EQ(blockSum, nonIsolated - countComponents(n, solverEdges, touched, std::vector<bool>(solverEdges.size(), true)));
+    }
+  }
+}
+
+
+TEST(BridgesAdjacencyListTest, testDeepGraph) {
+  // A path of a few million nodes, far deeper than the call stack allows,
+  // closed into a cycle with a tail.
+  int n = 3000000;
+  std::vector<std::pair<int, int>> edges;
+  for (int i = 0; i + 1 < n; i++) edges.push_back({i, i + 1});
+  edges.push_back({n - 2, 0});
+  CsrGraph graph = undirectedGraph(n, edges);
+  BasicBridgesAdjacencyList<CsrGraph> solver(&graph);
+
+  const std::set<std::pair<int, int>> expected{std::make_pair(n - 2, n - 1)};
+  EXPECT_EQ(getSortedBridges(solver.findBridges()), expected);
+  EXPECT_EQ(solver.findArticulationPoints(), std::vector<int>{n - 2});
+  EXPECT_EQ(solver.biconnectedComponentCount(), 2);
+}
+
 } // namespace dsa
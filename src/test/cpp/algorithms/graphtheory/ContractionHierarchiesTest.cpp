@@ -0,0 +1,214 @@
+/*
+ * @file   ContractionHierarchiesTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Unit test of the contraction hierarchies preprocessing and query.
+ */
+
+#include <gtest\gtest.h>
+#include <DijkstrasShortestPathAdjacencyList.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+#include <DijkstrasShortestPathBidirectional.h>
+#include <ContractionHierarchies.h>
+#include <CsrGraph.h>
+#include "ShortestPathTestHelpers.h"
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace dsa {
+
+class ContractionHierarchiesTest : public ShortestPathTest {
+};
+
+
+TEST_F(ContractionHierarchiesTest, testEightNodeGraph) {
+  Graph graph(8);
+  graph.addDirectedEdge(6, 0, 1.1);
+  graph.addDirectedEdge(6, 2, 0.2);
+  graph.addDirectedEdge(3, 4, 3.6);
+  graph.addDirectedEdge(6, 4, 0.4);
+  graph.addDirectedEdge(2, 0, 0.7);
+  graph.addDirectedEdge(0, 1, 3.4);
+  graph.addDirectedEdge(4, 5, 6.9);
+  graph.addDirectedEdge(5, 6, 0.9);
+  graph.addDirectedEdge(3, 7, 8.2);
+  graph.addDirectedEdge(7, 5, 0.3);
+  graph.addDirectedEdge(1, 2, 4.6);
+  graph.addDirectedEdge(7, 3, 6.4);
+  graph.addDirectedEdge(5, 0, 10.1);
+
+  ContractionHierarchy ch(&graph);
+  ContractionHierarchyQuery query(&ch);
+  DijkstrasShortestPathAdjacencyList dijkstra(&graph);
+
+  std::list<int> expected{3, 7, 5, 6, 2, 0};
+  EXPECT_EQ(query.reconstructPath(3, 0), expected);
+  EXPECT_NEAR(query.shortestPath(3, 0), 10.3, EPS);
+  for (int s = 0; s < 8; s++)
+    for (int e = 0; e < 8; e++)
+      EXPECT_EQ(query.reconstructPath(s, e), dijkstra.reconstructPath(s, e));
+
+  std::vector<int> ranks;
+  for (int v = 0; v < 8; v++) ranks.push_back(ch.rank(v));
+  std::sort(ranks.begin(), ranks.end());
+  for (int v = 0; v < 8; v++) EXPECT_EQ(ranks[v], v);
+  EXPECT_THROW(query.shortestPath(0, 8), std::invalid_argument);
+}
+
+
+TEST_F(ContractionHierarchiesTest, testAgainstDijkstra) {
+  std::mt19937 rng(23);
+  for (int n = 1; n <= 90; n += 8) {
+    // Integer costs including zero, parallel edges and self loops.
+    Graph graph(n);
+    randomGraph(graph, n, 3 * n, std::uniform_int_distribution<int>(0, 10), rng);
+
+    DijkstrasShortestPathAdjacencyList dijkstra(&graph);
+    ContractionHierarchy ch(&graph);
+    ContractionHierarchyQuery query(&ch);
+    for (int s = 0; s < n; s++) {
+      for (int e = 0; e < n; e++) {
+        std::list<int> expected = dijkstra.reconstructPath(s, e);
+        std::list<int> path = query.reconstructPath(s, e);
+        if (expected.empty()) {
+          EXPECT_TRUE(path.empty());
+          EXPECT_EQ(query.shortestPath(s, e), inf);
+          continue;
+        }
+        double cost = pathCost(graph, expected);
+        EXPECT_NEAR(query.shortestPath(s, e), cost, EPS);
+        EXPECT_EQ(path.front(), s);
+        EXPECT_EQ(path.back(), e);
+        EXPECT_NEAR(pathCost(graph, path), cost, EPS);
+      }
+    }
+  }
+}
+
+
+TEST_F(ContractionHierarchiesTest, testParallelAndSerialization) {
+  std::mt19937 rng(29);
+  Graph graph(900);
+  gridGraph(graph, 30, 30, rng);
+
+  int calls = 0, last = 0;
+  ContractionHierarchy serial(&graph);
+  ContractionHierarchy parallel(&graph, 4, [&](int done, int total) {
+    EXPECT_GT(done, last);
+    EXPECT_EQ(total, 900);
+    last = done;
+    calls++;
+  });
+  EXPECT_EQ(last, 900);
+  EXPECT_GT(calls, 0);
+
+  // The rounds do not depend on the thread count.
+  std::stringstream a, b;
+  serial.save(a);
+  parallel.save(b);
+  EXPECT_EQ(a.str(), b.str());
+  for (int v = 0; v < 900; v++) EXPECT_EQ(serial.rank(v), parallel.rank(v));
+
+  ContractionHierarchy loaded(a);
+  EXPECT_EQ(loaded.shortcutCount(), serial.shortcutCount());
+  std::stringstream c;
+  loaded.save(c);
+  EXPECT_EQ(c.str(), b.str());
+
+  ContractionHierarchyQuery query1(&serial), query2(&loaded);
+  for (int s = 0; s < 900; s += 37)
+    for (int e = 0; e < 900; e += 11)
+      EXPECT_EQ(query1.reconstructPath(s, e), query2.reconstructPath(s, e));
+
+  std::stringstream garbage("not a hierarchy");
+  EXPECT_THROW(ContractionHierarchy bad(garbage), std::invalid_argument);
+  std::string truncated = b.str().substr(0, b.str().size() / 2);
+  std::stringstream half(truncated);
+  EXPECT_THROW(ContractionHierarchy bad(half), std::invalid_argument);
+
+  // Hand written files of three nodes with one upward edge and no downward
+  // edges.
+  auto craft = [](std::vector<int32_t> ranks, int32_t from, int32_t to, int32_t mid) {
+    std::stringstream file;
+    auto put = [&](auto value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+    put((uint32_t)0x31484344);
+    put((uint32_t)ranks.size());
+    for (int32_t r : ranks) put(r);
+    put((uint32_t)1);
+    put(from);
+    put(to);
+    put(1.0);
+    put(mid);
+    put((uint32_t)0);
+    return file;
+  };
+  std::stringstream valid = craft({1, 0, 2}, 0, 2, 1);
+  EXPECT_EQ(ContractionHierarchy(valid).shortcutCount(), 1);
+  std::stringstream duplicateRank = craft({1, 1, 2}, 0, 2, -1);
+  EXPECT_THROW(ContractionHierarchy bad(duplicateRank), std::invalid_argument);
+  std::stringstream badEndpoint = craft({1, 0, 2}, 0, 3, -1);
+  EXPECT_THROW(ContractionHierarchy bad(badEndpoint), std::invalid_argument);
+  std::stringstream downhill = craft({1, 0, 2}, 2, 0, -1);
+  EXPECT_THROW(ContractionHierarchy bad(downhill), std::invalid_argument);
+  // A shortcut bypassing one of its own ends would never finish unpacking.
+  std::stringstream selfMiddle = craft({1, 0, 2}, 0, 2, 0);
+  EXPECT_THROW(ContractionHierarchy bad(selfMiddle), std::invalid_argument);
+  std::stringstream highMiddle = craft({0, 1, 2}, 0, 2, 1);
+  EXPECT_THROW(ContractionHierarchy bad(highMiddle), std::invalid_argument);
+
+  Graph negative(2);
+  negative.addDirectedEdge(0, 1, -1);
+  EXPECT_THROW(ContractionHierarchy bad(&negative), std::invalid_argument);
+}
+
+
+TEST_F(ContractionHierarchiesTest, testQueryBenchmark) {
+  std::mt19937 rng(31);
+  int rows = 120, cols = 120, n = rows * cols, queries = 200;
+  Graph graph(n);
+  gridGraph(graph, rows, cols, rng);
+  CsrGraph csr(graph);
+
+  auto t0 = std::chrono::steady_clock::now();
+  int threads = ThreadPool::hardwareThreads();
+  ContractionHierarchy ch(&csr, threads);
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "CH preprocessing of a " << rows << "x" << cols << " grid with " << threads << " threads: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, "
+            << ch.shortcutCount() << " shortcuts" << std::endl;
+
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < queries; i++) pairs.push_back({node(rng), node(rng)});
+
+  BasicDijkstrasShortestPathBidirectional<CsrGraph> bidirectional(&csr, 4);
+  ContractionHierarchyQuery query(&ch);
+  long long settled1 = 0, settled2 = 0;
+  std::vector<double> expected;
+  auto t2 = std::chrono::steady_clock::now();
+  for (auto q : pairs) {
+    expected.push_back(bidirectional.shortestPath(q.first, q.second));
+    settled1 += bidirectional.settledNodes();
+  }
+  auto t3 = std::chrono::steady_clock::now();
+  for (int i = 0; i < queries; i++) {
+    EXPECT_NEAR(query.shortestPath(pairs[i].first, pairs[i].second), expected[i], 1e-6);
+    settled2 += query.settledNodes();
+  }
+  auto t4 = std::chrono::steady_clock::now();
+
+  std::cout << "Bidirectional Dijkstra: " << std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count() / queries
+            << "us/query, settled/query: " << settled1 / queries << std::endl;
+  std::cout << "CH query: " << std::chrono::duration_cast<std::chrono::microseconds>(t4 - t3).count() / queries
+            << "us/query, settled/query: " << settled2 / queries << std::endl;
+  EXPECT_LT(settled2, settled1);
+}
+
+} // namespace dsa
@@ -0,0 +1,166 @@
+/*
+ * @file   CsrGraphTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   A CSR graph unit test. The graph algorithms must give the same
+ *          answers on a CsrGraph as on the Graph it was built from.
+ */
+
+#include <gtest\gtest.h>
+#include <CsrGraph.h>
+#include <BreadthFirstSearchAdjacencyListIterative.h>
+#include <DepthFirstSearchAdjacencyListIterative.h>
+#include <DijkstrasShortestPathAdjacencyList.h>
+#include <TarjanSccSolverAdjacencyList.h>
+#include <BridgesAdjacencyList.h>
+#include <TopologicalSortAdjacencyList.h>
+
+#include <random>
+#include <list>
+#include <vector>
+#include <algorithm>
+
+namespace dsa {
+
+void randomDirectedGraph(Graph &graph, int n, int m, std::mt19937 &rng, bool acyclic) {
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::uniform_int_distribution<int> cost(1, 20);
+  for (int i = 0; i < m; i++) {
+    int u = node(rng), v = node(rng);
+    if (acyclic) {
+      if (u == v) continue;
+      if (u > v) std::swap(u, v);
+    }
+    graph.addDirectedEdge(u, v, cost(rng));
+  }
+}
+
+
+TEST(CsrGraphTest, testBuildFromGraph) {
+  Graph graph(4);
+  graph.addDirectedEdge(0, 1, 1.5);
+  graph.addDirectedEdge(0, 2, 2.5);
+  graph.addDirectedEdge(2, 3, 0.5);
+
+  CsrGraph csr(graph);
+  EXPECT_EQ(csr.size(), 4u);
+  EXPECT_EQ(csr.edgeCount(), 3u);
+  EXPECT_EQ(csr.degree(0), 2);
+  EXPECT_EQ(csr.degree(1), 0);
+  EXPECT_EQ(csr.degree(3), 0);
+  EXPECT_TRUE(csr.edges(1).empty());
+  EXPECT_TRUE(csr.edges(42).empty());
+
+  for (int u = 0; u < 4; u++) {
+    std::vector<std::pair<int, double>> expected(graph.edges(u).begin(), graph.edges(u).end());
+    std::vector<std::pair<int, double>> actual(csr.edges(u).begin(), csr.edges(u).end());
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+
+TEST(CsrGraphTest, testBuildFromEdgeList) {
+  std::vector<Edge> edges{{2, 3, 0.5}, {0, 2, 2.5}, {0, 1, 1.5}, {0, 2, 4.0}};
+  CsrGraph csr(4, edges);
+
+  EXPECT_EQ(csr.edgeCount(), 4u);
+  std::vector<int> offsets{0, 3, 3, 4, 4};
+  EXPECT_EQ(csr.offsets(), offsets);
+
+  // Parallel edges are kept in input order.
+  std::vector<std::pair<int, double>> expected{{2, 2.5}, {1, 1.5}, {2, 4.0}};
+  std::vector<std::pair<int, double>> actual(csr.edges(0).begin(), csr.edges(0).end());
+  EXPECT_EQ(actual, expected);
+
+  std::vector<Edge> invalid{{0, 4, 1.0}};
+  EXPECT_THROW(CsrGraph(4, invalid), std::invalid_argument);
+}
+
+
+TEST(CsrGraphTest, testParallelReverseMatchesSerial) {
+  std::mt19937 rng(12);
+  Graph graph(500);
+  randomDirectedGraph(graph, 500, 3000, rng, false);
+  CsrGraph serial = CsrGraph::reverseOf(graph);
+
+  for (int threads : {1, 3, 8}) {
+    ThreadPool pool(threads);
+    CsrGraph parallel = CsrGraph::reverseOf(graph, pool);
+    EXPECT_EQ(parallel.offsets(), serial.offsets());
+    EXPECT_EQ(parallel.targets(), serial.targets());
+    EXPECT_EQ(parallel.weights(), serial.weights());
+  }
+
+  Graph invalid(2);
+  invalid.addDirectedEdge(0, 5);
+  ThreadPool pool(2);
+  EXPECT_THROW(CsrGraph::reverseOf(invalid, pool), std::invalid_argument);
+}
+
+
+TEST(CsrGraphTest, testTraversalsMatchGraph) {
+  std::mt19937 rng(1234);
+  for (int n = 1; n <= 40; n++) {
+    Graph graph(n);
+    randomDirectedGraph(graph, n, 2 * n, rng, false);
+    CsrGraph csr(graph);
+
+    BreadthFirstSearchAdjacencyListIterative bfs1(&graph);
+    BasicBreadthFirstSearchAdjacencyListIterative<CsrGraph> bfs2(&csr);
+    BasicDepthFirstSearchAdjacencyListIterative<CsrGraph> dfs2(&csr);
+    DepthFirstSearchAdjacencyListIterative dfs1(&graph);
+    DijkstrasShortestPathAdjacencyList dijkstra1(&graph);
+    BasicDijkstrasShortestPathAdjacencyList<CsrGraph> dijkstra2(&csr);
+
+    for (int s = 0; s < n; s++) {
+      EXPECT_EQ(bfs1.bfs(s), bfs2.bfs(s));
+      EXPECT_EQ(dfs1.dfs(s), dfs2.dfs(s));
+      int e = (s * 7 + 3) % n;
+      EXPECT_EQ(dijkstra1.reconstructPath(s, e), dijkstra2.reconstructPath(s, e));
+    }
+
+    TarjanSccSolverAdjacencyList scc1(&graph);
+    BasicTarjanSccSolverAdjacencyList<CsrGraph> scc2(&csr);
+    EXPECT_EQ(scc1.sccCount(), scc2.sccCount());
+    EXPECT_EQ(scc1.getSccs(), scc2.getSccs());
+  }
+}
+
+
+TEST(CsrGraphTest, testBridgesMatchGraph) {
+  Graph graph(9);
+  graph.addUndirectedEdge(0, 1);
+  graph.addUndirectedEdge(0, 2);
+  graph.addUndirectedEdge(1, 2);
+  graph.addUndirectedEdge(2, 3);
+  graph.addUndirectedEdge(3, 4);
+  graph.addUndirectedEdge(2, 5);
+  graph.addUndirectedEdge(5, 6);
+  graph.addUndirectedEdge(6, 7);
+  graph.addUndirectedEdge(7, 8);
+  graph.addUndirectedEdge(8, 5);
+  CsrGraph csr(graph);
+
+  BridgesAdjacencyList solver1(&graph);
+  BasicBridgesAdjacencyList<CsrGraph> solver2(&csr);
+  EXPECT_EQ(solver1.findBridges(), solver2.findBridges());
+  EXPECT_EQ(solver2.findBridges().size(), 6u);
+}
+
+
+TEST(CsrGraphTest, testTopologicalSortMatchesGraph) {
+  std::mt19937 rng(4321);
+  for (int n = 2; n <= 40; n++) {
+    Graph graph(n);
+    randomDirectedGraph(graph, n, 3 * n, rng, true);
+    CsrGraph csr(graph);
+
+    TopologicalSortAdjacencyList solver1(&graph);
+    BasicTopologicalSortAdjacencyList<CsrGraph> solver2(&csr);
+    EXPECT_EQ(solver1.topologicalSort(), solver2.topologicalSort());
+    EXPECT_EQ(solver1.dagShortestPath(0), solver2.dagShortestPath(0));
+  }
+}
+
+} // namespace dsa
@@ -0,0 +1,191 @@
+/*
+ * @file   DeltaSteppingShortestPathTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Delta-stepping shortest path Unit Test.
+ */
+
+#include <gtest\gtest.h>
+#include <DeltaSteppingShortestPath.h>
+#include <DijkstrasShortestPathAdjacencyList.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+#include <CsrGraph.h>
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <limits>
+
+namespace dsa {
+
+class DeltaSteppingShortestPathTest : public ::testing::Test {
+protected:
+  const double inf = std::numeric_limits<double>::infinity();
+  const double EPS = 1e-9;
+
+  // A random directed graph with costs in [0, maxCost], integral if
+  // 'integral' is set.
+  Graph randomGraph(int n, int m, double maxCost, bool integral, std::mt19937& rng) {
+    Graph graph(n);
+    std::uniform_int_distribution<int> node(0, n - 1);
+    std::uniform_real_distribution<double> cost(0, maxCost);
+    for (int i = 0; i < m; i++) {
+      double c = integral ? (int)cost(rng) : cost(rng);
+      graph.addDirectedEdge(node(rng), node(rng), c);
+    }
+    return graph;
+  }
+
+  // The path of every node leads from the start over edges of the graph
+  // and costs its distance.
+  void expectPathTree(const Graph& graph, int start, DeltaSteppingShortestPath& solver) {
+    for (int v = 0; v < (int)graph.size(); v++) {
+      int u = solver.getPrev(v);
+      if (v == start || solver.getDistance(v) == inf) {
+        EXPECT_EQ(u, -1);
+        continue;
+      }
+      ASSERT_NE(u, -1);
+      EXPECT_NEAR(solver.getDistance(u) + graph.edges(u).at(v), solver.getDistance(v), EPS);
+    }
+  }
+};
+
+
+TEST_F(DeltaSteppingShortestPathTest, testSmallGraph) {
+  Graph graph(8);
+  graph.addDirectedEdge(6, 0, 1.1);
+  graph.addDirectedEdge(6, 2, 0.2);
+  graph.addDirectedEdge(3, 4, 3.6);
+  graph.addDirectedEdge(6, 4, 0.4);
+  graph.addDirectedEdge(2, 0, 0.7);
+  graph.addDirectedEdge(0, 1, 3.4);
+  graph.addDirectedEdge(4, 5, 6.9);
+  graph.addDirectedEdge(5, 6, 0.9);
+  graph.addDirectedEdge(3, 7, 8.2);
+  graph.addDirectedEdge(7, 5, 0.3);
+  graph.addDirectedEdge(1, 2, 4.6);
+  graph.addDirectedEdge(7, 3, 6.4);
+  graph.addDirectedEdge(5, 0, 10.1);
+
+  DijkstrasShortestPathAdjacencyList dijkstra(&graph);
+  for (double delta : {0.0, 0.1, 1.0, 100.0}) {
+    DeltaSteppingShortestPath solver(&graph, delta, 3);
+    EXPECT_EQ(solver.reconstructPath(3, 0), (std::list<int>{3, 7, 5, 6, 2, 0}));
+    EXPECT_NEAR(solver.getDistance(0), 10.3, EPS);
+    EXPECT_EQ(solver.reconstructPath(0, 3), std::list<int>());
+    EXPECT_EQ(solver.reconstructPath(4, 4), std::list<int>{4});
+    for (int end = 0; end < 8; end++) EXPECT_EQ(solver.reconstructPath(6, end), dijkstra.reconstructPath(6, end));
+  }
+
+  Graph negative(2);
+  negative.addDirectedEdge(0, 1, -1);
+  EXPECT_THROW(DeltaSteppingShortestPath solver(&negative), std::invalid_argument);
+  EXPECT_THROW(DeltaSteppingShortestPath solver(&graph, -1), std::invalid_argument);
+  DeltaSteppingShortestPath solver(&graph);
+  EXPECT_THROW(solver.solve(8), std::invalid_argument);
+}
+
+
+TEST_F(DeltaSteppingShortestPathTest, testAgainstDijkstra) {
+  std::mt19937 rng(10);
+  for (int trial = 0; trial < 30; trial++) {
+    int n = 50 + 20 * trial, m = n * (1 + trial % 6);
+    bool integral = trial % 2 == 0;
+    Graph graph = randomGraph(n, m, trial % 3 == 0 ? 1.0 : 100.0, integral, rng);
+    int start = trial % n;
+
+    DijkstrasShortestPathAdjacencyListWithDHeap reference(&graph);
+    reference.solve(start);
+    DijkstrasShortestPathAdjacencyList dijkstra(&graph);
+
+    for (double delta : {0.0, 0.5, 10.0, 1e9}) {
+      DeltaSteppingShortestPath solver(&graph, delta, 1 + trial % 4);
+      solver.solve(start);
+      for (int v = 0; v < n; v++) {
+        if (reference.getDistance(v) == inf) EXPECT_EQ(solver.getDistance(v), inf);
+        else if (integral) EXPECT_EQ(solver.getDistance(v), reference.getDistance(v));
+        else EXPECT_NEAR(solver.getDistance(v), reference.getDistance(v), EPS);
+      }
+      expectPathTree(graph, start, solver);
+
+      // The path costs of the plain Dijkstra solver for a few end nodes.
+      for (int end = 0; end < n; end += n / 7) {
+        std::list<int> path = dijkstra.reconstructPath(start, end);
+        if (path.empty()) {
+          EXPECT_EQ(solver.getDistance(end), inf);
+          continue;
+        }
+        double cost = 0;
+        for (auto it = path.begin(); std::next(it) != path.end(); ++it) cost += graph.edges(*it).at(*std::next(it));
+        EXPECT_NEAR(solver.getDistance(end), cost, EPS);
+      }
+    }
+  }
+}
+
+
+TEST_F(DeltaSteppingShortestPathTest, testSmallDelta) {
+  // The last node is a billion buckets away from the start.
+  int n = 1000;
+  Graph graph(n);
+  for (int i = 0; i + 1 < n; i++) graph.addDirectedEdge(i, i + 1, 1000);
+  graph.addDirectedEdge(0, n - 1, 1e12);
+
+  for (int threads : {1, 2, 4}) {
+    DeltaSteppingShortestPath solver(&graph, 0.001, threads);
+    solver.solve(0);
+    for (int v = 0; v < n; v++) EXPECT_EQ(solver.getDistance(v), 1000.0 * v);
+    EXPECT_EQ(solver.getPrev(n - 1), n - 2);
+    // One bucket per node and the stale entry of the direct edge.
+    EXPECT_EQ(solver.buckets(), n + 1);
+  }
+
+  // Bucket indexes beyond every integer type.
+  Graph far(2);
+  far.addDirectedEdge(0, 1, 1e30);
+  DeltaSteppingShortestPath solver(&far, 1e-10, 2);
+  EXPECT_EQ(solver.shortestPath(0, 1), 1e30);
+
+  // Distances beyond the largest bucket index.
+  Graph huge(3);
+  huge.addDirectedEdge(0, 1, 1e300);
+  huge.addDirectedEdge(1, 2, 1e300);
+  huge.addDirectedEdge(0, 2, 1e308);
+  DeltaSteppingShortestPath hugeSolver(&huge, 1e-300, 2);
+  EXPECT_EQ(hugeSolver.shortestPath(0, 2), 2e300);
+  EXPECT_EQ(hugeSolver.getPrev(2), 1);
+}
+
+
+TEST_F(DeltaSteppingShortestPathTest, benchmark) {
+  std::mt19937 rng(11);
+  int n = 500000, m = 8 * n;
+  std::vector<Edge> edges;
+  std::uniform_int_distribution<int> node(0, n - 1), cost(1, 1000);
+  for (int i = 0; i < m; i++) edges.push_back({node(rng), node(rng), (double)cost(rng)});
+  CsrGraph graph(n, edges);
+
+  auto t0 = std::chrono::steady_clock::now();
+  BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph> dijkstra(&graph);
+  dijkstra.solve(0);
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "Dijkstra with D-heap: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  int threads = ThreadPool::hardwareThreads();
+  for (double delta : {10.0, 0.0, 1000.0}) {
+    BasicDeltaSteppingShortestPath<CsrGraph> solver(&graph, delta, threads);
+    t0 = std::chrono::steady_clock::now();
+    solver.solve(0);
+    t1 = std::chrono::steady_clock::now();
+    std::cout << "Delta-stepping, delta " << solver.delta() << ", " << threads << " threads: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, "
+              << solver.buckets() << " buckets, " << solver.phases() << " light phases" << std::endl;
+    for (int v = 0; v < n; v += 997) EXPECT_EQ(solver.getDistance(v), dijkstra.getDistance(v));
+  }
+}
+
+} // namespace dsa
@@ -0,0 +1,185 @@
+/*
+ * @file   DijkstrasShortestPathAdjacencyListWithDHeapTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Unit test of the eager Dijkstra query engine and its indexed D-ary heap.
+ */
+
+#include <gtest\gtest.h>
+#include <DijkstrasShortestPathAdjacencyList.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+#include <CsrGraph.h>
+#include "ShortestPathTestHelpers.h"
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace dsa {
+
+class DijkstrasShortestPathAdjacencyListWithDHeapTest : public ShortestPathTest {
+protected:
+  // Single source shortest distances with plain Bellman-Ford relaxation.
+  std::vector<double> referenceDistances(const Graph& graph, int start) {
+    int n = graph.size();
+    std::vector<double> dist(n, inf);
+    dist[start] = 0;
+    for (int i = 1; i < n; i++)
+      for (int u = 0; u < n; u++)
+        if (dist[u] != inf)
+          for (auto edge: graph.edges(u))
+            dist[edge.first] = std::min(dist[edge.first], dist[u] + edge.second);
+    return dist;
+  }
+};
+
+
+TEST_F(DijkstrasShortestPathAdjacencyListWithDHeapTest, testHeapPollsInOrder) {
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> value(0, 100);
+  for (int degree : {2, 3, 4, 8}) {
+    int n = 500;
+    MinIndexedDHeap<double> heap(degree, n);
+    std::vector<double> values(n);
+    for (int i = 0; i < n; i++) heap.insert(i, values[i] = value(rng));
+    for (int i = 0; i < n; i += 3) {
+      values[i] -= 50;
+      heap.decrease(i, values[i]);
+    }
+
+    std::vector<double> polled;
+    while (!heap.isEmpty()) polled.push_back(values[heap.pollMinKeyIndex()]);
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(polled, values);
+  }
+
+  MinIndexedDHeap<double> heap(4, 10);
+  heap.insert(3, 1.0);
+  heap.insert(7, 0.5);
+  heap.clear();
+  EXPECT_TRUE(heap.isEmpty());
+  EXPECT_FALSE(heap.contains(3));
+  heap.insert(3, 2.0);
+  EXPECT_EQ(heap.peekMinKeyIndex(), 3);
+}
+
+
+TEST_F(DijkstrasShortestPathAdjacencyListWithDHeapTest, testAgainstBellmanFord) {
+  std::mt19937 rng(11);
+  for (int n = 1; n <= 60; n += 7) {
+    Graph graph(n);
+    randomGraph(graph, n, 3 * n, std::uniform_real_distribution<double>(0, 10), rng);
+
+    for (int degree : {2, 4, 8}) {
+      // One solver answers every query.
+      DijkstrasShortestPathAdjacencyListWithDHeap solver(&graph, degree);
+      EXPECT_EQ(solver.degree(), degree);
+      for (int s = 0; s < n; s++) {
+        std::vector<double> expected = referenceDistances(graph, s);
+        for (int e = 0; e < n; e++) {
+          double dist = solver.shortestPath(s, e);
+          if (expected[e] == inf) {
+            EXPECT_EQ(dist, inf);
+            EXPECT_TRUE(solver.reconstructPath(s, e).empty());
+          } else {
+            EXPECT_NEAR(dist, expected[e], EPS);
+            std::list<int> path = solver.reconstructPath(s, e);
+            EXPECT_EQ(path.front(), s);
+            EXPECT_EQ(path.back(), e);
+            EXPECT_NEAR(pathCost(graph, path), expected[e], EPS);
+          }
+        }
+
+        solver.solve(s);
+        for (int v = 0; v < n; v++) {
+          EXPECT_EQ(solver.isSettled(v), expected[v] != inf);
+          if (expected[v] == inf) EXPECT_EQ(solver.getDistance(v), inf);
+          else EXPECT_NEAR(solver.getDistance(v), expected[v], EPS);
+        }
+      }
+    }
+  }
+}
+
+
+TEST_F(DijkstrasShortestPathAdjacencyListWithDHeapTest, testEarlyExitResetsOnlyTouchedNodes) {
+  Graph graph(6);
+  graph.addDirectedEdge(0, 1, 1);
+  graph.addDirectedEdge(1, 2, 1);
+  graph.addDirectedEdge(2, 3, 1);
+  graph.addDirectedEdge(4, 5, 1);
+
+  DijkstrasShortestPathAdjacencyListWithDHeap solver(&graph);
+  EXPECT_EQ(solver.shortestPath(0, 1), 1);
+  EXPECT_EQ(solver.settledNodes(), 2);
+  EXPECT_FALSE(solver.isSettled(3));
+
+  // Nothing of the previous query leaks into the next one.
+  EXPECT_EQ(solver.shortestPath(4, 5), 1);
+  EXPECT_EQ(solver.getDistance(0), inf);
+  EXPECT_EQ(solver.getDistance(1), inf);
+  EXPECT_EQ(solver.getPrev(1), -1);
+  EXPECT_EQ(solver.shortestPath(0, 3), 3);
+  EXPECT_EQ(solver.shortestPath(3, 0), inf);
+
+  std::list<int> expected{0, 1, 2, 3};
+  EXPECT_EQ(solver.reconstructPath(0, 3), expected);
+  EXPECT_THROW(solver.shortestPath(0, 6), std::invalid_argument);
+}
+
+
+TEST_F(DijkstrasShortestPathAdjacencyListWithDHeapTest, testCsrGraph) {
+  std::mt19937 rng(3);
+  Graph graph(200);
+  randomGraph(graph, 200, 800, std::uniform_real_distribution<double>(0, 10), rng);
+  CsrGraph csr(graph);
+
+  DijkstrasShortestPathAdjacencyListWithDHeap solver1(&graph, 4);
+  BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph> solver2(&csr, 4);
+  for (int s = 0; s < 200; s += 13)
+    for (int e = 0; e < 200; e += 7)
+      EXPECT_EQ(solver1.shortestPath(s, e), solver2.shortestPath(s, e));
+}
+
+
+TEST_F(DijkstrasShortestPathAdjacencyListWithDHeapTest, testQueryPerformance) {
+  std::mt19937 rng(21);
+  int rows = 300, cols = 300, n = rows * cols, queries = 100;
+  Graph graph(n);
+  gridGraph(graph, rows, cols, rng);
+  CsrGraph csr(graph);
+
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < queries; i++) pairs.push_back({node(rng), node(rng)});
+
+  // Baseline: the lazy solver allocates its arrays and queue for every query.
+  std::vector<double> expected;
+  DijkstrasShortestPathAdjacencyList lazy(&graph);
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto q : pairs) expected.push_back(pathCost(graph, lazy.reconstructPath(q.first, q.second)));
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "Lazy Dijkstra " << queries << " queries on a " << rows << "x" << cols << " grid: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  for (int degree : {2, 4, 8}) {
+    BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph> solver(&csr, degree);
+    long long settled = 0;
+    auto t2 = std::chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+      double dist = solver.shortestPath(pairs[i].first, pairs[i].second);
+      settled += solver.settledNodes();
+      EXPECT_NEAR(dist, expected[i], 1e-6);
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    std::cout << "Eager Dijkstra D=" << degree << " on CSR: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count() << "ms"
+              << " settled/query: " << settled / queries << std::endl;
+  }
+}
+
+} // namespace dsa
@@ -0,0 +1,125 @@
+/*
+ * @file   DijkstrasShortestPathBidirectionalTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Unit test of the bidirectional Dijkstra solver.
+ */
+
+#include <gtest\gtest.h>
+#include <DijkstrasShortestPathAdjacencyList.h>
+#include <DijkstrasShortestPathAdjacencyListWithDHeap.h>
+#include <DijkstrasShortestPathBidirectional.h>
+#include <CsrGraph.h>
+#include "ShortestPathTestHelpers.h"
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace dsa {
+
+class DijkstrasShortestPathBidirectionalTest : public ShortestPathTest {
+};
+
+
+TEST_F(DijkstrasShortestPathBidirectionalTest, testEightNodeGraph) {
+  Graph graph(8);
+  graph.addDirectedEdge(6, 0, 1.1);
+  graph.addDirectedEdge(6, 2, 0.2);
+  graph.addDirectedEdge(3, 4, 3.6);
+  graph.addDirectedEdge(6, 4, 0.4);
+  graph.addDirectedEdge(2, 0, 0.7);
+  graph.addDirectedEdge(0, 1, 3.4);
+  graph.addDirectedEdge(4, 5, 6.9);
+  graph.addDirectedEdge(5, 6, 0.9);
+  graph.addDirectedEdge(3, 7, 8.2);
+  graph.addDirectedEdge(7, 5, 0.3);
+  graph.addDirectedEdge(1, 2, 4.6);
+  graph.addDirectedEdge(7, 3, 6.4);
+  graph.addDirectedEdge(5, 0, 10.1);
+
+  DijkstrasShortestPathAdjacencyList dijkstra(&graph);
+  DijkstrasShortestPathBidirectional solver(&graph);
+  std::list<int> expected{3, 7, 5, 6, 2, 0};
+  EXPECT_EQ(solver.reconstructPath(3, 0), expected);
+  EXPECT_EQ(solver.reconstructPath(3, 0), dijkstra.reconstructPath(3, 0));
+  EXPECT_NEAR(solver.shortestPath(3, 0), 10.3, EPS);
+
+  std::list<int> self{4};
+  EXPECT_EQ(solver.reconstructPath(4, 4), self);
+  EXPECT_TRUE(solver.reconstructPath(0, 3).empty());
+  EXPECT_EQ(solver.shortestPath(0, 3), inf);
+  EXPECT_THROW(solver.shortestPath(0, 8), std::invalid_argument);
+}
+
+
+TEST_F(DijkstrasShortestPathBidirectionalTest, testAgainstDijkstra) {
+  std::mt19937 rng(17);
+  for (int n = 1; n <= 80; n += 9) {
+    Graph graph(n);
+    // Integer costs (zero included) give many equally short paths.
+    randomGraph(graph, n, 3 * n, std::uniform_int_distribution<int>(0, 10), rng);
+
+    DijkstrasShortestPathAdjacencyListWithDHeap dijkstra(&graph);
+    DijkstrasShortestPathBidirectional solver(&graph);
+    for (int s = 0; s < n; s++) {
+      for (int e = 0; e < n; e++) {
+        double expected = dijkstra.shortestPath(s, e);
+        EXPECT_EQ(solver.shortestPath(s, e), expected);
+
+        std::list<int> path = solver.reconstructPath(s, e);
+        if (expected == inf) {
+          EXPECT_TRUE(path.empty());
+        } else {
+          EXPECT_EQ(path.front(), s);
+          EXPECT_EQ(path.back(), e);
+          EXPECT_NEAR(pathCost(graph, path), expected, EPS);
+        }
+      }
+    }
+  }
+}
+
+
+TEST_F(DijkstrasShortestPathBidirectionalTest, testSettledNodesBenchmark) {
+  std::mt19937 rng(21);
+  int rows = 300, cols = 300, n = rows * cols, queries = 100;
+  Graph graph(n);
+  gridGraph(graph, rows, cols, rng);
+  CsrGraph csr(graph);
+
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < queries; i++) pairs.push_back({node(rng), node(rng)});
+
+  BasicDijkstrasShortestPathAdjacencyListWithDHeap<CsrGraph> dijkstra(&csr, 4);
+  BasicDijkstrasShortestPathBidirectional<CsrGraph> solver(&csr, 4);
+
+  long long settled1 = 0, settled2 = 0;
+  std::vector<double> expected;
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto q : pairs) {
+    expected.push_back(dijkstra.shortestPath(q.first, q.second));
+    settled1 += dijkstra.settledNodes();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < queries; i++) {
+    EXPECT_NEAR(solver.shortestPath(pairs[i].first, pairs[i].second), expected[i], 1e-6);
+    settled2 += solver.settledNodes();
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  std::cout << "Dijkstra " << queries << " queries on a " << rows << "x" << cols << " grid: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms"
+            << " settled/query: " << settled1 / queries << std::endl;
+  std::cout << "Bidirectional Dijkstra: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms"
+            << " settled/query: " << settled2 / queries << std::endl;
+  EXPECT_LT(settled2, settled1);
+}
+
+} // namespace dsa
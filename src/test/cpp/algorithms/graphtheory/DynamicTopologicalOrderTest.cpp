@@ -0,0 +1,141 @@
+/*
+ * @file   DynamicTopologicalOrderTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Unit test of the dynamic topological order.
+ */
+
+#include <gtest\gtest.h>
+#include <DynamicTopologicalOrder.h>
+#include <TopologicalSortAdjacencyList.h>
+#include <CsrGraph.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace dsa {
+
+class DynamicTopologicalOrderTest : public ::testing::Test {
+protected:
+  // True if 'to' is reachable from 'from'.
+  bool reaches(const DynamicTopologicalOrder& dag, int from, int to) {
+    std::vector<bool> seen(dag.size(), false);
+    std::vector<int> stack{from};
+    seen[from] = true;
+    while (!stack.empty()) {
+      int u = stack.back();
+      stack.pop_back();
+      if (u == to) return true;
+      for (auto& edge : dag.edges(u))
+        if (!seen[edge.first]) {
+          seen[edge.first] = true;
+          stack.push_back(edge.first);
+        }
+    }
+    return false;
+  }
+
+  void expectValidOrder(const DynamicTopologicalOrder& dag) {
+    const std::vector<int>& order = dag.topologicalSort();
+    ASSERT_EQ(order.size(), dag.size());
+    for (unsigned i = 0; i < order.size(); i++) EXPECT_EQ(dag.position(order[i]), (int)i);
+    for (int u = 0; u < (int)dag.size(); u++)
+      for (auto& edge : dag.edges(u)) EXPECT_LT(dag.position(u), dag.position(edge.first));
+  }
+};
+
+
+TEST_F(DynamicTopologicalOrderTest, testSmallGraph) {
+  DynamicTopologicalOrder dag(7);
+  EXPECT_TRUE(dag.addEdge(0, 1, 3.));
+  EXPECT_TRUE(dag.addEdge(0, 2, 2.));
+  EXPECT_TRUE(dag.addEdge(0, 5, 3.));
+  EXPECT_TRUE(dag.addEdge(1, 3, 1.));
+  EXPECT_TRUE(dag.addEdge(1, 2, 6.));
+  EXPECT_TRUE(dag.addEdge(2, 3, 1.));
+  EXPECT_TRUE(dag.addEdge(2, 4, 10.));
+  EXPECT_TRUE(dag.addEdge(3, 4, 5.));
+  EXPECT_TRUE(dag.addEdge(5, 4, 7.));
+  EXPECT_TRUE(dag.addEdge(6, 0, 1.));
+  std::vector<int> expected{6, 0, 1, 2, 3, 5, 4};
+  EXPECT_EQ(dag.topologicalSort(), expected);
+
+  EXPECT_FALSE(dag.addEdge(4, 0));
+  EXPECT_FALSE(dag.addEdge(3, 3));
+  EXPECT_FALSE(dag.canAddEdge(4, 6));
+  EXPECT_TRUE(dag.canAddEdge(6, 4));
+  EXPECT_EQ(dag.edgeCount(), 10u);
+  EXPECT_EQ(dag.dagShortestPath(0)[4], 8);
+  EXPECT_EQ(dag.dagShortestPath(0)[6], -1);
+  EXPECT_THROW(dag.addEdge(0, 7), std::invalid_argument);
+
+  int node = dag.addNode();
+  EXPECT_EQ(node, 7);
+  EXPECT_TRUE(dag.addEdge(7, 6));
+  EXPECT_EQ(dag.topologicalSort().front(), 7);
+  expectValidOrder(dag);
+}
+
+
+TEST_F(DynamicTopologicalOrderTest, testRandomInsertions) {
+  std::mt19937 rng(4);
+  for (int n = 2; n <= 60; n += 9) {
+    DynamicTopologicalOrder dag(n);
+    Graph graph(n);
+    std::uniform_int_distribution<int> node(0, n - 1);
+    for (int i = 0; i < 3 * n; i++) {
+      int u = node(rng), v = node(rng);
+      bool cycle = u == v || reaches(dag, v, u);
+      EXPECT_EQ(dag.canAddEdge(u, v), !cycle);
+      EXPECT_EQ(dag.addEdge(u, v, i % 5), !cycle);
+      if (!cycle) graph.addDirectedEdge(u, v, i % 5);
+      expectValidOrder(dag);
+    }
+
+    // Same shortest paths as the static sort (without parallel edges).
+    DynamicTopologicalOrder copy(&graph);
+    TopologicalSortAdjacencyList solver(&graph);
+    for (int s = 0; s < n; s++) EXPECT_EQ(copy.dagShortestPath(s), solver.dagShortestPath(s));
+  }
+
+  Graph cyclic(2);
+  cyclic.addDirectedEdge(0, 1);
+  cyclic.addDirectedEdge(1, 0);
+  EXPECT_THROW(DynamicTopologicalOrder dag(&cyclic), std::invalid_argument);
+}
+
+
+TEST_F(DynamicTopologicalOrderTest, testPerformanceAgainstResorting) {
+  std::mt19937 rng(9);
+  int n = 20000, inserts = 40000, samples = 100;
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<std::pair<int, int>> edges;
+  for (int i = 0; i < inserts; i++) edges.push_back({node(rng), node(rng)});
+
+  auto t0 = std::chrono::steady_clock::now();
+  DynamicTopologicalOrder dag(n);
+  std::vector<Edge> accepted;
+  for (auto e : edges)
+    if (dag.addEdge(e.first, e.second)) accepted.push_back({e.first, e.second, 0});
+  auto t1 = std::chrono::steady_clock::now();
+  expectValidOrder(dag);
+
+  // Baseline: a full sort after an insertion, sampled at a few points of the sequence.
+  std::chrono::steady_clock::duration resort(0);
+  for (int i = 1; i <= samples; i++) {
+    CsrGraph graph(n, std::vector<Edge>(accepted.begin(), accepted.begin() + accepted.size() * i / samples));
+    auto t2 = std::chrono::steady_clock::now();
+    BasicTopologicalSortAdjacencyList<CsrGraph> solver(&graph);
+    EXPECT_EQ(solver.topologicalSort().size(), (unsigned)n);
+    resort += std::chrono::steady_clock::now() - t2;
+  }
+
+  std::cout << inserts << " insertions on " << n << " nodes (" << accepted.size() << " accepted), per insertion: dynamic order "
+            << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() / inserts << "us, full sort "
+            << std::chrono::duration_cast<std::chrono::microseconds>(resort).count() / samples << "us" << std::endl;
+}
+
+} // namespace dsa
@@ -78,6 +78,35 @@ protected:
   }
 
 
+  // The textbook triple loop over nested vectors, used as the reference
+  // the blocked solver is verified and benchmarked against.
+  void textbookFloydWarshall(std::vector<std::vector<double>> &dp) {
+    int n = dp.size();
+    for (int k = 0; k < n; k++)
+      for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+          if (dp[i][k] + dp[k][j] < dp[i][j]) dp[i][j] = dp[i][k] + dp[k][j];
+
+    for (int k = 0; k < n; k++)
+      for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+          if (dp[i][k] + dp[k][j] < dp[i][j]) dp[i][j] = NEGATIVE_INFINITY;
+  }
+
+  void addSeededRandomEdges(std::vector<std::vector<double>> &m, int count, double negativeRatio, std::mt19937 &rng) {
+    int n = m.size();
+    std::uniform_int_distribution<int> node(0, n - 1);
+    std::uniform_int_distribution<int> weight(0, 100);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    while (count-- > 0) {
+      int i = node(rng), j = node(rng);
+      if (i == j) continue;
+      int v = weight(rng);
+      m[i][j] = coin(rng) < negativeRatio ? -v : v;
+    }
+  }
+
+
   std::vector<std::vector<double>> matrix1, matrix2, matrix3;
 
   FloydWarshallSolverTest() {
@@ -276,5 +305,94 @@ TEST_F(FloydWarshallSolverTest, testNegativeCyclePropagation) {
   std::tie(isNegCycle, fwPath) = fw->reconstructShortestPath(s, e);
   EXPECT_TRUE(isNegCycle);
 }
+
+
+TEST_F(FloydWarshallSolverTest, testBlockedAgainstTextbook) {
+  std::mt19937 rng(2020);
+  for (int n : {1, 2, 5, 17, 63, 64, 65, 130}) {
+    for (double negativeRatio : {0.0, 0.01, 0.05}) {
+      std::vector<std::vector<double>> m;
+      createMatrix(n, m);
+      addSeededRandomEdges(m, 3 * n, negativeRatio, rng);
+
+      std::vector<std::vector<double>> expected = m;
+      textbookFloydWarshall(expected);
+
+      for (int blockSize : {1, 3, 16, FloydWarshallSolver::DEFAULT_BLOCK_SIZE}) {
+        FloydWarshallSolver solver(m, blockSize);
+        EXPECT_EQ(solver.getApspMatrix(), expected);
+
+        for (int s = 0; s < n; s++) {
+          for (int e = 0; e < n; e++) {
+            std::list<int> path;
+            bool isNegCycle;
+            std::tie(isNegCycle, path) = solver.reconstructShortestPath(s, e);
+            EXPECT_EQ(isNegCycle, expected[s][e] == NEGATIVE_INFINITY);
+            if (isNegCycle || path.empty()) continue;
+
+            // The reconstructed path must realize the shortest distance.
+            double cost = 0;
+            for (auto it = path.begin(); std::next(it) != path.end(); ++it) cost += m[*it][*std::next(it)];
+            if (s == e) cost = 0;
+            EXPECT_EQ(cost, expected[s][e]);
+          }
+        }
+      }
+    }
+  }
+}
+
+
+// Compares the running time of the blocked solver with the textbook loop.
+TEST_F(FloydWarshallSolverTest, testBlockedPerformance) {
+  int n = 600;
+  std::mt19937 rng(7);
+  std::vector<std::vector<double>> m;
+  createMatrix(n, m);
+  addSeededRandomEdges(m, 8 * n, 0.0, rng);
+
+  std::vector<std::vector<double>> expected = m;
+  auto t0 = std::chrono::steady_clock::now();
+  textbookFloydWarshall(expected);
+  auto t1 = std::chrono::steady_clock::now();
+  FloydWarshallSolver solver(m);
+  solver.solve();
+  auto t2 = std::chrono::steady_clock::now();
+  int threads = ThreadPool::hardwareThreads();
+  FloydWarshallSolver parallelSolver(m, FloydWarshallSolver::DEFAULT_BLOCK_SIZE, threads);
+  parallelSolver.solve();
+  auto t3 = std::chrono::steady_clock::now();
+
+  std::cout << "Floyd-Warshall n=" << n
+            << " textbook: " << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms"
+            << " blocked: " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms"
+            << " blocked with " << threads << " threads: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count() << "ms" << std::endl;
+  EXPECT_EQ(solver.getApspMatrix(), expected);
+  EXPECT_EQ(parallelSolver.getApspMatrix(), expected);
+}
+
+
+TEST_F(FloydWarshallSolverTest, testParallelMatchesSerial) {
+  std::mt19937 rng(99);
+  for (int n : {1, 70, 200}) {
+    for (double negativeRatio : {0.0, 0.02}) {
+      std::vector<std::vector<double>> m;
+      createMatrix(n, m);
+      addSeededRandomEdges(m, 4 * n, negativeRatio, rng);
+
+      for (int blockSize : {16, FloydWarshallSolver::DEFAULT_BLOCK_SIZE}) {
+        FloydWarshallSolver serial(m, blockSize);
+        for (int threads : {2, 3, 8}) {
+          FloydWarshallSolver parallel(m, blockSize, threads);
+          EXPECT_EQ(parallel.getApspMatrix(), serial.getApspMatrix());
+          for (int s = 0; s < n; s++)
+            for (int e = 0; e < n; e++)
+              EXPECT_EQ(parallel.reconstructShortestPath(s, e), serial.reconstructShortestPath(s, e));
+        }
+      }
+    }
+  }
+}
 #endif
 } // namespace dsa
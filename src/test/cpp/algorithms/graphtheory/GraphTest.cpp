@@ -0,0 +1,130 @@
+/*
+ * @file   GraphTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Adjacency list graph Unit Test: ownership and bulk loading.
+ */
+
+#include <gtest\gtest.h>
+#include <Graph.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <utility>
+
+namespace dsa {
+
+Graph makeGraph() {
+  Graph graph(3);
+  graph.addDirectedEdge(0, 1, 1.0);
+  graph.addDirectedEdge(1, 2, 2.0);
+  return graph;
+}
+
+
+TEST(GraphTest, testCopyAndMove) {
+  Graph graph = makeGraph();
+
+  // A copy owns its own vertices.
+  Graph copy(graph);
+  copy.addDirectedEdge(2, 0, 3.0);
+  EXPECT_EQ(graph.edgeCount(), 2u);
+  EXPECT_EQ(copy.edgeCount(), 3u);
+  EXPECT_TRUE(graph.edges(2).empty());
+
+  Graph assigned(1);
+  assigned = copy;
+  assigned = assigned;
+  EXPECT_EQ(assigned.size(), 3u);
+  EXPECT_EQ(assigned.edges(2).at(0), 3.0);
+
+  // A moved from graph is empty and usable again.
+  Graph moved(std::move(copy));
+  EXPECT_EQ(moved.edgeCount(), 3u);
+  EXPECT_EQ(copy.size(), 0u);
+  EXPECT_EQ(copy.edgeCount(), 0u);
+  EXPECT_TRUE(copy.edges(0).empty());
+  copy.addDirectedEdge(0, 1);
+  EXPECT_EQ(copy.size(), 1u);
+
+  graph = std::move(moved);
+  EXPECT_EQ(graph.edgeCount(), 3u);
+  EXPECT_EQ(moved.size(), 0u);
+
+  std::vector<Graph> graphs;
+  for (int i = 0; i < 10; i++) graphs.push_back(makeGraph());
+  for (auto& g : graphs) EXPECT_EQ(g.edges(1).at(2), 2.0);
+}
+
+
+TEST(GraphTest, testRepeatedEdges) {
+  Graph graph(2);
+  graph.addDirectedEdge(0, 1, 1.0);
+  graph.addDirectedEdge(0, 1, 5.0);
+  EXPECT_EQ(graph.edgeCount(), 1u);
+  EXPECT_EQ(graph.edges(0).at(1), 5.0);
+  graph.clear();
+  EXPECT_EQ(graph.size(), 0u);
+  EXPECT_EQ(graph.edgeCount(), 0u);
+}
+
+
+TEST(GraphTest, testBulkBuilder) {
+  std::mt19937 rng(14);
+  int n = 300;
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<Edge> edges;
+  for (int i = 0; i < 5000; i++) edges.push_back({node(rng), node(rng), (double)i});
+
+  Graph expected(n);
+  for (const Edge& e : edges) expected.addDirectedEdge(e.from_, e.to_, e.cost_);
+
+  Graph bulk(n, edges);
+  EXPECT_EQ(bulk.size(), expected.size());
+  EXPECT_EQ(bulk.edgeCount(), expected.edgeCount());
+  for (int u = 0; u < n; u++) EXPECT_EQ(bulk.edges(u), expected.edges(u));
+
+  // Adding to a graph with edges.
+  Graph grown(3);
+  grown.addDirectedEdge(0, 1, 1.0);
+  grown.reserveEdges(0, 4);
+  grown.addDirectedEdges({{0, 1, 2.0}, {2, 0, 1.0}, {0, 2, 1.0}});
+  EXPECT_EQ(grown.size(), 3u);
+  EXPECT_EQ(grown.edgeCount(), 3u);
+  EXPECT_EQ(grown.edges(0).at(1), 2.0);
+  EXPECT_EQ(grown.edges(2).at(0), 1.0);
+
+  // Node ids beyond size() are rejected and nothing is added.
+  EXPECT_THROW(Graph(2, {{0, 2, 1.0}}), std::invalid_argument);
+  EXPECT_THROW(grown.addDirectedEdges({{-1, 0, 1.0}}), std::invalid_argument);
+  EXPECT_THROW(grown.addDirectedEdges({{1, 2, 1.0}, {5, 0, 1.0}}), std::invalid_argument);
+  EXPECT_THROW(grown.addDirectedEdges({{0, 3, 1.0}}), std::invalid_argument);
+  EXPECT_EQ(grown.size(), 3u);
+  EXPECT_EQ(grown.edgeCount(), 3u);
+  EXPECT_TRUE(grown.edges(1).empty());
+}
+
+
+TEST(GraphTest, benchmark) {
+  std::mt19937 rng(15);
+  int n = 200000, m = 2000000;
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<Edge> edges;
+  for (int i = 0; i < m; i++) edges.push_back({node(rng), node(rng), 1.0});
+
+  auto t0 = std::chrono::steady_clock::now();
+  Graph incremental(n);
+  for (const Edge& e : edges) incremental.addDirectedEdge(e.from_, e.to_, e.cost_);
+  auto t1 = std::chrono::steady_clock::now();
+  Graph bulk(n, edges);
+  auto t2 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(bulk.edgeCount(), incremental.edgeCount());
+  std::cout << "Loading " << m << " edges: addDirectedEdge "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, bulk "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+}
+
+} // namespace dsa
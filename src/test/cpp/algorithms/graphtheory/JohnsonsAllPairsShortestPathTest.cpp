@@ -0,0 +1,155 @@
+/*
+ * @file   JohnsonsAllPairsShortestPathTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Johnson's all pairs shortest paths Unit Test.
+ */
+
+#include <gtest\gtest.h>
+#include <JohnsonsAllPairsShortestPath.h>
+#include <FloydWarshallSolver.h>
+#include <CsrGraph.h>
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <limits>
+
+namespace dsa {
+
+class JohnsonsAllPairsShortestPathTest : public ::testing::Test {
+protected:
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // A random graph with negative integer costs but without negative
+  // cycles: every cost is c + p[u] - p[v] with c >= 0 for random p.
+  std::vector<Edge> randomEdges(int n, int m, std::mt19937& rng) {
+    std::uniform_int_distribution<int> node(0, n - 1), cost(0, 20), potential(-10, 10);
+    std::vector<int> p(n);
+    for (int& value : p) value = potential(rng);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) {
+      int u = node(rng), v = node(rng);
+      edges.push_back({u, v, (double)(cost(rng) + p[u] - p[v])});
+    }
+    return edges;
+  }
+};
+
+
+TEST_F(JohnsonsAllPairsShortestPathTest, testSmallGraph) {
+  Graph graph(5);
+  graph.addDirectedEdge(0, 1, 4);
+  graph.addDirectedEdge(0, 2, 1);
+  graph.addDirectedEdge(2, 1, -2);
+  graph.addDirectedEdge(1, 3, 2);
+  graph.addDirectedEdge(3, 4, -1);
+  graph.addDirectedEdge(4, 2, 3);
+
+  JohnsonsAllPairsShortestPath solver(&graph, 2);
+  std::vector<std::vector<double>> expected{
+    {0,   -1,  1, 1,  0},
+    {inf,  0,  4, 2,  1},
+    {inf, -2,  0, 0, -1},
+    {inf,  0,  2, 0, -1},
+    {inf,  1,  3, 3,  0}};
+  EXPECT_EQ(solver.getApspMatrix(), expected);
+  EXPECT_EQ(solver.reconstructPath(0, 4), (std::list<int>{0, 2, 1, 3, 4}));
+  EXPECT_EQ(solver.reconstructPath(1, 0), std::list<int>());
+
+  graph.addDirectedEdge(1, 0, -4);
+  EXPECT_THROW(JohnsonsAllPairsShortestPath solver(&graph), std::invalid_argument);
+}
+
+
+TEST_F(JohnsonsAllPairsShortestPathTest, testAgainstFloydWarshall) {
+  std::mt19937 rng(12);
+  for (int trial = 0; trial < 20; trial++) {
+    int n = 5 + 7 * trial;
+    std::vector<Edge> edges = randomEdges(n, 3 * n, rng);
+    CsrGraph graph(n, edges);
+
+    std::vector<std::vector<double>> matrix(n, std::vector<double>(n, inf));
+    for (int i = 0; i < n; i++) matrix[i][i] = 0;
+    for (Edge& edge : edges) matrix[edge.from_][edge.to_] = std::min(matrix[edge.from_][edge.to_], edge.cost_);
+    FloydWarshallSolver reference(matrix);
+    reference.solve();
+
+    BasicJohnsonsAllPairsShortestPath<CsrGraph> solver(&graph, 1 + trial % 4);
+    std::mutex mutex;
+    std::vector<int> seen(n, 0);
+    solver.solve([&](int source, const std::vector<double>& dist, const std::vector<int>& prev) {
+      std::lock_guard<std::mutex> lock(mutex);
+      seen[source]++;
+      for (int v = 0; v < n; v++) {
+        EXPECT_EQ(dist[v], reference.getDistance(source, v));
+        // The predecessor lies on a shortest path in the original costs.
+        if (v == source || dist[v] == inf) {
+          EXPECT_EQ(prev[v], -1);
+          continue;
+        }
+        double best = inf;
+        for (auto edge: graph.edges(prev[v])) if (edge.first == v) best = std::min(best, edge.second);
+        EXPECT_EQ(dist[prev[v]] + best, dist[v]);
+      }
+    });
+    EXPECT_EQ(seen, std::vector<int>(n, 1));
+  }
+}
+
+
+TEST_F(JohnsonsAllPairsShortestPathTest, benchmark) {
+  std::mt19937 rng(13);
+
+  // Dense solver against Johnson on the same sparse graph.
+  int n = 1000;
+  std::vector<Edge> edges = randomEdges(n, 4 * n, rng);
+  CsrGraph graph(n, edges);
+  std::vector<std::vector<double>> matrix(n, std::vector<double>(n, inf));
+  for (int i = 0; i < n; i++) matrix[i][i] = 0;
+  for (Edge& edge : edges) matrix[edge.from_][edge.to_] = std::min(matrix[edge.from_][edge.to_], edge.cost_);
+
+  auto t0 = std::chrono::steady_clock::now();
+  FloydWarshallSolver reference(matrix);
+  reference.solve();
+  auto t1 = std::chrono::steady_clock::now();
+  BasicJohnsonsAllPairsShortestPath<CsrGraph> johnson(&graph);
+  std::atomic<int> mismatches(0);
+  johnson.solve([&](int source, const std::vector<double>& dist, const std::vector<int>&) {
+    for (int v = 0; v < n; v++)
+      if (dist[v] != reference.getDistance(source, v)) mismatches++;
+  });
+  auto t2 = std::chrono::steady_clock::now();
+  EXPECT_EQ(mismatches, 0);
+  std::cout << n << " nodes, " << edges.size() << " edges: Floyd-Warshall "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, Johnson "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+  // A sparse graph of 100k nodes, streaming a few hundred sources only.
+  n = 100000;
+  edges = randomEdges(n, 4 * n, rng);
+  CsrGraph large(n, edges);
+  t0 = std::chrono::steady_clock::now();
+  BasicJohnsonsAllPairsShortestPath<CsrGraph> solver(&large);
+  t1 = std::chrono::steady_clock::now();
+  std::vector<int> sources;
+  for (int i = 0; i < 200; i++) sources.push_back(i * (n / 200));
+  std::atomic<long long> reached(0);
+  solver.solve(sources, [&](int, const std::vector<double>& dist, const std::vector<int>&) {
+    long long count = 0;
+    for (double d : dist) count += d != inf;
+    reached += count;
+  });
+  t2 = std::chrono::steady_clock::now();
+  double perSource = std::chrono::duration<double, std::milli>(t2 - t1).count() / sources.size();
+  std::cout << n << " nodes: reweighting "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, "
+            << perSource << "ms per source with " << ThreadPool::hardwareThreads() << " threads, "
+            << reached / sources.size() << " nodes reached per source" << std::endl;
+}
+
+} // namespace dsa
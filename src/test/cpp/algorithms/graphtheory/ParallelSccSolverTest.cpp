@@ -0,0 +1,171 @@
+/*
+ * @file   ParallelSccSolverTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Unit test of the parallel strongly connected components solver.
+ */
+
+#include <gtest\gtest.h>
+#include <ParallelSccSolver.h>
+#include <TarjanSccSolverAdjacencyList.h>
+#include <TopologicalSortAdjacencyList.h>
+#include <CsrGraph.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace dsa {
+
+class ParallelSccSolverTest : public ::testing::Test {
+protected:
+  // Random sparse edges plus a few cycles of random length, so the graph has
+  // trimmable nodes, small SCCs and chains of SCCs.
+  std::vector<Edge> randomEdges(int n, int m, std::mt19937& rng) {
+    std::uniform_int_distribution<int> node(0, n - 1);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) edges.push_back({node(rng), node(rng), 1});
+    for (int c = 0; c < n / 20; c++) {
+      int length = std::uniform_int_distribution<int>(1, 6)(rng), first = node(rng), at = first;
+      for (int i = 0; i < length; i++) {
+        int next = node(rng);
+        edges.push_back({at, next, 1});
+        at = next;
+      }
+      edges.push_back({at, first, 1});
+    }
+    return edges;
+  }
+
+  // Checks a labelling against the serial solver and the id conventions.
+  void expectValid(const CsrGraph& graph, const std::vector<int>& ids, int count) {
+    BasicTarjanSccSolverAdjacencyList<CsrGraph> tarjan(&graph);
+    EXPECT_EQ(count, tarjan.sccCount());
+    const std::vector<int>& expected = tarjan.getComponentIds();
+    std::vector<int> map(count, -1);
+    for (unsigned u = 0; u < graph.size(); u++) {
+      ASSERT_TRUE(ids[u] >= 0 && ids[u] < count);
+      if (map[ids[u]] == -1) map[ids[u]] = expected[u];
+      EXPECT_EQ(map[ids[u]], expected[u]);
+      for (auto edge: graph.edges(u)) EXPECT_GE(ids[u], ids[edge.first]);
+    }
+  }
+};
+
+
+TEST_F(ParallelSccSolverTest, testSmallGraph) {
+  Graph graph(9);
+  graph.addDirectedEdge(0, 1);
+  graph.addDirectedEdge(1, 0);
+  graph.addDirectedEdge(0, 8);
+  graph.addDirectedEdge(8, 0);
+  graph.addDirectedEdge(8, 7);
+  graph.addDirectedEdge(7, 6);
+  graph.addDirectedEdge(6, 7);
+  graph.addDirectedEdge(1, 7);
+  graph.addDirectedEdge(2, 1);
+  graph.addDirectedEdge(2, 6);
+  graph.addDirectedEdge(5, 6);
+  graph.addDirectedEdge(2, 5);
+  graph.addDirectedEdge(5, 3);
+  graph.addDirectedEdge(3, 2);
+  graph.addDirectedEdge(4, 3);
+  graph.addDirectedEdge(4, 5);
+
+  for (int threshold : {0, 100}) {
+    ParallelSccSolver solver(&graph, 2);
+    solver.setSerialThreshold(threshold);
+    std::set<std::set<int>> expectedSccs{{0, 1, 8}, {7, 6}, {2, 3, 5}, {4}};
+    EXPECT_EQ(solver.sccCount(), 4);
+    EXPECT_EQ(solver.getSccs(), expectedSccs);
+  }
+
+  EXPECT_THROW(ParallelSccSolver(nullptr), std::invalid_argument);
+  EXPECT_THROW(ParallelSccSolver(&graph, 0), std::invalid_argument);
+}
+
+
+TEST_F(ParallelSccSolverTest, testAgainstTarjan) {
+  std::mt19937 rng(23);
+  for (int n = 1; n <= 400; n += 37) {
+    CsrGraph graph(n, randomEdges(n, n, rng));
+    std::vector<int> reference;
+    for (int threads : {1, 2, 4}) {
+      for (int threshold : {0, 16, 4096}) {
+        BasicParallelSccSolver<CsrGraph> solver(&graph, threads);
+        solver.setSerialThreshold(threshold);
+        expectValid(graph, solver.getComponentIds(), solver.sccCount());
+        // The same ids whichever way the components were found.
+        if (reference.empty()) reference = solver.getComponentIds();
+        EXPECT_EQ(solver.getComponentIds(), reference);
+      }
+    }
+  }
+}
+
+
+TEST_F(ParallelSccSolverTest, testCondensationIsTopologicallySortable) {
+  std::mt19937 rng(8);
+  int n = 2000;
+  CsrGraph graph(n, randomEdges(n, 2 * n, rng));
+  BasicParallelSccSolver<CsrGraph> solver(&graph, 4);
+  solver.setSerialThreshold(0);
+  const std::vector<int>& ids = solver.getComponentIds();
+
+  CsrGraph dag = solver.condensation();
+  ASSERT_EQ((int)dag.size(), solver.sccCount());
+  BasicTarjanSccSolverAdjacencyList<CsrGraph> dagScc(&dag);
+  EXPECT_EQ(dagScc.sccCount(), (int)dag.size());
+
+  BasicTopologicalSortAdjacencyList<CsrGraph> topsort(&dag);
+  std::vector<int> ordering = topsort.topologicalSort(), position(dag.size());
+  for (unsigned i = 0; i < ordering.size(); i++) position[ordering[i]] = i;
+  for (int u = 0; u < n; u++) {
+    for (auto edge: graph.edges(u)) {
+      if (ids[u] != ids[edge.first]) {
+        EXPECT_LT(position[ids[u]], position[ids[edge.first]]);
+      }
+    }
+  }
+
+  // Every edge between two components is in the condensation once.
+  std::set<std::pair<int, int>> expected;
+  for (int u = 0; u < n; u++)
+    for (auto edge: graph.edges(u))
+      if (ids[u] != ids[edge.first]) expected.insert({ids[u], ids[edge.first]});
+  EXPECT_EQ(dag.edgeCount(), expected.size());
+
+  // The relabelled condensation is the one built from the ids directly.
+  CsrGraph direct = CsrGraph::condensationOf(graph, ids, solver.sccCount());
+  EXPECT_EQ(dag.offsets(), direct.offsets());
+  EXPECT_EQ(dag.targets(), direct.targets());
+  EXPECT_EQ(dag.weights(), direct.weights());
+}
+
+
+TEST_F(ParallelSccSolverTest, testPerformanceAgainstTarjan) {
+  std::mt19937 rng(31);
+  int n = 1000000;
+  CsrGraph graph(n, randomEdges(n, 3 * n, rng));
+
+  auto t0 = std::chrono::steady_clock::now();
+  BasicTarjanSccSolverAdjacencyList<CsrGraph> tarjan(&graph);
+  int expected = tarjan.sccCount();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "Tarjan on " << n << " nodes and " << graph.edgeCount() << " edges: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  int maxThreads = std::max(4, ThreadPool::hardwareThreads());
+  for (int threads = 1; threads <= maxThreads; threads *= 2) {
+    auto t2 = std::chrono::steady_clock::now();
+    BasicParallelSccSolver<CsrGraph> solver(&graph, threads);
+    EXPECT_EQ(solver.sccCount(), expected);
+    auto t3 = std::chrono::steady_clock::now();
+    std::cout << "  parallel, " << threads << " threads: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count() << "ms" << std::endl;
+  }
+}
+
+} // namespace dsa
@@ -0,0 +1,73 @@
+/*
+ * @file   ShortestPathTestHelpers.h
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Test fixture shared by the point-to-point shortest path unit tests.
+ */
+
+#ifndef D_GRAPH_SHORTESTPATHTESTHELPERS_H
+#define D_GRAPH_SHORTESTPATHTESTHELPERS_H
+
+#include <gtest\gtest.h>
+#include <Graph.h>
+
+#include <random>
+#include <list>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace dsa {
+
+class ShortestPathTest : public ::testing::Test {
+protected:
+  const double inf = std::numeric_limits<double>::infinity();
+  const double EPS;
+
+  // @param eps - Tolerance of the distance comparisons.
+  ShortestPathTest(double eps = 1e-9) : EPS(eps) {
+  }
+
+  // Cost of a path of original edges, infinity if an edge is missing.
+  double pathCost(const Graph& graph, const std::list<int>& path) {
+    double cost = 0;
+    for (auto it = path.begin(); std::next(it) != path.end(); ++it) {
+      double best = inf;
+      for (auto edge: graph.edges(*it))
+        if (edge.first == *std::next(it)) best = std::min(best, edge.second);
+      cost += best;
+    }
+    return cost;
+  }
+
+  // Adds 'm' random directed edges between 'n' nodes, the costs are drawn
+  // from the distribution 'cost'.
+  template <typename COST>
+  void randomGraph(Graph& graph, int n, int m, COST cost, std::mt19937& rng) {
+    std::uniform_int_distribution<int> node(0, n - 1);
+    for (int i = 0; i < m; i++) graph.addDirectedEdge(node(rng), node(rng), cost(rng));
+  }
+
+  // Directed grid with random costs in both directions, similar to a road network.
+  void gridGraph(Graph& graph, int rows, int cols, std::mt19937& rng) {
+    std::uniform_real_distribution<double> cost(1, 10);
+    for (int r = 0; r < rows; r++) {
+      for (int c = 0; c < cols; c++) {
+        int u = r * cols + c;
+        if (c + 1 < cols) {
+          graph.addDirectedEdge(u, u + 1, cost(rng));
+          graph.addDirectedEdge(u + 1, u, cost(rng));
+        }
+        if (r + 1 < rows) {
+          graph.addDirectedEdge(u, u + cols, cost(rng));
+          graph.addDirectedEdge(u + cols, u, cost(rng));
+        }
+      }
+    }
+  }
+};
+
+} // namespace dsa
+
+#endif /* D_GRAPH_SHORTESTPATHTESTHELPERS_H */
@@ -9,6 +9,7 @@
 
 #include <gtest\gtest.h>
 #include <TarjanSccSolverAdjacencyList.h>
+#include <CsrGraph.h>
 
 #include <chrono>
 #include <random>
@@ -22,6 +23,65 @@
 
 namespace dsa {
 
+// The classic recursive Tarjan, the reference for the iterative solver.
+class RecursiveTarjan {
+  const CsrGraph &graph_;
+  std::vector<int> ids_, low_, stack_;
+  std::vector<bool> onStack_;
+  int id_ = 0;
+
+  void dfs(int at) {
+    stack_.push_back(at);
+    onStack_[at] = true;
+    ids_[at] = low_[at] = id_++;
+    for (auto edge: graph_.edges(at)) {
+      if (ids_[edge.first] == -1) dfs(edge.first);
+      if (onStack_[edge.first]) low_[at] = std::min(low_[at], low_[edge.first]);
+    }
+    if (ids_[at] == low_[at]) {
+      for (;;) {
+        int node = stack_.back();
+        stack_.pop_back();
+        onStack_[node] = false;
+        low_[node] = ids_[at];
+        if (node == at) break;
+      }
+    }
+  }
+
+public:
+  explicit RecursiveTarjan(const CsrGraph &graph) : graph_(graph) {}
+
+  // Low link values, equal for the nodes of one SCC.
+  std::vector<int> solve() {
+    int n = graph_.size();
+    ids_.assign(n, -1);
+    low_.assign(n, 0);
+    onStack_.assign(n, false);
+    for (int i = 0; i < n; i++) if (ids_[i] == -1) dfs(i);
+    return low_;
+  }
+};
+
+
+std::vector<Edge> randomSccEdges(int n, int m, std::mt19937 &rng) {
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<Edge> edges;
+  for (int i = 0; i < m; i++) edges.push_back({node(rng), node(rng), 0});
+  return edges;
+}
+
+
+// Checks that two labellings put the same nodes together.
+void expectSamePartition(const std::vector<int> &a, const std::vector<int> &b) {
+  ASSERT_EQ(a.size(), b.size());
+  std::unordered_map<int, int> aToB, bToA;
+  for (unsigned i = 0; i < a.size(); i++) {
+    EXPECT_EQ(aToB.emplace(a[i], b[i]).first->second, b[i]);
+    EXPECT_EQ(bToA.emplace(b[i], a[i]).first->second, a[i]);
+  }
+}
+
 TEST(TarjanSccSolverAdjacencyListTest, singletonCase) {
   int n = 1;
   Graph graph(n);
@@ -141,4 +201,60 @@ TEST(TarjanSccSolverAdjacencyListTest, testLastGraphInSlides) {
   solver = nullptr;
 }
 
+
+TEST(TarjanSccSolverAdjacencyListTest, testComponentIdsAgainstRecursive) {
+  std::mt19937 rng(9);
+  for (int n = 1; n <= 300; n += 13) {
+    CsrGraph graph(n, randomSccEdges(n, n + n / 2, rng));
+    BasicTarjanSccSolverAdjacencyList<CsrGraph> solver(&graph);
+    const std::vector<int> &ids = solver.getComponentIds();
+    expectSamePartition(ids, RecursiveTarjan(graph).solve());
+
+    // Ids are dense and every edge between components goes to a lower id.
+    EXPECT_EQ(*std::max_element(ids.begin(), ids.end()) + 1, solver.sccCount());
+    for (int u = 0; u < n; u++)
+      for (auto edge: graph.edges(u)) EXPECT_GE(ids[u], ids[edge.first]);
+  }
+}
+
+
+TEST(TarjanSccSolverAdjacencyListTest, testDeepGraphs) {
+  // A path and a cycle of a few million nodes, far deeper than the call stack allows.
+  int n = 3000000;
+  std::vector<Edge> edges;
+  for (int i = 0; i + 1 < n; i++) edges.push_back({i, i + 1, 0});
+  CsrGraph path(n, edges);
+  BasicTarjanSccSolverAdjacencyList<CsrGraph> pathSolver(&path);
+  EXPECT_EQ(pathSolver.sccCount(), n);
+  EXPECT_EQ(pathSolver.getComponentIds()[0], n - 1);
+  EXPECT_EQ(pathSolver.getComponentIds()[n - 1], 0);
+
+  edges.push_back({n - 1, 0, 0});
+  CsrGraph cycle(n, edges);
+  BasicTarjanSccSolverAdjacencyList<CsrGraph> cycleSolver(&cycle);
+  EXPECT_EQ(cycleSolver.sccCount(), 1);
+}
+
+
+TEST(TarjanSccSolverAdjacencyListTest, testPerformanceAgainstRecursive) {
+  std::mt19937 rng(5);
+  // The recursive reference goes about n / 2 calls deep, keep it well
+  // within a 1 MB stack.
+  int n = 20000;
+  CsrGraph graph(n, randomSccEdges(n, 2 * n, rng));
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<int> low = RecursiveTarjan(graph).solve();
+  auto t1 = std::chrono::steady_clock::now();
+  BasicTarjanSccSolverAdjacencyList<CsrGraph> solver(&graph);
+  std::vector<int> ids = solver.getComponentIds();
+  auto t2 = std::chrono::steady_clock::now();
+
+  expectSamePartition(ids, low);
+  std::cout << "SCCs of a random graph with " << n << " nodes: recursive "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, iterative "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, "
+            << solver.sccCount() << " components" << std::endl;
+}
+
 } // namespace dsa
@@ -0,0 +1,162 @@
+/*
+ * @file   TopologicalSortAdjacencyListTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Unit test of the Kahn style topological sort with levels and critical paths.
+ */
+
+#include <gtest\gtest.h>
+#include <TopologicalSortAdjacencyList.h>
+#include <CsrGraph.h>
+
+#include <chrono>
+#include <random>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace dsa {
+
+class TopologicalSortAdjacencyListTest : public ::testing::Test {
+protected:
+  // Random DAG: edges go from lower to higher ids of a random permutation.
+  std::vector<Edge> randomDag(int n, int m, std::mt19937& rng) {
+    std::vector<int> rank(n);
+    for (int i = 0; i < n; i++) rank[i] = i;
+    std::shuffle(rank.begin(), rank.end(), rng);
+    std::uniform_int_distribution<int> node(0, n - 1);
+    std::uniform_int_distribution<int> cost(1, 9);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m && n > 1; i++) {
+      int a = node(rng), b = node(rng);
+      if (a == b) continue;
+      if (a > b) std::swap(a, b);
+      edges.push_back({rank[a], rank[b], (double)cost(rng)});
+    }
+    return edges;
+  }
+
+  // Level = length of the longest chain of edges ending at the node.
+  std::vector<int> referenceLevels(const CsrGraph& graph) {
+    BasicTopologicalSortAdjacencyList<CsrGraph> solver(&graph);
+    std::vector<int> level(graph.size(), 0);
+    for (int u : solver.topologicalSort())
+      for (auto edge: graph.edges(u)) level[edge.first] = std::max(level[edge.first], level[u] + 1);
+    return level;
+  }
+
+  std::vector<double> referenceLongest(const CsrGraph& graph) {
+    BasicTopologicalSortAdjacencyList<CsrGraph> solver(&graph);
+    std::vector<double> dist(graph.size(), 0);
+    for (int u : solver.topologicalSort())
+      for (auto edge: graph.edges(u)) dist[edge.first] = std::max(dist[edge.first], dist[u] + edge.second);
+    return dist;
+  }
+};
+
+
+TEST_F(TopologicalSortAdjacencyListTest, testSevenNodeGraph) {
+  Graph graph(7);
+  graph.addDirectedEdge(0, 1, 3.);
+  graph.addDirectedEdge(0, 2, 2.);
+  graph.addDirectedEdge(0, 5, 3.);
+  graph.addDirectedEdge(1, 3, 1.);
+  graph.addDirectedEdge(1, 2, 6.);
+  graph.addDirectedEdge(2, 3, 1.);
+  graph.addDirectedEdge(2, 4, 10.);
+  graph.addDirectedEdge(3, 4, 5.);
+  graph.addDirectedEdge(5, 4, 7.);
+  TopologicalSortAdjacencyList solver(&graph);
+
+  std::vector<int> levels;
+  std::vector<int> expectedOrder{0, 6, 1, 5, 2, 3, 4}, expectedLevels{0, 1, 2, 3, 4, 1, 0};
+  EXPECT_EQ(solver.topologicalSortKahn(&levels, 2), expectedOrder);
+  EXPECT_EQ(levels, expectedLevels);
+
+  std::vector<int> prev;
+  std::vector<double> dist = solver.dagLongestPath(&prev);
+  std::vector<double> expectedDist{0, 3, 9, 10, 19, 3, 0};
+  EXPECT_EQ(dist, expectedDist);
+  EXPECT_EQ(prev[4], 2);
+  std::list<int> expectedPath{0, 1, 2, 4};
+  EXPECT_EQ(solver.criticalPath(), expectedPath);
+
+  graph.addDirectedEdge(4, 1, 1.);
+  EXPECT_THROW(solver.topologicalSortKahn(), std::invalid_argument);
+  EXPECT_THROW(solver.topologicalSortKahn(nullptr, 0), std::invalid_argument);
+}
+
+
+TEST_F(TopologicalSortAdjacencyListTest, testKahnAgainstDfs) {
+  std::mt19937 rng(6);
+  for (int n = 1; n <= 500; n += 41) {
+    CsrGraph graph(n, randomDag(n, 3 * n, rng));
+    BasicTopologicalSortAdjacencyList<CsrGraph> solver(&graph);
+    std::vector<int> expectedLevels = referenceLevels(graph);
+    std::vector<double> expectedDist = referenceLongest(graph);
+
+    // The predecessor on a longest path is the lowest numbered tail of a tight edge.
+    std::vector<int> expectedPrev(n, -1);
+    for (int u = n - 1; u >= 0; u--)
+      for (auto edge: graph.edges(u))
+        if (expectedDist[u] + edge.second == expectedDist[edge.first]) expectedPrev[edge.first] = u;
+
+    std::vector<int> reference;
+    for (int threads : {1, 2, 4}) {
+      std::vector<int> levels, prev;
+      std::vector<int> ordering = solver.topologicalSortKahn(&levels, threads);
+      EXPECT_EQ(levels, expectedLevels);
+      if (reference.empty()) reference = ordering;
+      EXPECT_EQ(ordering, reference);
+
+      std::vector<int> position(n);
+      for (int i = 0; i < n; i++) position[ordering[i]] = i;
+      for (int u = 0; u < n; u++)
+        for (auto edge: graph.edges(u)) EXPECT_LT(position[u], position[edge.first]);
+
+      EXPECT_EQ(solver.dagLongestPath(&prev, threads), expectedDist);
+      EXPECT_EQ(prev, expectedPrev);
+      std::list<int> path = solver.criticalPath(threads);
+      double length = 0;
+      for (auto it = path.begin(); std::next(it) != path.end(); ++it) {
+        double best = -1;
+        for (auto edge: graph.edges(*it)) if (edge.first == *std::next(it)) best = std::max(best, edge.second);
+        ASSERT_GE(best, 0);
+        length += best;
+      }
+      EXPECT_EQ(length, *std::max_element(expectedDist.begin(), expectedDist.end()));
+    }
+  }
+}
+
+
+TEST_F(TopologicalSortAdjacencyListTest, testKahnPerformance) {
+  std::mt19937 rng(14);
+  int n = 1000000;
+  CsrGraph graph(n, randomDag(n, 4 * n, rng));
+  BasicTopologicalSortAdjacencyList<CsrGraph> solver(&graph);
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<int> ordering = solver.topologicalSort();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "Topological sort of " << n << " nodes and " << graph.edgeCount() << " edges: dfs "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  int maxThreads = std::max(4, ThreadPool::hardwareThreads());
+  for (int threads = 1; threads <= maxThreads; threads *= 2) {
+    std::vector<int> levels;
+    solver.topologicalSortKahn(&levels, threads); // Starts the pool.
+    auto t2 = std::chrono::steady_clock::now();
+    ordering = solver.topologicalSortKahn(&levels, threads);
+    auto t3 = std::chrono::steady_clock::now();
+    solver.dagLongestPath(nullptr, threads);
+    auto t4 = std::chrono::steady_clock::now();
+    std::cout << "  Kahn, " << threads << " threads: " << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count()
+              << "ms (" << *std::max_element(levels.begin(), levels.end()) + 1 << " levels), critical path "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t4 - t3).count() << "ms" << std::endl;
+  }
+}
+
+} // namespace dsa
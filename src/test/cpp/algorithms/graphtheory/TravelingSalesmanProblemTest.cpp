@@ -10,6 +10,7 @@
 #include <gtest\gtest.h>
 #include <TspBruteForce.h>
 #include <TspDynamicProgrammingIterative.h>
+#include <TspBranchAndBound.h>
 
 #include <chrono>
 #include <random>
@@ -222,6 +223,202 @@ TEST(TravelingSalesmanProblemTest, testTspIterativePerformance) {
   }
 }
 
+TEST(TravelingSalesmanProblemTest, testFloatMemoTable) {
+  for (int n = 3; n <= 9; n++) {
+    std::vector<std::vector<double>> dist(n, std::vector<double> (n, 100));
+    randomFillDistMatrix(dist);
+
+    BasicTspDynamicProgrammingIterative<float> floatSolver(dist);
+    double bf = TspBruteForce::computeTourCost(TspBruteForce::tsp(dist), dist);
+
+    // Single precision is accurate to about 7 significant digits.
+    EXPECT_NEAR(floatSolver.getTourCost(), bf, 1e-2);
+    EXPECT_EQ(floatSolver.getTour().size(), (unsigned)n + 1);
+  }
+}
+
+
+TEST(TravelingSalesmanProblemTest, testParallelDpVsBf) {
+  for (int n = 3; n <= 9; n++) {
+    std::vector<std::vector<double>> dist(n, std::vector<double> (n, 100));
+    randomFillDistMatrix(dist);
+    double bf = TspBruteForce::computeTourCost(TspBruteForce::tsp(dist), dist);
+
+    TspDynamicProgrammingIterative solver(0, dist, 4);
+    EXPECT_NEAR(solver.getTourCost(), bf, EPS);
+    EXPECT_NEAR(getTourCost(dist, solver.getTour()), bf, EPS);
+  }
+}
+
+
+// Layers of 15+ nodes are large enough to be split across the threads.
+TEST(TravelingSalesmanProblemTest, testParallelMatchesSerial) {
+  for (int n = 15; n <= 17; n++) {
+    std::vector<std::vector<double>> dist(n, std::vector<double> (n, 100));
+    randomFillDistMatrix(dist);
+
+    TspDynamicProgrammingIterative serial(dist);
+    for (int threads : {2, 3, 7}) {
+      TspDynamicProgrammingIterative parallel(0, dist, threads);
+      EXPECT_EQ(parallel.getTourCost(), serial.getTourCost());
+      EXPECT_EQ(parallel.getTour(), serial.getTour());
+    }
+  }
+}
+
+
+TEST(TravelingSalesmanProblemTest, testBranchAndBoundVsDp) {
+  for (int n = 3; n <= 12; n++) {
+    for (int i = 0; i < 5; i++) {
+      std::vector<std::vector<double>> dist(n, std::vector<double> (n, 100));
+      randomFillDistMatrix(dist);
+
+      TspDynamicProgrammingIterative dpSolver(dist);
+      TspBranchAndBound bbSolver(dist);
+
+      EXPECT_NEAR(bbSolver.getTourCost(), dpSolver.getTourCost(), EPS);
+      EXPECT_NEAR(getTourCost(dist, bbSolver.getTour()), dpSolver.getTourCost(), EPS);
+      EXPECT_TRUE(bbSolver.isOptimal());
+    }
+  }
+}
+
+
+TEST(TravelingSalesmanProblemTest, testBranchAndBoundSymmetricVsDp) {
+  // Symmetric matrices enable the 1-tree bound, negative weights included.
+  std::mt19937 rng(77);
+  std::uniform_int_distribution<int> weight(-20, 100);
+  for (int n = 3; n <= 13; n++) {
+    for (int i = 0; i < 5; i++) {
+      std::vector<std::vector<double>> dist(n, std::vector<double> (n, 0));
+      for (int u = 0; u < n; u++)
+        for (int v = 0; v < u; v++)
+          dist[u][v] = dist[v][u] = weight(rng);
+
+      TspDynamicProgrammingIterative dpSolver(dist);
+      TspBranchAndBound bbSolver(dist);
+
+      EXPECT_NEAR(bbSolver.getTourCost(), dpSolver.getTourCost(), EPS);
+      EXPECT_NEAR(getTourCost(dist, bbSolver.getTour()), dpSolver.getTourCost(), EPS);
+      EXPECT_TRUE(bbSolver.isOptimal());
+    }
+  }
+}
+
+
+TEST(TravelingSalesmanProblemTest, testBranchAndBoundDifferentStartingNodes) {
+  int n = 8;
+  std::vector<std::vector<double>> dist(n, std::vector<double> (n, 100));
+  randomFillDistMatrix(dist);
+  double bf = TspBruteForce::computeTourCost(TspBruteForce::tsp(dist), dist);
+
+  for (int startNode = 0; startNode < n; startNode++) {
+    TspBranchAndBound solver(startNode, dist);
+    EXPECT_NEAR(solver.getTourCost(), bf, EPS);
+    EXPECT_EQ(solver.getTour().front(), startNode);
+    EXPECT_EQ(solver.getTour().back(), startNode);
+  }
+}
+
+
+TEST(TravelingSalesmanProblemTest, testBranchAndBoundBudget) {
+  int n = 14;
+  std::vector<std::vector<double>> dist(n, std::vector<double> (n, 100));
+  randomFillDistMatrix(dist);
+  TspDynamicProgrammingIterative dpSolver(dist);
+
+  // With a budget of one search node only the warm start tour is known.
+  TspBranchAndBound solver(dist);
+  solver.setNodeLimit(1);
+  std::list<int> tour = solver.getTour();
+  EXPECT_FALSE(solver.isOptimal());
+  EXPECT_EQ(tour.size(), (unsigned)n + 1);
+  std::set<int> nodes(tour.begin(), tour.end());
+  EXPECT_EQ(nodes.size(), (unsigned)n);
+  EXPECT_NEAR(getTourCost(dist, tour), solver.getTourCost(), EPS);
+  EXPECT_GE(solver.getTourCost(), dpSolver.getTourCost() - EPS);
+
+  // A warm start with the optimal tour is kept when the search finds nothing better.
+  const std::list<int>& optimal = dpSolver.getTour();
+  TspBranchAndBound warmSolver(dist);
+  warmSolver.setInitialTour(std::vector<int>(optimal.begin(), optimal.end()));
+  warmSolver.setNodeLimit(1);
+  EXPECT_NEAR(warmSolver.getTourCost(), dpSolver.getTourCost(), EPS);
+
+  // A tour has every node once, optionally closed by its first node.
+  TspBranchAndBound tourCheck(dist);
+  std::vector<int> open(n);
+  for (int i = 0; i < n; i++) open[i] = i;
+  tourCheck.setInitialTour(open);
+  open.push_back(0);
+  tourCheck.setInitialTour(open);
+  open.back() = 1;
+  EXPECT_THROW(tourCheck.setInitialTour(open), std::invalid_argument);
+  open.back() = n;
+  EXPECT_THROW(tourCheck.setInitialTour(open), std::invalid_argument);
+  open.pop_back();
+  open.pop_back();
+  EXPECT_THROW(tourCheck.setInitialTour(open), std::invalid_argument);
+}
+
+
+TEST(TravelingSalesmanProblemTest, testBranchAndBoundMissingEdges) {
+  const double inf = std::numeric_limits<double>::infinity();
+  // Symmetric with missing edges: the only tours avoiding them are
+  // 0-1-2-3-4-0 and its reverse.
+  int n = 5;
+  std::vector<std::vector<double>> dist(n, std::vector<double> (n, inf));
+  for (int i = 0; i < n; i++) {
+    dist[i][i] = 0;
+    dist[i][(i + 1) % n] = dist[(i + 1) % n][i] = 1 + i;
+  }
+  TspBranchAndBound solver(dist);
+  EXPECT_NEAR(solver.getTourCost(), 15, EPS);
+  EXPECT_TRUE(solver.isOptimal());
+
+  // A star around node 1 has a finite 1-tree but no finite tour, as node 4
+  // only has one edge.
+  std::vector<std::vector<double>> star(n, std::vector<double> (n, inf));
+  int edges[][2] = {{1, 2}, {1, 3}, {1, 4}, {0, 2}, {0, 3}};
+  for (int i = 0; i < n; i++) star[i][i] = 0;
+  for (auto& e : edges) star[e[0]][e[1]] = star[e[1]][e[0]] = 1;
+  TspBranchAndBound none(star);
+  EXPECT_EQ(none.getTourCost(), inf);
+}
+
+
+// Cities on the plane, an instance too large for the DP solver's memory budget.
+TEST(TravelingSalesmanProblemTest, testBranchAndBoundPerformance) {
+  int n = 30;
+  std::mt19937 rng(30);
+  std::uniform_real_distribution<double> coord(0.0, 1000.0);
+  std::vector<double> x(n), y(n);
+  for (int i = 0; i < n; i++) {
+    x[i] = coord(rng);
+    y[i] = coord(rng);
+  }
+  std::vector<std::vector<double>> dist(n, std::vector<double> (n, 0));
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      dist[i][j] = std::hypot(x[i] - x[j], y[i] - y[j]);
+
+  TspBranchAndBound solver(dist);
+  solver.setTimeLimit(5.0);
+  double cost = solver.getTourCost();
+  std::cout << "Branch and bound n=" << n << " cost: " << cost << " nodes: " << solver.exploredNodes()
+            << (solver.isOptimal() ? " (optimal)" : " (budget exceeded)") << std::endl;
+  EXPECT_NEAR(getTourCost(dist, solver.getTour()), cost, EPS);
+}
+
+
+TEST(TravelingSalesmanProblemTest, testMemoryEstimate) {
+  // 2^(n-1) subsets times (n-1) end nodes.
+  EXPECT_EQ(TspDynamicProgrammingIterative::memoryEstimate(3), 4u * 2u * sizeof(double));
+  EXPECT_EQ(TspDynamicProgrammingIterative::memoryEstimate(25), (std::size_t(1) << 24) * 24u * sizeof(double));
+  EXPECT_EQ(BasicTspDynamicProgrammingIterative<float>::memoryEstimate(25), (std::size_t(1) << 24) * 24u * sizeof(float));
+}
+
+
 /*
 ToDo: The following test cases need to be implemented!
 
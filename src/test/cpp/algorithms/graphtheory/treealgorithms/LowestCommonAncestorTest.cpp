@@ -0,0 +1,155 @@
+/*
+ * @file   LowestCommonAncestorTest.cpp
+ * @author Armin Zare Zadeh, ali.a.zarezadeh@gmail.com
+ * @date   17 October 2026
+ * @version 0.1
+ * @brief   Lowest common ancestor Unit Test.
+ */
+
+#include <gtest\gtest.h>
+#include <LowestCommonAncestor.h>
+#include <CsrGraph.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace dsa {
+
+using Method = LowestCommonAncestor::Method;
+
+// A random tree on n nodes where the parent of v is one of the 'window'
+// nodes before it. A small window gives a deep tree.
+CsrGraph randomTree(int n, int window, std::mt19937& rng) {
+  std::vector<Edge> edges;
+  for (int v = 1; v < n; v++) {
+    int u = std::uniform_int_distribution<int>(std::max(0, v - window), v - 1)(rng);
+    edges.push_back({u, v, 1});
+    edges.push_back({v, u, 1});
+  }
+  return CsrGraph(n, edges);
+}
+
+std::vector<std::pair<int, int>> randomQueries(int n, int count, std::mt19937& rng) {
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<std::pair<int, int>> queries;
+  for (int i = 0; i < count; i++) queries.push_back({node(rng), node(rng)});
+  return queries;
+}
+
+int naiveLca(const RootingTree& tree, int u, int v) {
+  while (tree.depth(u) > tree.depth(v)) u = tree.parent(u);
+  while (tree.depth(v) > tree.depth(u)) v = tree.parent(v);
+  while (u != v) {
+    u = tree.parent(u);
+    v = tree.parent(v);
+  }
+  return u;
+}
+
+
+TEST(LowestCommonAncestorTest, testSmallTree) {
+  Graph graph(10);
+  graph.addUndirectedEdge(0, 1);
+  graph.addUndirectedEdge(2, 1);
+  graph.addUndirectedEdge(2, 3);
+  graph.addUndirectedEdge(3, 4);
+  graph.addUndirectedEdge(5, 3);
+  graph.addUndirectedEdge(2, 6);
+  graph.addUndirectedEdge(6, 7);
+  graph.addUndirectedEdge(6, 8);
+  // Node 9 is not connected.
+  RootingTree tree(&graph, 6);
+
+  std::vector<std::pair<int, int>> queries{{0, 4}, {4, 5}, {7, 0}, {3, 2}, {8, 8}, {6, 5}, {1, 0}};
+  std::vector<int> expected{2, 3, 6, 2, 8, 6, 1};
+  for (Method method : {Method::BinaryLifting, Method::SparseTable, Method::Offline}) {
+    LowestCommonAncestor solver(&tree, method);
+    EXPECT_EQ(solver.lca(queries), expected);
+    EXPECT_THROW(solver.lca(9, 0), std::invalid_argument);
+    EXPECT_THROW(solver.lca({{0, 9}}), std::invalid_argument);
+    if (method == Method::Offline) {
+      EXPECT_THROW(solver.lca(0, 4), std::invalid_argument);
+      EXPECT_EQ(solver.memoryUsage(), 0u);
+    } else {
+      for (size_t q = 0; q < queries.size(); q++)
+        EXPECT_EQ(solver.lca(queries[q].first, queries[q].second), expected[q]);
+    }
+  }
+
+  Graph single(1);
+  RootingTree root(&single, 0);
+  for (Method method : {Method::BinaryLifting, Method::SparseTable, Method::Offline})
+    EXPECT_EQ(LowestCommonAncestor(&root, method).lca({{0, 0}}), std::vector<int>{0});
+}
+
+
+TEST(LowestCommonAncestorTest, testRandomTrees) {
+  std::mt19937 rng(3);
+  for (int window : {1, 3, 1000}) {
+    for (int n : {2, 17, 1000}) {
+      CsrGraph graph = randomTree(n, window, rng);
+      RootingTree tree(&graph, std::uniform_int_distribution<int>(0, n - 1)(rng));
+      auto queries = randomQueries(n, 2000, rng);
+      std::vector<int> expected;
+      for (auto& query : queries) expected.push_back(naiveLca(tree, query.first, query.second));
+
+      for (Method method : {Method::BinaryLifting, Method::SparseTable, Method::Offline})
+        EXPECT_EQ(LowestCommonAncestor(&tree, method).lca(queries), expected);
+    }
+  }
+}
+
+
+TEST(LowestCommonAncestorTest, testDeepTree) {
+  int n = 2000000;
+  std::vector<Edge> edges;
+  for (int v = 1; v < n; v++) {
+    edges.push_back({v - 1, v, 1});
+    edges.push_back({v, v - 1, 1});
+  }
+  CsrGraph graph(n, edges);
+  RootingTree tree(&graph, 0);
+
+  std::vector<std::pair<int, int>> queries{{n - 1, 5}, {7, n - 2}, {n - 1, n - 1}, {n / 2, n / 3}};
+  std::vector<int> expected{5, 7, n - 1, n / 3};
+  for (Method method : {Method::BinaryLifting, Method::SparseTable, Method::Offline})
+    EXPECT_EQ(LowestCommonAncestor(&tree, method).lca(queries), expected);
+}
+
+
+TEST(LowestCommonAncestorTest, benchmark) {
+  std::mt19937 rng(4);
+  int n = 1000000, q = 2000000;
+  for (int window : {n, 16}) {
+    CsrGraph graph = randomTree(n, window, rng);
+    RootingTree tree(&graph, 0);
+    auto queries = randomQueries(n, q, rng);
+    int height = *std::max_element(tree.depths().begin(), tree.depths().end());
+    std::cout << n << " nodes, height " << height << ", " << q << " queries" << std::endl;
+
+    std::vector<int> reference;
+    for (Method method : {Method::BinaryLifting, Method::SparseTable, Method::Offline}) {
+      auto t0 = std::chrono::steady_clock::now();
+      LowestCommonAncestor solver(&tree, method);
+      auto t1 = std::chrono::steady_clock::now();
+      std::vector<int> answers = solver.lca(queries);
+      auto t2 = std::chrono::steady_clock::now();
+
+      double build = std::chrono::duration<double, std::milli>(t1 - t0).count();
+      double query = std::chrono::duration<double>(t2 - t1).count();
+      const char *name = method == Method::BinaryLifting ? "binary lifting" :
+                         method == Method::SparseTable ? "sparse table  " : "offline tarjan";
+      std::cout << "  " << name << ": build " << build << "ms, memory "
+                << solver.memoryUsage() / (1 << 20) << "MB, "
+                << (long long)(q / query) << " queries/s" << std::endl;
+
+      if (reference.empty()) reference = answers;
+      else EXPECT_EQ(answers, reference);
+    }
+  }
+}
+
+} // namespace dsa
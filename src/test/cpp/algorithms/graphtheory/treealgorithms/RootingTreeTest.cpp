@@ -9,6 +9,7 @@
 
 #include <gtest\gtest.h>
 #include <RootingTree.h>
+#include <CsrGraph.h>
 
 #include <chrono>
 #include <random>
@@ -43,47 +44,24 @@ TEST(RootingTreeTest, testSimpleRooting1) {
   std::unique_ptr<RootingTree> node6 = std::make_unique<RootingTree>(&graph, 6);
 
   // Layer 0: [6]
-  EXPECT_EQ((*node6)().id(), 6);
-  EXPECT_EQ((*node6)().parent(), nullptr);
-
-
-  std::unordered_set<RootingTree::TreeNode*> children_root = node6->children();
-  std::set<int> expectedIds_node6{2,7,8};
-  std::set<int> expectedIds_node2{1,3};
-  std::set<int> expectedIds_node3{4,5};
-  std::set<int> expectedIds_node1{0};
-  std::set<int> asIsIds_node6;
-  std::set<int> asIsIds_node2;
-  std::set<int> asIsIds_node3;
-  std::set<int> asIsIds_node1;
-  for (auto c : children_root) { // Layer 1 node 6(root): [2, 7, 8]
-    asIsIds_node6.insert((*c).id());
-    if ((*c).id() == 2) { // Layer 2 node 2: [1, 3]
-      std::unordered_set<RootingTree::TreeNode*> children_node2 = (*c).children();
-      for (auto c2 : children_node2) {
-        asIsIds_node2.insert((*c2).id());
-        if ((*c2).id() == 3) { // Layer 3 node 3: [4, 5]
-          std::unordered_set<RootingTree::TreeNode*> children_node3 = (*c2).children();
-          for (auto c3 : children_node3) {
-            asIsIds_node3.insert((*c3).id());
-          }
-        }
-        if ((*c2).id() == 1) { // Layer 3 node 1: [0]
-          std::unordered_set<RootingTree::TreeNode*> children_node1 = (*c2).children();
-          for (auto c1 : children_node1) {
-            asIsIds_node1.insert((*c1).id());
-          }
-        }
-      }
-    }
-  }
-
-  EXPECT_EQ(asIsIds_node6, expectedIds_node6);
-  EXPECT_EQ(asIsIds_node2, expectedIds_node2);
-  EXPECT_EQ(asIsIds_node3, expectedIds_node3);
-  EXPECT_EQ(asIsIds_node1, expectedIds_node1);
-
-  // TODO(williamfiset): also verify the parent pointers are pointing at the correct nodes.
+  EXPECT_EQ(node6->root(), 6);
+  EXPECT_EQ(node6->parent(6), -1);
+
+  auto childIds = [&](int node) {
+    std::set<int> ids;
+    for (int child : node6->children(node)) ids.insert(child);
+    return ids;
+  };
+  EXPECT_EQ(childIds(6), (std::set<int>{2, 7, 8}));
+  EXPECT_EQ(childIds(2), (std::set<int>{1, 3}));
+  EXPECT_EQ(childIds(3), (std::set<int>{4, 5}));
+  EXPECT_EQ(childIds(1), (std::set<int>{0}));
+  EXPECT_TRUE(node6->children(0).empty());
+
+  std::vector<int> expectedParents{1, 2, 6, 2, 3, 3, -1, 6, 6};
+  EXPECT_EQ(node6->parents(), expectedParents);
+  std::vector<int> expectedDepths{3, 2, 1, 2, 3, 3, 0, 1, 1};
+  EXPECT_EQ(node6->depths(), expectedDepths);
 }
 
 
@@ -105,47 +83,105 @@ TEST(RootingTreeTest, testSimpleRootingPrint) {
   //    1   3
   //  0    4 5
 
-  RootingTree *root = new RootingTree(&graph, 6);
+  RootingTree root(&graph, 6);
 
   // Layer 0: [6]
   std::cout << "Layer 0: [6]: ";
-  std::cout << (*root) << std::endl;
-
-
-#define PRINT_CHILDREN(r) \
-  do { \
-	std::cout << "["; \
-	for (auto c : r) std::cout << (*c) << ","; \
-	std::cout << "]"; \
-  } while(0)
+  std::cout << root << std::endl;
 
+  auto printChildren = [&](int node) {
+    std::cout << "[";
+    for (int child : root.children(node)) std::cout << child << ",";
+    std::cout << "]";
+  };
 
   // Layer 1: [2, 7, 8]
-  std::unordered_set<RootingTree::TreeNode*> children_root = root->children();
   std::cout << "Layer 1: [2, 7, 8]: ";
-  PRINT_CHILDREN(children_root);
+  printChildren(root.root());
   std::cout << std::endl;
 
-
   // Layer 2: [1, 3]
-  int expectedId = 2;
-  auto idComparer = [&expectedId](auto c2) -> bool { return ((*c2).id() == expectedId); };
-  auto itr = std::find_if(children_root.begin(), children_root.end(), idComparer);
-  std::unordered_set<RootingTree::TreeNode*> children_layer2 = (*itr)->children();
   std::cout << "Layer 2: [1, 3]: ";
-  PRINT_CHILDREN(children_layer2);
+  printChildren(2);
   std::cout << std::endl;
 
-
   // Layer 3: [0], [4, 5]
-  expectedId = 3;
-  itr = std::find_if(children_layer2.begin(), children_layer2.end(), idComparer);
-  std::unordered_set<RootingTree::TreeNode*> children_layer3 = (*itr)->children();
   std::cout << "Layer 3: [4, 5]: ";
-  PRINT_CHILDREN(children_layer3);
+  printChildren(3);
   std::cout << std::endl;
+}
+
 
-  delete root;
+TEST(RootingTreeTest, testSubtreeRanges) {
+  std::mt19937 rng(2);
+  int n = 500;
+  std::vector<Edge> edges;
+  for (int v = 1; v < n; v++) {
+    int u = std::uniform_int_distribution<int>(0, v - 1)(rng);
+    edges.push_back({u, v, 1});
+    edges.push_back({v, u, 1});
+  }
+  CsrGraph graph(n + 1, edges); // Node n is not connected.
+
+  for (int rootId : {0, 137, n - 1}) {
+    RootingTree tree(&graph, rootId);
+    EXPECT_FALSE(tree.contains(n));
+    EXPECT_EQ((int)tree.preorder().size(), n);
+    EXPECT_EQ(tree.subtreeSize(rootId), n);
+
+    for (int u = 0; u < n; u++) {
+      EXPECT_EQ(tree.preorder()[tree.index(u)], u);
+      // Children are in edge order and point back to u.
+      std::vector<int> children, expected;
+      for (int child : tree.children(u)) {
+        children.push_back(child);
+        EXPECT_EQ(tree.parent(child), u);
+        EXPECT_EQ(tree.depth(child), tree.depth(u) + 1);
+      }
+      for (auto edge: graph.edges(u)) if (edge.first != tree.parent(u)) expected.push_back(edge.first);
+      EXPECT_EQ(children, expected);
+
+      // The preorder range of u holds exactly the nodes with u on their root path.
+      std::set<int> range(tree.preorder().begin() + tree.index(u),
+                          tree.preorder().begin() + tree.index(u) + tree.subtreeSize(u));
+      for (int v = 0; v < n; v += 7) {
+        bool ancestor = false;
+        for (int at = v; at != -1; at = tree.parent(at)) ancestor |= at == u;
+        EXPECT_EQ(tree.isAncestor(u, v), ancestor);
+        EXPECT_EQ(range.count(v) == 1, ancestor);
+      }
+    }
+  }
+
+  Graph cycle(3);
+  cycle.addUndirectedEdge(0, 1);
+  cycle.addUndirectedEdge(1, 2);
+  cycle.addUndirectedEdge(2, 0);
+  EXPECT_THROW(RootingTree(&cycle, 0), std::invalid_argument);
+  EXPECT_THROW(RootingTree(&cycle, 3), std::invalid_argument);
+}
+
+
+TEST(RootingTreeTest, testDeepTree) {
+  // A path of a few million nodes, far deeper than the call stack allows.
+  int n = 3000000;
+  std::vector<Edge> edges;
+  for (int v = 1; v < n; v++) {
+    edges.push_back({v - 1, v, 1});
+    edges.push_back({v, v - 1, 1});
+  }
+  CsrGraph graph(n, edges);
+
+  auto t0 = std::chrono::steady_clock::now();
+  RootingTree tree(&graph, 0);
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "Rooting a path of " << n << " nodes: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+  EXPECT_EQ(tree.depth(n - 1), n - 1);
+  EXPECT_EQ(tree.subtreeSize(1), n - 1);
+  EXPECT_TRUE(tree.isAncestor(1, n - 1));
+  EXPECT_FALSE(tree.isAncestor(n - 1, 1));
 }
 
 } // namespace dsa